@@ -1 +0,0 @@
-#include "pch.h"
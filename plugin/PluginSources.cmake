@@ -0,0 +1,80 @@
+# ─── Plugin sources, shared by every build flavor ───────────────────────────
+# Included by plugin/CMakeLists.txt and bakkesmod-upload/CMakeLists.txt, which
+# set LEO_SRC_DIR to plugin/src first. The flavors differ only in compile
+# definitions (see src/BuildFlavor.h), never in their file lists.
+
+set(PLUGIN_SOURCES
+    ${LEO_SRC_DIR}/pch.cpp
+    ${LEO_SRC_DIR}/VoiceCodec.cpp
+    ${LEO_SRC_DIR}/AdaptiveJitter.cpp
+    ${LEO_SRC_DIR}/PacketReorder.cpp
+    ${LEO_SRC_DIR}/TimeStretch.cpp
+    ${LEO_SRC_DIR}/AudioEngine.cpp
+    ${LEO_SRC_DIR}/SpatialAudio.cpp
+    ${LEO_SRC_DIR}/SpatialBatch.cpp
+    ${LEO_SRC_DIR}/SpatialKernels.cpp
+    ${LEO_SRC_DIR}/SpatialKernels_AVX2.cpp
+    ${LEO_SRC_DIR}/SpatialTables.cpp
+    ${LEO_SRC_DIR}/DistanceModel.cpp
+    ${LEO_SRC_DIR}/DopplerEngine.cpp
+    ${LEO_SRC_DIR}/ReverbEngine.cpp
+    ${LEO_SRC_DIR}/ArenaReflections.cpp
+    ${LEO_SRC_DIR}/ArenaOcclusion.cpp
+    ${LEO_SRC_DIR}/RealFft.cpp
+    ${LEO_SRC_DIR}/HrirDataset.cpp
+    ${LEO_SRC_DIR}/HrirRenderer.cpp
+    ${LEO_SRC_DIR}/AmbisonicRenderer.cpp
+    ${LEO_SRC_DIR}/VbapRenderer.cpp
+    ${LEO_SRC_DIR}/OutputLimiter.cpp
+    ${LEO_SRC_DIR}/MasterBus.cpp
+    ${LEO_SRC_DIR}/WorkStealingPool.cpp
+    ${LEO_SRC_DIR}/SpatialFanout.cpp
+    ${LEO_SRC_DIR}/NetworkManager.cpp
+    ${LEO_SRC_DIR}/LeoProximityChat.cpp
+)
+
+set(PLUGIN_HEADERS
+    ${LEO_SRC_DIR}/pch.h
+    ${LEO_SRC_DIR}/version.h
+    ${LEO_SRC_DIR}/BuildFlavor.h
+    ${LEO_SRC_DIR}/ThreadSafeQueue.h
+    ${LEO_SRC_DIR}/Protocol.h
+    ${LEO_SRC_DIR}/VoiceCodec.h
+    ${LEO_SRC_DIR}/AdaptiveJitter.h
+    ${LEO_SRC_DIR}/PacketReorder.h
+    ${LEO_SRC_DIR}/TimeStretch.h
+    ${LEO_SRC_DIR}/AudioEngine.h
+    ${LEO_SRC_DIR}/SpatialAudio.h
+    ${LEO_SRC_DIR}/SpatialBatch.h
+    ${LEO_SRC_DIR}/SpatialKernels.h
+    ${LEO_SRC_DIR}/SpatialTables.h
+    ${LEO_SRC_DIR}/DistanceModel.h
+    ${LEO_SRC_DIR}/DopplerEngine.h
+    ${LEO_SRC_DIR}/ReverbEngine.h
+    ${LEO_SRC_DIR}/ArenaReflections.h
+    ${LEO_SRC_DIR}/ArenaOcclusion.h
+    ${LEO_SRC_DIR}/FractionalDelay.h
+    ${LEO_SRC_DIR}/RealFft.h
+    ${LEO_SRC_DIR}/HrirDataset.h
+    ${LEO_SRC_DIR}/HrirRenderer.h
+    ${LEO_SRC_DIR}/AmbisonicRenderer.h
+    ${LEO_SRC_DIR}/VbapRenderer.h
+    ${LEO_SRC_DIR}/OutputLimiter.h
+    ${LEO_SRC_DIR}/MasterBus.h
+    ${LEO_SRC_DIR}/WorkStealingPool.h
+    ${LEO_SRC_DIR}/SpatialFanout.h
+    ${LEO_SRC_DIR}/NetworkManager.h
+    ${LEO_SRC_DIR}/LeoProximityChat.h
+)
+
+# AVX2 kernels get their own ISA flags; they are only called after a CPUID
+# check, so the rest of the DLL stays runnable on SSE2-only machines.
+if(MSVC)
+    set(_AVX2_FLAGS "/arch:AVX2")
+else()
+    set(_AVX2_FLAGS "-mavx2")
+endif()
+set_source_files_properties(${LEO_SRC_DIR}/SpatialKernels_AVX2.cpp PROPERTIES
+    COMPILE_OPTIONS "${_AVX2_FLAGS}"
+    SKIP_PRECOMPILE_HEADERS ON
+)
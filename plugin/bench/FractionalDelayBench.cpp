@@ -0,0 +1,112 @@
+// ITD fractional delay: Linear against Lagrange3 (Farrow) and Thiran.
+//
+// For each interpolator, prints:
+//   - ns per sample for DelayLine::process with the delay ramping across
+//     the ITD range, as the Full tier drives it;
+//   - gain at 4, 8 and 12 kHz for a fixed delay of 3.5 samples, where
+//     linear interpolation is at its worst;
+//   - the error against an analytically delayed 6 kHz sine while the delay
+//     sweeps 0–MAX_ITD_SAMPLES in 100 ms (a fast head turn), in dB below
+//     the signal. This is the zipper / modulation noise a moving ITD adds.
+#include "FractionalDelay.h"
+#include "SpatialTables.h"
+#include "Protocol.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr int   RATE  = Protocol::SAMPLE_RATE;
+constexpr int   BLOCK = Protocol::FRAME_SIZE;
+constexpr int   BLOCKS = 500;   // 10 s of audio per timing
+constexpr float TWO_PI = 6.2831853f;
+constexpr float MAX_DELAY = static_cast<float>(SpatialTables::MAX_ITD_SAMPLES - 2);
+
+// Delay in samples at sample i of a triangle sweep over [0, MAX_DELAY]
+float sweep(int i, int period) {
+    const float t = static_cast<float>(i % period) / static_cast<float>(period);
+    return MAX_DELAY * (t < 0.5f ? 2.0f * t : 2.0f - 2.0f * t);
+}
+
+template <class Interp>
+double nsPerSample() {
+    FractionalDelay::DelayLine<Interp> line;
+    std::vector<float> in(BLOCK), delay(BLOCK), out(BLOCK);
+    for (int i = 0; i < BLOCK; i++) in[i] = std::sin(0.05f * static_cast<float>(i));
+
+    float sink = 0.0f;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int b = 0; b < BLOCKS; b++) {
+        for (int i = 0; i < BLOCK; i++) delay[i] = sweep(b * BLOCK + i, RATE / 2);
+        line.process(in.data(), delay.data(), out.data(), BLOCK);
+        sink += out[BLOCK - 1];
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    if (sink == 12345.0f) std::printf(" ");   // Keep the loop alive
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / (static_cast<double>(BLOCKS) * BLOCK);
+}
+
+// Output / input RMS for a sine at hz through a fixed delay, after settling
+template <class Interp>
+double gainDb(float hz, float delaySamples) {
+    FractionalDelay::DelayLine<Interp> line;
+    std::vector<float> in(BLOCK), delay(BLOCK, delaySamples), out(BLOCK);
+    const float w = TWO_PI * hz / static_cast<float>(RATE);
+    double inPower = 0.0, outPower = 0.0;
+    for (int b = 0; b < 4; b++) {
+        for (int i = 0; i < BLOCK; i++) in[i] = std::sin(w * static_cast<float>(b * BLOCK + i));
+        line.process(in.data(), delay.data(), out.data(), BLOCK);
+        if (b == 0) continue;
+        for (int i = 0; i < BLOCK; i++) {
+            inPower += static_cast<double>(in[i]) * in[i];
+            outPower += static_cast<double>(out[i]) * out[i];
+        }
+    }
+    return 10.0 * std::log10(outPower / inPower);
+}
+
+// Error against the ideal delayed sine while the delay sweeps, in dB below the signal
+template <class Interp>
+double sweepErrorDb(float hz) {
+    FractionalDelay::DelayLine<Interp> line;
+    std::vector<float> in(BLOCK), delay(BLOCK), out(BLOCK);
+    const double w = TWO_PI * hz / static_cast<double>(RATE);
+    const int period = RATE / 5;   // 0 → max → 0 in 200 ms
+    double signal = 0.0, error = 0.0;
+    for (int b = 0; b < BLOCKS / 10; b++) {
+        for (int i = 0; i < BLOCK; i++) {
+            const int n = b * BLOCK + i;
+            in[i] = static_cast<float>(std::sin(w * n));
+            delay[i] = sweep(n, period);
+        }
+        line.process(in.data(), delay.data(), out.data(), BLOCK);
+        if (b == 0) continue;
+        for (int i = 0; i < BLOCK; i++) {
+            const int n = b * BLOCK + i;
+            const double ideal = std::sin(w * (n - delay[i] - Interp::LATENCY));
+            signal += ideal * ideal;
+            error += (out[i] - ideal) * (out[i] - ideal);
+        }
+    }
+    return 10.0 * std::log10(error / signal);
+}
+
+template <class Interp>
+void report(const char* name) {
+    std::printf("  %-10s %6.2f ns/sample   gain @4k %6.2f dB  @8k %6.2f dB  @12k %6.2f dB   sweep error %6.1f dB\n",
+                name, nsPerSample<Interp>(),
+                gainDb<Interp>(4000.0f, 3.5f), gainDb<Interp>(8000.0f, 3.5f), gainDb<Interp>(12000.0f, 3.5f),
+                sweepErrorDb<Interp>(6000.0f));
+}
+
+} // namespace
+
+int main() {
+    std::printf("FractionalDelay: delay 0-%.0f samples, %d-sample blocks\n", static_cast<double>(MAX_DELAY), BLOCK);
+    report<FractionalDelay::Linear>("Linear");
+    report<FractionalDelay::Lagrange3>("Lagrange3");
+    report<FractionalDelay::Thiran>("Thiran");
+    return 0;
+}
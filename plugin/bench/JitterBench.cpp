@@ -0,0 +1,176 @@
+// Jitter buffer playout: the old fixed 3-frame pre-roll against
+// AdaptiveJitter + TimeStretch, on simulated network traces.
+//
+// usage: jitter_bench [seconds]   (default 60 per trace)
+//
+// A 150 Hz voiced talker sends one 20 ms frame per period, stamped with
+// its sample clock (with a pause every 4 s, so talk spurts restart); each
+// trace delays the packets in its own way (in order, a late packet holds
+// back the ones behind it) or loses some of them (concealed one period
+// after they were due, as the engine's PLC does).
+// The playback side reads one frame every 20 ms. Per trace and mode:
+//   depth   : mean audio buffered after each read (the jitter buffer's
+//             share of the mouth-to-ear latency), and its maximum
+//   underrun: ms of output that found the buffer empty
+//   stretch : frames accelerated / expanded, and µs per stretched frame
+#include "AdaptiveJitter.h"
+#include "TimeStretch.h"
+#include "Protocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int    FRAME     = Protocol::FRAME_SIZE;
+constexpr double PERIOD_MS = Protocol::FRAME_DURATION_MS;
+constexpr int    SPURT_FRAMES = 200;   // 4 s of speech …
+constexpr int    PAUSE_FRAMES = 25;    // … then 0.5 s of silence
+
+struct Trace {
+    const char* name;
+    std::function<double(int, std::mt19937&)> delayMs;   // Network delay of packet k
+    double loss = 0.0;                                   // Fraction of packets never arriving
+};
+
+/** Frame k of the talker: a harmonic 150 Hz voice with a slow syllable envelope. */
+void voice(int k, float* out) {
+    for (int i = 0; i < FRAME; i++) {
+        const double t = (static_cast<double>(k) * FRAME + i) / Protocol::SAMPLE_RATE;
+        const double env = 0.6 + 0.4 * std::sin(2.0 * 3.14159265 * 3.0 * t);
+        double s = 0.0;
+        for (int h = 1; h <= 6; h++) s += std::sin(2.0 * 3.14159265 * 150.0 * h * t) / h;
+        out[i] = static_cast<float>(0.2 * env * s);
+    }
+}
+
+struct Result {
+    double depthMs = 0.0, maxDepthMs = 0.0, underrunMs = 0.0, stretchUs = 0.0;
+    int accelerated = 0, expanded = 0;
+};
+
+Result simulate(const Trace& trace, double seconds, bool adaptive) {
+    std::mt19937 rng(7);
+    const int periods = static_cast<int>(seconds * 1000.0 / PERIOD_MS);
+
+    // Arrival times, in order
+    struct Arrival { double time; int frame; bool lost; };
+    std::vector<Arrival> arrivals;
+    double last = 0.0;
+    for (int k = 0; k < periods; k++) {
+        if (k % (SPURT_FRAMES + PAUSE_FRAMES) >= SPURT_FRAMES) continue;
+        const bool lost = std::uniform_real_distribution<double>(0.0, 1.0)(rng) < trace.loss;
+        last = std::max(last, k * PERIOD_MS + trace.delayMs(k, rng) + (lost ? PERIOD_MS : 0.0));
+        arrivals.push_back({ last, k, lost });
+    }
+
+    AdaptiveJitter jitter;
+    std::deque<float> buffer;
+    std::vector<float> frame(TimeStretch::MAX_FRAME);
+    bool prebuffering = true;
+    double idleSince = 0.0;
+    Result r;
+    int reads = 0, stretched = 0;
+    int lastFrame = -1;
+
+    size_t next = 0;
+    for (int j = 0; j < periods + 50; j++) {
+        const double now = j * PERIOD_MS + 7.0;   // Playback clock, out of phase with the sender
+
+        for (; next < arrivals.size() && arrivals[next].time <= now; next++) {
+            voice(arrivals[next].frame, frame.data());
+            int n = FRAME;
+            if (arrivals[next].lost) {
+                std::fill(frame.begin(), frame.begin() + n, 0.0f);   // Stands in for PLC
+            } else if (adaptive) {
+                jitter.onArrival(arrivals[next].time, static_cast<uint32_t>(arrivals[next].frame * FRAME));
+                const auto action = jitter.onFrame(buffer.size(), !prebuffering);
+                const auto t0 = std::chrono::steady_clock::now();
+                if (action == AdaptiveJitter::Action::Accelerate) n = TimeStretch::accelerate(frame.data(), n);
+                if (action == AdaptiveJitter::Action::Expand) n = TimeStretch::expand(frame.data(), n, TimeStretch::MAX_FRAME);
+                if (n != FRAME) {
+                    r.stretchUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+                    stretched++;
+                    jitter.onStretched(n - FRAME);
+                    (n < FRAME ? r.accelerated : r.expanded)++;
+                }
+            }
+            buffer.insert(buffer.end(), frame.begin(), frame.begin() + n);
+            lastFrame = arrivals[next].frame;
+        }
+
+        const size_t start = adaptive ? jitter.targetSamples() + FRAME : 3 * FRAME;
+        if (prebuffering) {
+            if (buffer.size() < start) continue;
+            prebuffering = false;
+        }
+
+        // As in the engine: a buffer that ran dry plays silence, and one that
+        // stays dry for a while pre-buffers again
+        const size_t played = std::min<size_t>(FRAME, buffer.size());
+        buffer.erase(buffer.begin(), buffer.begin() + played);
+        if (played == 0) {
+            if (idleSince == 0.0) idleSince = now;
+            if (now - idleSince >= 100.0) {   // Well into the pause: the talk spurt ended
+                prebuffering = true;
+                idleSince = 0.0;
+                continue;
+            }
+        } else {
+            idleSince = 0.0;
+        }
+        // Short only if the talker's next frame is due but not here (not the pause)
+        const bool midSpurt = next < arrivals.size() && arrivals[next].frame == lastFrame + 1;
+        if (played < FRAME && midSpurt) r.underrunMs += (FRAME - played) * 1000.0 / Protocol::SAMPLE_RATE;
+
+        const double depth = buffer.size() * 1000.0 / Protocol::SAMPLE_RATE;
+        r.depthMs += depth;
+        r.maxDepthMs = std::max(r.maxDepthMs, depth);
+        reads++;
+    }
+
+    r.depthMs /= std::max(reads, 1);
+    r.stretchUs /= std::max(stretched, 1);
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double seconds = argc > 1 ? std::max(5.0, std::atof(argv[1])) : 60.0;
+
+    const Trace traces[] = {
+        { "wired (±1 ms)", [](int, std::mt19937& g) {
+            return 30.0 + std::uniform_real_distribution<double>(-1.0, 1.0)(g); } },
+        { "lossy (±1 ms, 5% lost)", [](int, std::mt19937& g) {
+            return 30.0 + std::uniform_real_distribution<double>(-1.0, 1.0)(g); }, 0.05 },
+        { "wifi (exp, 8 ms mean)", [](int, std::mt19937& g) {
+            return 30.0 + std::exponential_distribution<double>(1.0 / 8.0)(g); } },
+        { "spike (300 ms at 10 s)", [](int k, std::mt19937& g) {
+            const double t = k * PERIOD_MS;
+            const double spike = (t >= 10000.0 && t < 10300.0) ? 10300.0 - t : 0.0;
+            return 30.0 + spike + std::uniform_real_distribution<double>(-1.0, 1.0)(g); } },
+        { "congested (exp 20 ms + 2% 150 ms)", [](int, std::mt19937& g) {
+            const double burst = std::uniform_real_distribution<double>(0.0, 1.0)(g) < 0.02 ? 150.0 : 0.0;
+            return 30.0 + burst + std::exponential_distribution<double>(1.0 / 20.0)(g); } },
+    };
+
+    std::printf("Jitter buffer playout, %.0f s per trace (depth = buffered audio after each read)\n", seconds);
+    std::printf("  %-34s %-9s %9s %9s %11s %7s %7s %9s\n",
+                "trace", "mode", "depth ms", "max ms", "underrun ms", "accel", "expand", "us/frame");
+    for (const auto& trace : traces) {
+        for (bool adaptive : { false, true }) {
+            const Result r = simulate(trace, seconds, adaptive);
+            std::printf("  %-34s %-9s %9.1f %9.1f %11.1f %7d %7d %9.1f\n",
+                        trace.name, adaptive ? "adaptive" : "fixed", r.depthMs, r.maxDepthMs, r.underrunMs,
+                        r.accelerated, r.expanded, r.stretchUs);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+// SpatialKernels conformance: every kernel of every instruction set tier
+// the CPU runs, against the Scalar reference, in a release build (the
+// check in SpatialKernels::active() is a debug-only assert).
+//
+// usage: kernel_check
+//
+// Each kernel runs on seeded random signals at lengths around the vector
+// widths (the SIMD bodies and their scalar tails) and at one frame. Prints
+// the largest difference per kernel and tier; exits 1 if any exceeds
+// SpatialKernels::TOLERANCE, or if a peak differs at all.
+#include "SpatialKernels.h"
+#include "Protocol.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+using SpatialKernels::Isa;
+using SpatialKernels::KernelTable;
+
+constexpr int LENGTHS[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 67, Protocol::FRAME_SIZE };
+constexpr int MAX_LENGTH = Protocol::FRAME_SIZE;
+
+struct Signals {
+    std::vector<float> a, b, c, d;
+
+    explicit Signals(unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+        for (auto* v : { &a, &b, &c, &d }) {
+            v->resize(MAX_LENGTH);
+            for (float& x : *v) x = u(rng);
+        }
+    }
+};
+
+/** Largest |ref - simd| over count samples. */
+float maxDiff(const std::vector<float>& ref, const std::vector<float>& simd, int count) {
+    float worst = 0.0f;
+    for (int i = 0; i < count; i++) worst = std::max(worst, std::fabs(ref[i] - simd[i]));
+    return worst;
+}
+
+/** Largest difference of one kernel of t from Scalar over every length and seed. */
+template <class Run>
+float compare(const KernelTable& t, int outPerSample, Run run) {
+    const KernelTable& ref = SpatialKernels::scalarTable();
+    std::vector<float> outRef(MAX_LENGTH * 2), outSimd(MAX_LENGTH * 2);
+    float worst = 0.0f;
+    for (unsigned seed = 1; seed <= 4; seed++) {
+        const Signals s(seed);
+        for (int n : LENGTHS) {
+            std::fill(outRef.begin(), outRef.end(), 0.25f);    // Accumulating kernels add to this
+            std::fill(outSimd.begin(), outSimd.end(), 0.25f);
+            run(ref, outRef.data(), s, n);
+            run(t, outSimd.data(), s, n);
+            worst = std::max(worst, maxDiff(outRef, outSimd, n * outPerSample));
+            // Nothing written past the end
+            worst = std::max(worst, maxDiff(outRef, outSimd, MAX_LENGTH * 2));
+        }
+    }
+    return worst;
+}
+
+/** Exact comparison of peak(): it selects a sample, so any difference is a bug. */
+float comparePeak(const KernelTable& t) {
+    const KernelTable& ref = SpatialKernels::scalarTable();
+    float worst = 0.0f;
+    for (unsigned seed = 1; seed <= 4; seed++) {
+        const Signals s(seed);
+        for (int n : LENGTHS) {
+            const float r = ref.peak(s.a.data(), n);
+            const float v = t.peak(s.a.data(), n);
+            if (r != v) worst = std::max(worst, std::isfinite(v) ? std::fabs(r - v) : INFINITY);
+        }
+    }
+    return worst;
+}
+
+} // namespace
+
+int main() {
+    const Isa widest = SpatialKernels::detectIsa();
+    std::printf("SpatialKernels against Scalar (tolerance %g; detected %s)\n",
+                static_cast<double>(SpatialKernels::TOLERANCE), SpatialKernels::isaName(widest));
+    std::printf("  %-8s %-18s %12s\n", "tier", "kernel", "max diff");
+
+    bool ok = true;
+    for (Isa isa : { Isa::SSE2, Isa::AVX2 }) {
+        if (isa > widest) {
+            std::printf("  %-8s (not supported by this CPU, skipped)\n", SpatialKernels::isaName(isa));
+            continue;
+        }
+        const KernelTable& t = SpatialKernels::table(isa);
+        if (t.isa != isa) {
+            std::printf("  %-8s (not compiled in, skipped)\n", SpatialKernels::isaName(isa));
+            continue;
+        }
+
+        struct Row { const char* name; float diff; float limit; };
+        const Row rows[] = {
+            { "multiply", compare(t, 1, [](const KernelTable& k, float* o, const Signals& s, int n) {
+                  k.multiply(o, s.a.data(), s.b.data(), n); }), SpatialKernels::TOLERANCE },
+            { "scale", compare(t, 1, [](const KernelTable& k, float* o, const Signals& s, int n) {
+                  k.scale(o, s.a.data(), 0.7f, n); }), SpatialKernels::TOLERANCE },
+            { "blend", compare(t, 1, [](const KernelTable& k, float* o, const Signals& s, int n) {
+                  k.blend(o, s.a.data(), s.b.data(), 0.05f, 0.95f, n); }), SpatialKernels::TOLERANCE },
+            { "blend (aliased)", compare(t, 1, [](const KernelTable& k, float* o, const Signals& s, int n) {
+                  std::copy(s.a.begin(), s.a.begin() + n, o);
+                  k.blend(o, o, s.b.data(), 0.3f, 0.6f, n); }), SpatialKernels::TOLERANCE },
+            { "accumulate", compare(t, 1, [](const KernelTable& k, float* o, const Signals& s, int n) {
+                  k.accumulate(o, s.c.data(), n); }), SpatialKernels::TOLERANCE },
+            { "interleave", compare(t, 2, [](const KernelTable& k, float* o, const Signals& s, int n) {
+                  k.interleave(o, s.a.data(), s.b.data(), n); }), SpatialKernels::TOLERANCE },
+            { "accumulateStereo", compare(t, 2, [](const KernelTable& k, float* o, const Signals& s, int n) {
+                  k.accumulateStereo(o, s.c.data(), s.d.data(), n); }), SpatialKernels::TOLERANCE },
+            { "ramp", compare(t, 1, [](const KernelTable& k, float* o, const Signals&, int n) {
+                  k.ramp(o, 0.3f, -0.0041f, n); }), SpatialKernels::TOLERANCE },
+            { "peak", comparePeak(t), 0.0f },
+        };
+        for (const Row& row : rows) {
+            const bool pass = row.diff <= row.limit;
+            ok = ok && pass;
+            std::printf("  %-8s %-18s %12.3g%s\n", SpatialKernels::isaName(isa), row.name,
+                        static_cast<double>(row.diff), pass ? "" : "   MISMATCH");
+        }
+    }
+
+    std::printf(ok ? "PASS\n" : "FAIL\n");
+    return ok ? 0 : 1;
+}
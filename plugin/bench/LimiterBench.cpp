@@ -0,0 +1,108 @@
+// Mix-bus output stage: the old per-sample std::tanh clamp against
+// OutputLimiter, on 20 ms stereo blocks as MasterBus::finish sees them.
+//
+// For each stage and two mix levels (a normal conversation peaking around
+// -10 dBFS, and several loud peers summing to ~+3.5 dBFS), prints:
+//   - ns per frame;
+//   - output peak (the limiter must stay at or below its ceiling);
+//   - distortion: error against the input (delayed by the limiter's
+//     latency), in dB below the signal. At normal level the limiter should
+//     leave the mix untouched, while tanh already bends it; on the hot
+//     mix the figure mostly measures the gain reduction itself.
+#include "OutputLimiter.h"
+#include "Protocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr int   RATE     = Protocol::SAMPLE_RATE;
+constexpr int   BLOCK    = Protocol::FRAME_SIZE;
+constexpr int   CHANNELS = 2;
+constexpr int   BLOCKS   = 500;   // 10 s of audio
+constexpr float TWO_PI   = 6.2831853f;
+
+// Speech-like stereo mix: a few partials under a syllable-rate envelope,
+// scaled so the loudest sample is `peak`
+std::vector<float> makeMix(float peak) {
+    std::vector<float> mix(static_cast<size_t>(BLOCKS) * BLOCK * CHANNELS);
+    float maxAbs = 0.0f;
+    for (int n = 0; n < BLOCKS * BLOCK; n++) {
+        const float t = static_cast<float>(n) / RATE;
+        const float env = 0.5f + 0.5f * std::sin(TWO_PI * 4.0f * t);
+        const float voice = std::sin(TWO_PI * 180.0f * t) + 0.5f * std::sin(TWO_PI * 540.0f * t) +
+                            0.3f * std::sin(TWO_PI * 1260.0f * t);
+        mix[2 * n]     = env * env * voice;
+        mix[2 * n + 1] = env * env * (0.7f * voice + 0.3f * std::sin(TWO_PI * 310.0f * t));
+        maxAbs = std::max({maxAbs, std::fabs(mix[2 * n]), std::fabs(mix[2 * n + 1])});
+    }
+    for (float& s : mix) s *= peak / maxAbs;
+    return mix;
+}
+
+struct Result {
+    double nsPerFrame;
+    float  peak;
+    double errorDb;
+};
+
+// The output stage before OutputLimiter
+void tanhStage(float* out, int frames, int channels) {
+    const size_t samples = static_cast<size_t>(frames) * channels;
+    for (size_t i = 0; i < samples; i++) {
+        out[i] = std::tanh(out[i]);
+    }
+}
+
+template <class Stage>
+Result run(const std::vector<float>& in, int latency, Stage&& stage) {
+    std::vector<float> out = in;
+    const int blockSamples = BLOCK * CHANNELS;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int b = 0; b < BLOCKS; b++) {
+        stage(out.data() + static_cast<size_t>(b) * blockSamples, BLOCK, CHANNELS);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    Result r{};
+    r.nsPerFrame = std::chrono::duration<double, std::nano>(t1 - t0).count() / (static_cast<double>(BLOCKS) * BLOCK);
+    double signal = 0.0, error = 0.0;
+    for (size_t i = static_cast<size_t>(latency) * CHANNELS; i < out.size(); i++) {
+        const double ref = in[i - static_cast<size_t>(latency) * CHANNELS];
+        r.peak = std::max(r.peak, std::fabs(out[i]));
+        signal += ref * ref;
+        error += (out[i] - ref) * (out[i] - ref);
+    }
+    r.errorDb = error > 0.0 ? 10.0 * std::log10(error / signal) : -INFINITY;
+    return r;
+}
+
+void report(const char* level, float peak) {
+    const std::vector<float> mix = makeMix(peak);
+
+    const Result tanhR = run(mix, 0, tanhStage);
+    OutputLimiter limiter;
+    const Result limR = run(mix, OutputLimiter::LATENCY,
+                            [&](float* io, int frames, int channels) { limiter.process(io, frames, channels); });
+
+    std::printf("%s (input peak %.2f)\n", level, static_cast<double>(peak));
+    std::printf("  tanh      %6.2f ns/frame   out peak %.3f   distortion %7.1f dB\n",
+                tanhR.nsPerFrame, static_cast<double>(tanhR.peak), tanhR.errorDb);
+    std::printf("  limiter   %6.2f ns/frame   out peak %.3f   distortion %7.1f dB   (%.1fx faster)\n",
+                limR.nsPerFrame, static_cast<double>(limR.peak), limR.errorDb,
+                tanhR.nsPerFrame / limR.nsPerFrame);
+}
+
+} // namespace
+
+int main() {
+    std::printf("Output stage: %d-frame stereo blocks, limiter ceiling %.3f, latency %d frames\n",
+                BLOCK, static_cast<double>(OutputLimiter::CEILING), OutputLimiter::LATENCY);
+    report("Normal level", 0.3f);
+    report("Hot mix", 1.5f);
+    return 0;
+}
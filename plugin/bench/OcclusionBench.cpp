@@ -0,0 +1,95 @@
+// Arena occlusion cost: one listener→source segment through the Soccar
+// BVH against testing every triangle, and a full openness() query (RAYS
+// segments) per peer update.
+//
+// Positions are random points inside the arena and the goals (one in
+// five in a goal), so a few percent of the pairs have something in the way. Prints ns per segment for
+// both paths, the worst disagreement between them (should be 0) and the
+// share of one core that 10 peers updated at 60 Hz would take, against
+// a 0.1% budget.
+#include "ArenaOcclusion.h"
+#include "ArenaReflections.h"
+#include "Protocol.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace {
+
+constexpr int PAIRS = 20000;
+constexpr int PEERS = 10;
+constexpr int UPDATE_HZ = 60;
+constexpr double BUDGET_CORE_SHARE = 0.001;   // 0.1% of one core
+
+std::vector<Protocol::Vec3> randomPoints(int n, std::mt19937& rng) {
+    namespace AR = ArenaReflections;
+    std::uniform_real_distribution<float> x(-AR::SIDE_WALL_X + 50.0f, AR::SIDE_WALL_X - 50.0f);
+    std::uniform_real_distribution<float> y(-AR::BACK_WALL_Y + 50.0f, AR::BACK_WALL_Y - 50.0f);
+    std::uniform_real_distribution<float> z(17.0f, AR::CEILING_Z - 50.0f);
+    std::uniform_real_distribution<float> gx(-AR::GOAL_HALF_WIDTH + 50.0f, AR::GOAL_HALF_WIDTH - 50.0f);
+    std::uniform_real_distribution<float> gy(AR::BACK_WALL_Y + 50.0f, AR::GOAL_BACK_Y - 50.0f);
+    std::uniform_real_distribution<float> gz(17.0f, AR::GOAL_HEIGHT - 50.0f);
+    std::uniform_int_distribution<int> where(0, 9);
+
+    std::vector<Protocol::Vec3> points;
+    for (int i = 0; i < n; i++) {
+        const int w = where(rng);
+        if (w == 0) points.push_back({ gx(rng), gy(rng), gz(rng) });         // Blue goal
+        else if (w == 1) points.push_back({ gx(rng), -gy(rng), gz(rng) });   // Orange goal
+        else points.push_back({ x(rng), y(rng), z(rng) });
+    }
+    return points;
+}
+
+} // namespace
+
+int main() {
+    auto t0 = std::chrono::steady_clock::now();
+    const ArenaOcclusion::Bvh bvh(ArenaOcclusion::soccarMesh());
+    auto t1 = std::chrono::steady_clock::now();
+    std::printf("ArenaOcclusion: %d triangles, %d BVH nodes, built in %.1f us\n",
+                bvh.triangleCount(), bvh.nodeCount(),
+                std::chrono::duration<double, std::micro>(t1 - t0).count());
+
+    std::mt19937 rng{ 7 };
+    const auto from = randomPoints(PAIRS, rng);
+    const auto to = randomPoints(PAIRS, rng);
+
+    // ── One segment: BVH vs every triangle ──
+    std::vector<float> viaBvh(PAIRS), viaAll(PAIRS);
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < PAIRS; i++) viaBvh[i] = bvh.transmission(from[i], to[i]);
+    t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < PAIRS; i++) viaAll[i] = bvh.transmissionBruteForce(from[i], to[i]);
+    auto t2 = std::chrono::steady_clock::now();
+
+    float maxDiff = 0.0f;
+    int occluded = 0;
+    for (int i = 0; i < PAIRS; i++) {
+        maxDiff = std::max(maxDiff, std::abs(viaBvh[i] - viaAll[i]));
+        if (viaBvh[i] < 1.0f) occluded++;
+    }
+    const double bvhNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / PAIRS;
+    const double allNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / PAIRS;
+    std::printf("  segment     BVH %7.1f ns   all triangles %7.1f ns   %5.2fx   max diff %g   occluded %.0f%%\n",
+                bvhNs, allNs, allNs / bvhNs, static_cast<double>(maxDiff), 100.0 * occluded / PAIRS);
+
+    // ── One peer update: openness() over RAYS segments ──
+    ArenaOcclusion::warmUp();
+    float sink = 0.0f;
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < PAIRS; i++) sink += ArenaOcclusion::openness(from[i], to[i]);
+    t1 = std::chrono::steady_clock::now();
+    const double queryUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / PAIRS;
+
+    const double share = queryUs * PEERS * UPDATE_HZ * 1e-6;
+    std::printf("  openness    %.2f us per peer update (%d rays)\n", queryUs, ArenaOcclusion::RAYS);
+    std::printf("  %d peers at %d Hz: %.1f us/s = %.4f%% of one core (budget %.1f%%) %s\n",
+                PEERS, UPDATE_HZ, queryUs * PEERS * UPDATE_HZ, share * 100.0, BUDGET_CORE_SHARE * 100.0,
+                share <= BUDGET_CORE_SHARE ? "OK" : "OVER BUDGET");
+    std::printf("  (mean openness %.3f)\n", static_cast<double>(sink / PAIRS));
+    return 0;
+}
@@ -0,0 +1,128 @@
+// Per-period spatialization cost as the lobby grows: SpatialFanout over a
+// WorkStealingPool with 0 (the calling thread alone) up to N workers.
+//
+// usage: parallel_render_bench [max-peers] [max-workers]
+//   max-peers   : peer counts 4, 8, 16, … up to this (default 128)
+//   max-workers : pool sizes 0 … this (default: hardware threads - 1)
+//
+// Same scene as spatial_batch_bench (Full-tier sources circling the
+// listener). Prints, per peer count and pool size, the mean and worst µs
+// to render one 20 ms period, and the worst absolute difference against
+// the 0-worker output, which should be 0. Opus decoding is not part of
+// the measurement (it needs the codec; AudioEngine fans it out the same
+// way, one job per peer).
+#include "SpatialFanout.h"
+#include "SpatialAudio.h"
+#include "WorkStealingPool.h"
+#include "Protocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int FRAME  = Protocol::FRAME_SIZE;
+constexpr int FRAMES = 100;   // 2 s of audio per measurement
+
+struct Scene {
+    int sources;
+    std::vector<float> mono;          // sources × FRAME, refilled per frame
+    std::vector<float> radius, height, speed, phase;
+    std::mt19937 rng{ 99 };
+
+    explicit Scene(int n) : sources(n), mono(static_cast<size_t>(n) * FRAME) {
+        std::uniform_real_distribution<float> r(300.0f, 6000.0f), h(-200.0f, 800.0f),
+                                              w(-3.0f, 3.0f), p(0.0f, 6.2831853f);
+        for (int s = 0; s < n; s++) {
+            radius.push_back(r(rng));
+            height.push_back(h(rng));
+            speed.push_back(w(rng));
+            phase.push_back(p(rng));
+        }
+    }
+
+    void fill(int frame) {
+        std::mt19937 frameRng(static_cast<unsigned>(frame));   // Same input for every pool size
+        std::uniform_real_distribution<float> noise(-0.3f, 0.3f);
+        for (float& x : mono) x = noise(frameRng);
+    }
+
+    const float* input(int s) const { return &mono[static_cast<size_t>(s) * FRAME]; }
+
+    Protocol::Vec3 position(int s, int frame) const {
+        const float a = phase[s] + speed[s] * 0.02f * static_cast<float>(frame);
+        return { radius[s] * std::cos(a), radius[s] * std::sin(a), height[s] };
+    }
+};
+
+struct Result {
+    double meanUs = 0.0;
+    double worstUs = 0.0;
+    std::vector<float> stereo;        // Every period's output, for the comparison
+};
+
+Result render(int peers, int workers) {
+    WorkStealingPool pool(workers);
+    SpatialFanout fanout(pool);
+    Scene scene(peers);
+
+    std::vector<std::unique_ptr<SpatialAudio>> spatial;
+    for (int s = 0; s < peers; s++) spatial.push_back(std::make_unique<SpatialAudio>());
+    std::vector<float> stereo(static_cast<size_t>(peers) * FRAME * 2), send(static_cast<size_t>(peers) * FRAME);
+
+    Result r;
+    r.stereo.reserve(static_cast<size_t>(FRAMES) * stereo.size());
+    const Protocol::Vec3 listener{ 0.0f, 0.0f, 100.0f };
+    for (int f = 0; f < FRAMES; f++) {
+        scene.fill(f);
+        const Protocol::Rot rot{ 0, f * 80, 0 };
+
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int s = 0; s < peers; s++) {
+            fanout.submit(*spatial[s], scene.input(s), FRAME, &stereo[static_cast<size_t>(s) * FRAME * 2],
+                          listener, rot, scene.position(s, f), &send[static_cast<size_t>(s) * FRAME]);
+        }
+        fanout.render();
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+
+        r.meanUs += us / FRAMES;
+        r.worstUs = std::max(r.worstUs, us);
+        r.stereo.insert(r.stereo.end(), stereo.begin(), stereo.end());
+    }
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int maxPeers = argc > 1 ? std::max(1, std::atoi(argv[1])) : 128;
+    const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    const int maxWorkers = std::clamp(argc > 2 ? std::atoi(argv[2]) : hardware - 1, 0, WorkStealingPool::MAX_WORKERS);
+
+    std::printf("SpatialFanout: Full tier, %d-sample periods (%d us of audio), %d peers per job, %d hardware threads\n",
+                FRAME, FRAME * 1000000 / Protocol::SAMPLE_RATE, SpatialFanout::JOB_SOURCES, hardware);
+    std::printf("  peers   workers   mean us   worst us   speedup   max diff\n");
+
+    std::vector<int> counts;
+    for (int n = 4; n < maxPeers; n *= 2) counts.push_back(n);
+    counts.push_back(maxPeers);
+
+    for (int n : counts) {
+        const Result base = render(n, 0);
+        for (int w = 0; w <= maxWorkers; w++) {
+            const Result r = w == 0 ? base : render(n, w);
+            float maxDiff = 0.0f;
+            for (size_t i = 0; i < r.stereo.size(); i++)
+                maxDiff = std::max(maxDiff, std::abs(r.stereo[i] - base.stereo[i]));
+            std::printf("  %5d   %7d   %7.1f   %8.1f   %6.2fx   %g\n",
+                        n, w, r.meanUs, r.worstUs, base.meanUs / r.meanUs, static_cast<double>(maxDiff));
+        }
+    }
+    return 0;
+}
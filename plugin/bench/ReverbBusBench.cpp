@@ -0,0 +1,183 @@
+// Late reverb: one ReverbEngine per source with the send level applied to
+// its return (the layout before MasterBus), against the shared bus, where
+// each source's send level is applied before the summed sends reach one
+// ReverbEngine.
+//
+// usage: reverb_bus_bench
+//
+// Sources sit at random bearings and either hold their distance or drive
+// in and out between 300 and 5300 uu; send level and distance volume come
+// from SpatialAudio::place() every 20 ms frame, ramped across the frame
+// the same way in both layouts. For each source count and motion, prints
+// the µs per frame of each layout and the difference of the shared-bus
+// return from the per-source one, in dB below it (SNR).
+//
+// The reverb is linear, so with a send level that holds still the two
+// layouts agree to float rounding. While the level moves they differ by
+// design: per source, the tail was scaled by the current level; on the
+// bus, each sample keeps the level it was sent with, and the tail decays
+// instead of following the level.
+#include "ReverbEngine.h"
+#include "SpatialAudio.h"
+#include "Protocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int   FRAME  = Protocol::FRAME_SIZE;
+constexpr int   FRAMES = 500;   // 10 s of audio
+constexpr float TWO_PI = 6.2831853f;
+
+struct Scene {
+    int sources;
+    bool moving;
+    std::vector<float> bearing, phase;
+    std::vector<float> mono;          // sources × FRAMES × FRAME
+    std::vector<float> send;          // Ramped send level, same layout
+    std::vector<float> distVolume;    // sources × FRAMES
+
+    Scene(int n, bool move) : sources(n), moving(move) {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> angle(0.0f, TWO_PI), noise(-0.3f, 0.3f);
+        for (int s = 0; s < n; s++) {
+            bearing.push_back(angle(rng));
+            phase.push_back(angle(rng));
+        }
+
+        // Noise under a syllable-rate envelope, one talker per source
+        const size_t perSource = static_cast<size_t>(FRAMES) * FRAME;
+        mono.resize(perSource * n);
+        for (int s = 0; s < n; s++) {
+            for (size_t i = 0; i < perSource; i++) {
+                const float t = static_cast<float>(i) / Protocol::SAMPLE_RATE;
+                const float env = 0.5f + 0.5f * std::sin(TWO_PI * 4.0f * t + phase[s]);
+                mono[s * perSource + i] = env * env * noise(rng);
+            }
+        }
+
+        const SpatialAudio spatial;
+        const Protocol::Vec3 listener{ 0.0f, 0.0f, 100.0f };
+        const Protocol::Rot rot{ 0, 0, 0 };
+        send.resize(perSource * n);
+        distVolume.resize(static_cast<size_t>(FRAMES) * n);
+        for (int s = 0; s < n; s++) {
+            float level = -1.0f;
+            for (int f = 0; f < FRAMES; f++) {
+                const SpatialAudio::Placement pl = spatial.place(listener, rot, position(s, f));
+                if (level < 0.0f) level = pl.reverbSend;
+                const float step = (pl.reverbSend - level) / FRAME;
+                float* out = &send[s * perSource + static_cast<size_t>(f) * FRAME];
+                for (int i = 0; i < FRAME; i++) out[i] = level + step * static_cast<float>(i + 1);
+                level = pl.reverbSend;
+                distVolume[static_cast<size_t>(s) * FRAMES + f] = pl.distVolume;
+            }
+        }
+    }
+
+    Protocol::Vec3 position(int s, int frame) const {
+        // In and out over 6 s (up to ~2600 uu/s), or parked at mid range
+        const float t = static_cast<float>(frame) * FRAME / Protocol::SAMPLE_RATE;
+        const float r = moving ? 2800.0f + 2500.0f * std::sin(TWO_PI * t / 6.0f + phase[s]) : 2800.0f;
+        return { r * std::cos(bearing[s]), r * std::sin(bearing[s]), 100.0f };
+    }
+
+    const float* input(int s, int f) const {
+        return &mono[(static_cast<size_t>(s) * FRAMES + f) * FRAME];
+    }
+    const float* level(int s, int f) const {
+        return &send[(static_cast<size_t>(s) * FRAMES + f) * FRAME];
+    }
+    float volume(int s, int f) const { return distVolume[static_cast<size_t>(s) * FRAMES + f]; }
+};
+
+struct Result {
+    double usPerFrame;
+    std::vector<float> stereo;   // Every frame's return, interleaved
+};
+
+Result perSource(const Scene& scene) {
+    std::vector<std::unique_ptr<ReverbEngine>> reverbs;
+    for (int s = 0; s < scene.sources; s++) reverbs.push_back(std::make_unique<ReverbEngine>());
+    std::vector<float> in(FRAME), wetL(FRAME), wetR(FRAME);
+
+    Result r;
+    r.stereo.assign(static_cast<size_t>(FRAMES) * FRAME * 2, 0.0f);
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < FRAMES; f++) {
+        float* out = &r.stereo[static_cast<size_t>(f) * FRAME * 2];
+        for (int s = 0; s < scene.sources; s++) {
+            const float* x = scene.input(s, f);
+            const float* level = scene.level(s, f);
+            const float volume = scene.volume(s, f);
+            for (int i = 0; i < FRAME; i++) in[i] = x[i] * volume;
+            reverbs[s]->processBlock(in.data(), wetL.data(), wetR.data(), FRAME);
+            for (int i = 0; i < FRAME; i++) {
+                out[2 * i]     += wetL[i] * level[i];
+                out[2 * i + 1] += wetR[i] * level[i];
+            }
+        }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    r.usPerFrame = std::chrono::duration<double, std::micro>(t1 - t0).count() / FRAMES;
+    return r;
+}
+
+Result sharedBus(const Scene& scene) {
+    auto reverb = std::make_unique<ReverbEngine>();
+    std::vector<float> sendMix(FRAME), wetL(FRAME), wetR(FRAME);
+
+    Result r;
+    r.stereo.assign(static_cast<size_t>(FRAMES) * FRAME * 2, 0.0f);
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < FRAMES; f++) {
+        std::fill(sendMix.begin(), sendMix.end(), 0.0f);
+        for (int s = 0; s < scene.sources; s++) {
+            const float* x = scene.input(s, f);
+            const float* level = scene.level(s, f);
+            const float volume = scene.volume(s, f);
+            for (int i = 0; i < FRAME; i++) sendMix[i] += x[i] * volume * level[i];
+        }
+        reverb->processBlock(sendMix.data(), wetL.data(), wetR.data(), FRAME);
+        float* out = &r.stereo[static_cast<size_t>(f) * FRAME * 2];
+        for (int i = 0; i < FRAME; i++) {
+            out[2 * i]     = wetL[i];
+            out[2 * i + 1] = wetR[i];
+        }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    r.usPerFrame = std::chrono::duration<double, std::micro>(t1 - t0).count() / FRAMES;
+    return r;
+}
+
+double snrDb(const std::vector<float>& ref, const std::vector<float>& out) {
+    double signal = 0.0, error = 0.0;
+    for (size_t i = 0; i < ref.size(); i++) {
+        signal += static_cast<double>(ref[i]) * ref[i];
+        error += static_cast<double>(out[i] - ref[i]) * (out[i] - ref[i]);
+    }
+    return error > 0.0 ? 10.0 * std::log10(signal / error) : INFINITY;
+}
+
+} // namespace
+
+int main() {
+    std::printf("Late reverb, per-source engines vs the shared bus (%d frames of %d samples)\n\n",
+                FRAMES, FRAME);
+    std::printf("  %7s %-7s %14s %14s %10s\n", "sources", "motion", "per-source µs", "shared µs", "SNR dB");
+    for (int sources : { 1, 4, 16 }) {
+        for (bool moving : { false, true }) {
+            const Scene scene(sources, moving);
+            const Result ref = perSource(scene);
+            const Result bus = sharedBus(scene);
+            std::printf("  %7d %-7s %14.1f %14.1f %10.1f\n", sources, moving ? "moving" : "static",
+                        ref.usPerFrame, bus.usPerFrame, snrDb(ref.stereo, bus.stereo));
+        }
+    }
+    return 0;
+}
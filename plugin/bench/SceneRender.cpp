@@ -0,0 +1,390 @@
+// Offline scene renderer: runs a scripted scene through SpatialAudio,
+// SpatialBatch, ArenaOcclusion and the MasterBus end of the playback mix
+// (shared reverb + output limiter), as fast as it can, and writes a stereo
+// WAV plus a timing report. For reproducing "sounds wrong over there"
+// reports and profiling DSP changes without the game.
+//
+//   scene_render <scene file> <out.wav> [--unbatched]
+//
+// Scene file, one keyword per line, # starts a comment. Positions are
+// Unreal units (as in the game), angles degrees, times seconds:
+//
+//   duration  <seconds>                       default: end of the last keyframe
+//   listener  <t> <x> <y> <z> [yaw pitch roll]   listener keyframe
+//   source    <name> <file.wav | tone:<hz> | noise>   mono 48 kHz WAV or a test signal
+//   at        <name> <t> <x> <y> <z>             source keyframe
+//   distance  <inner> <outer> [rolloff] [soft|inverse|linear|exponential]
+//   reverb    <mix 0-1>
+//   volume    <master 0-2>
+//   occlusion <0|1>
+//
+// Keyframes are interpolated linearly and held before the first and after
+// the last. Every source stays in the Full tier (no LOD budget offline).
+// With --unbatched each source runs through SpatialAudio::process() on its
+// own, which also gives a per-source timing; the output is the same.
+#include "SpatialAudio.h"
+#include "SpatialBatch.h"
+#include "ArenaOcclusion.h"
+#include "MasterBus.h"
+#include "Protocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int RATE  = Protocol::SAMPLE_RATE;
+constexpr int FRAME = Protocol::FRAME_SIZE;
+constexpr float ROTATOR_PER_DEGREE = 65536.0f / 360.0f;
+
+// ── WAV I/O ──────────────────────────────────────────────────────────────────
+
+uint32_t readU32(const unsigned char* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24); }
+uint16_t readU16(const unsigned char* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+
+/** 16-bit PCM or 32-bit float WAV at 48 kHz, channels averaged to mono. */
+bool readWav(const std::string& path, std::vector<float>& out, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) { error = "cannot open " + path; return false; }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < 12 || std::memcmp(data.data(), "RIFF", 4) != 0 || std::memcmp(data.data() + 8, "WAVE", 4) != 0) {
+        error = path + ": not a RIFF/WAVE file";
+        return false;
+    }
+
+    int format = 0, channels = 0, bits = 0;
+    uint32_t rate = 0;
+    for (size_t pos = 12; pos + 8 <= data.size();) {
+        const uint32_t size = readU32(&data[pos + 4]);
+        const unsigned char* body = &data[pos + 8];
+        if (pos + 8 + size > data.size()) break;
+        if (std::memcmp(&data[pos], "fmt ", 4) == 0 && size >= 16) {
+            format = readU16(body);
+            channels = readU16(body + 2);
+            rate = readU32(body + 4);
+            bits = readU16(body + 14);
+            if (format == 0xFFFE && size >= 26) format = readU16(body + 24);   // WAVE_FORMAT_EXTENSIBLE
+        } else if (std::memcmp(&data[pos], "data", 4) == 0) {
+            if (channels <= 0) { error = path + ": data before fmt"; return false; }
+            if (rate != static_cast<uint32_t>(RATE)) {
+                error = path + ": " + std::to_string(rate) + " Hz, expected " + std::to_string(RATE);
+                return false;
+            }
+            const bool pcm16 = format == 1 && bits == 16;
+            const bool float32 = format == 3 && bits == 32;
+            if (!pcm16 && !float32) { error = path + ": only 16-bit PCM and 32-bit float are supported"; return false; }
+
+            const size_t frames = size / (static_cast<size_t>(channels) * (bits / 8));
+            out.assign(frames, 0.0f);
+            for (size_t i = 0; i < frames; i++) {
+                float sum = 0.0f;
+                for (int c = 0; c < channels; c++) {
+                    const unsigned char* s = body + (i * channels + c) * (bits / 8);
+                    if (pcm16) {
+                        sum += static_cast<int16_t>(readU16(s)) / 32768.0f;
+                    } else {
+                        float v;
+                        std::memcpy(&v, s, 4);
+                        sum += v;
+                    }
+                }
+                out[i] = sum / static_cast<float>(channels);
+            }
+            return true;
+        }
+        pos += 8 + size + (size & 1);
+    }
+    error = path + ": no data chunk";
+    return false;
+}
+
+/** Interleaved stereo, 32-bit float. */
+bool writeWav(const std::string& path, const std::vector<float>& stereo) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    auto u32 = [&file](uint32_t v) { const char b[4] = { char(v), char(v >> 8), char(v >> 16), char(v >> 24) }; file.write(b, 4); };
+    auto u16 = [&file](uint16_t v) { const char b[2] = { char(v), char(v >> 8) }; file.write(b, 2); };
+
+    const uint32_t bytes = static_cast<uint32_t>(stereo.size() * sizeof(float));
+    file.write("RIFF", 4); u32(36 + bytes); file.write("WAVE", 4);
+    file.write("fmt ", 4); u32(16); u16(3); u16(2); u32(RATE); u32(RATE * 8); u16(8); u16(32);
+    file.write("data", 4); u32(bytes);
+    file.write(reinterpret_cast<const char*>(stereo.data()), bytes);
+    return static_cast<bool>(file);
+}
+
+// ── Scene ────────────────────────────────────────────────────────────────────
+
+struct Key {
+    float t;
+    Protocol::Vec3 pos;
+    float yaw = 0.0f, pitch = 0.0f, roll = 0.0f;   // Degrees (listener only)
+};
+
+/** Linear interpolation over keyframes sorted by time, held at both ends. */
+Key sample(const std::vector<Key>& keys, float t) {
+    if (keys.empty()) return { t, {} };
+    if (t <= keys.front().t) return keys.front();
+    if (t >= keys.back().t) return keys.back();
+    auto next = std::upper_bound(keys.begin(), keys.end(), t, [](float v, const Key& k) { return v < k.t; });
+    const Key& a = *(next - 1);
+    const Key& b = *next;
+    const float f = (t - a.t) / std::max(b.t - a.t, 1e-6f);
+    Key k;
+    k.t = t;
+    k.pos = a.pos + (b.pos - a.pos) * f;
+    k.yaw = a.yaw + (b.yaw - a.yaw) * f;
+    k.pitch = a.pitch + (b.pitch - a.pitch) * f;
+    k.roll = a.roll + (b.roll - a.roll) * f;
+    return k;
+}
+
+struct Source {
+    std::string name;
+    std::vector<float> audio;   // Mono, 48 kHz
+    std::vector<Key> keys;
+    SpatialAudio spatial;
+    double seconds = 0.0;       // Render time (unbatched only)
+};
+
+struct Scene {
+    float duration = 0.0f;
+    std::vector<Key> listener;
+    std::vector<std::unique_ptr<Source>> sources;
+    DistanceModel::Settings distance;
+    float reverbMix = 0.9f;
+    float volume = Protocol::DEFAULT_MASTER_VOLUME;
+    bool occlusion = true;
+
+    Source* find(const std::string& name) {
+        for (auto& s : sources) if (s->name == name) return s.get();
+        return nullptr;
+    }
+};
+
+/** Ten seconds of a test signal: a sine or white noise at -12 dBFS. */
+std::vector<float> testSignal(const std::string& spec) {
+    std::vector<float> audio(static_cast<size_t>(RATE) * 10);
+    if (spec.rfind("tone:", 0) == 0) {
+        const double w = 2.0 * 3.14159265358979 * std::stod(spec.substr(5)) / RATE;
+        for (size_t i = 0; i < audio.size(); i++) audio[i] = 0.25f * static_cast<float>(std::sin(w * i));
+    } else {
+        std::mt19937 rng{ 1 };
+        std::uniform_real_distribution<float> d(-0.43f, 0.43f);
+        for (float& v : audio) v = d(rng);
+    }
+    return audio;
+}
+
+bool loadScene(const std::string& path, Scene& scene, std::string& error) {
+    std::ifstream file(path);
+    if (!file) { error = "cannot open " + path; return false; }
+
+    std::string line;
+    for (int lineNo = 1; std::getline(file, line); lineNo++) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream in(line);
+        std::string keyword;
+        if (!(in >> keyword)) continue;
+        const std::string where = path + ":" + std::to_string(lineNo) + ": ";
+
+        if (keyword == "duration") {
+            in >> scene.duration;
+        } else if (keyword == "listener") {
+            Key k;
+            in >> k.t >> k.pos.x >> k.pos.y >> k.pos.z;
+            if (!in) { error = where + "listener <t> <x> <y> <z> [yaw pitch roll]"; return false; }
+            in >> k.yaw >> k.pitch >> k.roll;
+            scene.listener.push_back(k);
+        } else if (keyword == "source") {
+            std::string name, input;
+            if (!(in >> name >> input)) { error = where + "source <name> <file.wav | tone:<hz> | noise>"; return false; }
+            if (scene.find(name)) { error = where + "source " + name + " defined twice"; return false; }
+            auto src = std::make_unique<Source>();
+            src->name = name;
+            if (input == "noise" || input.rfind("tone:", 0) == 0) {
+                src->audio = testSignal(input);
+            } else if (!readWav(input, src->audio, error)) {
+                error = where + error;
+                return false;
+            }
+            scene.sources.push_back(std::move(src));
+        } else if (keyword == "at") {
+            std::string name;
+            Key k;
+            in >> name >> k.t >> k.pos.x >> k.pos.y >> k.pos.z;
+            if (!in) { error = where + "at <name> <t> <x> <y> <z>"; return false; }
+            Source* src = scene.find(name);
+            if (!src) { error = where + "unknown source " + name; return false; }
+            src->keys.push_back(k);
+        } else if (keyword == "distance") {
+            std::string curve;
+            in >> scene.distance.inner >> scene.distance.outer;
+            if (!in) { error = where + "distance <inner> <outer> [rolloff] [curve]"; return false; }
+            if (in >> scene.distance.rolloff && in >> curve) {
+                if (curve == "soft") scene.distance.curve = DistanceModel::Curve::Soft;
+                else if (curve == "inverse") scene.distance.curve = DistanceModel::Curve::Inverse;
+                else if (curve == "linear") scene.distance.curve = DistanceModel::Curve::Linear;
+                else if (curve == "exponential") scene.distance.curve = DistanceModel::Curve::Exponential;
+                else { error = where + "unknown curve " + curve; return false; }
+            }
+        } else if (keyword == "reverb") {
+            in >> scene.reverbMix;
+        } else if (keyword == "volume") {
+            in >> scene.volume;
+        } else if (keyword == "occlusion") {
+            int on = 1;
+            in >> on;
+            scene.occlusion = on != 0;
+        } else {
+            error = where + "unknown keyword " + keyword;
+            return false;
+        }
+    }
+
+    if (scene.sources.empty()) { error = path + ": no sources"; return false; }
+    auto byTime = [](const Key& a, const Key& b) { return a.t < b.t; };
+    std::stable_sort(scene.listener.begin(), scene.listener.end(), byTime);
+    float end = scene.listener.empty() ? 0.0f : scene.listener.back().t;
+    for (auto& src : scene.sources) {
+        std::stable_sort(src->keys.begin(), src->keys.end(), byTime);
+        if (!src->keys.empty()) end = std::max(end, src->keys.back().t);
+    }
+    if (scene.duration <= 0.0f) scene.duration = end;
+    if (scene.duration <= 0.0f) { error = path + ": zero duration (set duration or add keyframes)"; return false; }
+    return true;
+}
+
+Protocol::Rot toRotator(const Key& k) {
+    Protocol::Rot rot;
+    rot.yaw = static_cast<int>(std::lround(k.yaw * ROTATOR_PER_DEGREE));
+    rot.pitch = static_cast<int>(std::lround(k.pitch * ROTATOR_PER_DEGREE));
+    rot.roll = static_cast<int>(std::lround(k.roll * ROTATOR_PER_DEGREE));
+    return rot;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s <scene file> <out.wav> [--unbatched]\n", argv[0]);
+        return 2;
+    }
+    const bool unbatched = argc > 3 && std::strcmp(argv[3], "--unbatched") == 0;
+
+    Scene scene;
+    std::string error;
+    if (!loadScene(argv[1], scene, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    ArenaOcclusion::warmUp();
+
+    const int sourceCount = static_cast<int>(scene.sources.size());
+    for (auto& src : scene.sources) {
+        // Same per-peer settings AudioEngine copies from the cvar-driven instance
+        src->spatial.setDistanceModel(scene.distance);
+        src->spatial.setEnabled(true);
+        src->spatial.setMasterVolume(scene.volume);
+        src->spatial.setReverbEnabled(true);
+        src->spatial.setReverbMix(scene.reverbMix);
+    }
+
+    const int frames = static_cast<int>(std::ceil(scene.duration * RATE / FRAME));
+    std::vector<float> output(static_cast<size_t>(frames) * FRAME * 2, 0.0f);
+    std::vector<float> mono(static_cast<size_t>(sourceCount) * FRAME);
+    std::vector<float> stereo(static_cast<size_t>(sourceCount) * FRAME * 2);
+    std::vector<float> send(static_cast<size_t>(sourceCount) * FRAME);
+
+    auto batch = std::make_unique<SpatialBatch>();   // Too large for the stack
+    MasterBus master;
+    double spatialSeconds = 0.0, occlusionSeconds = 0.0, mixSeconds = 0.0, worstFrame = 0.0;
+
+    for (int f = 0; f < frames; f++) {
+        const auto frameStart = std::chrono::steady_clock::now();
+        const float t = static_cast<float>(f) * FRAME / RATE;
+        const Key lis = sample(scene.listener, t);
+        const Protocol::Rot lRot = toRotator(lis);
+
+        // Occlusion at packet rate, as AudioEngine does per received frame
+        std::vector<Protocol::Vec3> positions(sourceCount);
+        for (int s = 0; s < sourceCount; s++) {
+            Source& src = *scene.sources[s];
+            positions[s] = sample(src.keys, t).pos;
+            src.spatial.setOcclusion(scene.occlusion ? ArenaOcclusion::openness(lis.pos, positions[s]) : 1.0f);
+
+            float* in = &mono[static_cast<size_t>(s) * FRAME];
+            const size_t offset = static_cast<size_t>(f) * FRAME;
+            for (int i = 0; i < FRAME; i++) {
+                in[i] = offset + i < src.audio.size() ? src.audio[offset + i] : 0.0f;
+            }
+        }
+        const auto spatialStart = std::chrono::steady_clock::now();
+        occlusionSeconds += std::chrono::duration<double>(spatialStart - frameStart).count();
+
+        for (int s = 0; s < sourceCount; s++) {
+            Source& src = *scene.sources[s];
+            float* in = &mono[static_cast<size_t>(s) * FRAME];
+            float* out = &stereo[static_cast<size_t>(s) * FRAME * 2];
+            float* sendOut = &send[static_cast<size_t>(s) * FRAME];
+            if (unbatched) {
+                const auto t0 = std::chrono::steady_clock::now();
+                src.spatial.process(in, FRAME, out, lis.pos, lRot, positions[s], sendOut);
+                src.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            } else {
+                batch->submit(src.spatial, in, FRAME, out, lis.pos, lRot, positions[s], sendOut);
+            }
+        }
+        if (!unbatched) batch->flush();
+        const auto mixStart = std::chrono::steady_clock::now();
+        spatialSeconds += std::chrono::duration<double>(mixStart - spatialStart).count();
+
+        // Playback mix: dry stereo + summed sends → shared reverb → limiter
+        float* mix = &output[static_cast<size_t>(f) * FRAME * 2];
+        master.beginBlock();
+        for (int s = 0; s < sourceCount; s++) {
+            SpatialAudio::mixInto(mix, &stereo[static_cast<size_t>(s) * FRAME * 2], FRAME);
+            SpatialKernels::active().accumulate(master.sendMix(), &send[static_cast<size_t>(s) * FRAME], FRAME);
+        }
+        master.addReverb(mix, FRAME);
+        master.finish(mix, FRAME, Protocol::CHANNELS_STEREO);
+
+        const auto frameEnd = std::chrono::steady_clock::now();
+        mixSeconds += std::chrono::duration<double>(frameEnd - mixStart).count();
+        worstFrame = std::max(worstFrame, std::chrono::duration<double>(frameEnd - frameStart).count());
+    }
+
+    if (!writeWav(argv[2], output)) {
+        std::fprintf(stderr, "cannot write %s\n", argv[2]);
+        return 1;
+    }
+
+    // ── Timing report ──
+    const double audioSeconds = static_cast<double>(frames) * FRAME / RATE;
+    const double total = spatialSeconds + occlusionSeconds + mixSeconds;
+    const double perFrame = 1e6 / frames;
+    std::printf("Scene: %d sources, %d frames (%.2f s of audio) -> %s\n", sourceCount, frames, audioSeconds, argv[2]);
+    std::printf("  spatial    %8.2f us/frame   %7.2f us/frame/source (%s)\n",
+                spatialSeconds * perFrame, spatialSeconds * perFrame / sourceCount,
+                unbatched ? "SpatialAudio::process" : "SpatialBatch");
+    std::printf("  occlusion  %8.2f us/frame   %7.2f us/frame/source\n",
+                occlusionSeconds * perFrame, occlusionSeconds * perFrame / sourceCount);
+    std::printf("  mix        %8.2f us/frame   (reverb bus + limiter)\n", mixSeconds * perFrame);
+    std::printf("  total      %8.2f us/frame   worst %.2f us, %.0fx real time\n",
+                total * perFrame, worstFrame * 1e6, audioSeconds / total);
+    if (unbatched) {
+        for (const auto& src : scene.sources) {
+            std::printf("    %-12s %7.2f us/frame\n", src->name.c_str(), src->seconds * perFrame);
+        }
+    }
+    return 0;
+}
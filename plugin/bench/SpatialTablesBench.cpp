@@ -0,0 +1,111 @@
+// Per-packet geometry cost: precomputed SpatialTables vs the direct math
+// (cos/sin yaw, atan2, computeAzimuthEntry with its sin/tan calls).
+//
+// Prints ns per lookup for both paths and the worst absolute error of the
+// table path over the same random listener/source set.
+#include "SpatialTables.h"
+#include "Protocol.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace {
+
+struct Query {
+    float dx, dy;
+    int yaw;
+};
+
+using Entry = SpatialTables::AzimuthEntry;
+
+Entry directMath(const Query& q) {
+    float yawRad = static_cast<float>(q.yaw) * (2.0f * SpatialTables::PI / 65536.0f);
+    float cosYaw = std::cos(yawRad);
+    float sinYaw = std::sin(yawRad);
+    float fwd   = q.dx * cosYaw + q.dy * sinYaw;
+    float right = q.dx * sinYaw - q.dy * cosYaw;
+    float az = std::atan2(right, fwd + 1e-9f);
+    return SpatialTables::computeAzimuthEntry(az, static_cast<float>(Protocol::SAMPLE_RATE));
+}
+
+Entry tableLookup(const Query& q) {
+    float sinYaw, cosYaw;
+    SpatialTables::rotatorSinCos(q.yaw, sinYaw, cosYaw);
+    float fwd   = q.dx * cosYaw + q.dy * sinYaw;
+    float right = q.dx * sinYaw - q.dy * cosYaw;
+    float az = SpatialTables::azimuthOf(right, fwd + 1e-9f);
+    return SpatialTables::lookupAzimuth(az);
+}
+
+float checksum(const Entry& e) {
+    return e.delayL + e.delayR + e.gainL + e.gainR +
+           e.shadowB0L + e.shadowA1L + e.shadowB0R + e.shadowA1R;
+}
+
+template <typename F>
+double timeNs(const std::vector<Query>& queries, int rounds, F&& fn, float& sink) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const Query& q : queries) sink += checksum(fn(q));
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return ns / (static_cast<double>(queries.size()) * rounds);
+}
+
+} // namespace
+
+int main() {
+    constexpr int QUERIES = 4096;
+    constexpr int ROUNDS  = 500;
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> pos(-8000.0f, 8000.0f);
+    std::uniform_int_distribution<int> yaw(-32768, 98303);  // Includes wrap-around
+
+    std::vector<Query> queries(QUERIES);
+    for (auto& q : queries) q = { pos(rng), pos(rng), yaw(rng) };
+
+    std::uniform_real_distribution<float> elev(-0.5f * SpatialTables::PI, 0.5f * SpatialTables::PI);
+    std::vector<float> elevations(QUERIES);
+    for (auto& e : elevations) e = elev(rng);
+
+    SpatialTables::warmUp();
+
+    // Accuracy
+    float maxDelayErr = 0.0f, maxGainErr = 0.0f, maxCoeffErr = 0.0f;
+    for (const Query& q : queries) {
+        Entry a = directMath(q), b = tableLookup(q);
+        maxDelayErr = std::max({ maxDelayErr, std::abs(a.delayL - b.delayL), std::abs(a.delayR - b.delayR) });
+        maxGainErr  = std::max({ maxGainErr,  std::abs(a.gainL - b.gainL),   std::abs(a.gainR - b.gainR) });
+        maxCoeffErr = std::max({ maxCoeffErr,
+                                 std::abs(a.shadowB0L - b.shadowB0L), std::abs(a.shadowA1L - b.shadowA1L),
+                                 std::abs(a.shadowB0R - b.shadowB0R), std::abs(a.shadowA1R - b.shadowA1R) });
+    }
+    float maxCueErr = 0.0f;
+    for (float el : elevations) {
+        auto a = SpatialTables::computeElevationEntry(el, static_cast<float>(Protocol::SAMPLE_RATE));
+        auto b = SpatialTables::lookupElevation(el);
+        maxCueErr = std::max({ maxCueErr, std::abs(a.gain - b.gain),
+                               std::abs(a.cueAlpha - b.cueAlpha), std::abs(a.hfGain - b.hfGain) });
+    }
+
+    // Timing
+    float sink = 0.0f;
+    double directNs = timeNs(queries, ROUNDS, directMath, sink);
+    double tableNs  = timeNs(queries, ROUNDS, tableLookup, sink);
+
+    std::printf("SpatialTables: azimuth %d / atan %d / yaw %d steps\n",
+                SpatialTables::AZIMUTH_STEPS, SpatialTables::ATAN_STEPS, SpatialTables::YAW_STEPS);
+    std::printf("  direct math : %7.2f ns/lookup\n", directNs);
+    std::printf("  table       : %7.2f ns/lookup  (%.1fx)\n", tableNs, directNs / tableNs);
+    std::printf("  max error   : delay %.5f samples, gain %.6f, shadow coeff %.6f\n",
+                maxDelayErr, maxGainErr, maxCoeffErr);
+    std::printf("  elevation   : %d steps, max cue error %.6f\n",
+                SpatialTables::ELEVATION_STEPS, maxCueErr);
+    std::printf("  (checksum %g)\n", static_cast<double>(sink));
+    return 0;
+}
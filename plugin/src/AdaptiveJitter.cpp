@@ -0,0 +1,114 @@
+#include "AdaptiveJitter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+size_t msToSamples(double ms) {
+    return static_cast<size_t>(ms * Protocol::SAMPLE_RATE / 1000.0);
+}
+
+} // namespace
+
+void AdaptiveJitter::reset() {
+    count_ = 0;
+    head_ = 0;
+    origin_ = 0.0;
+    lastArrival_ = 0.0;
+    packets_ = 0;
+    maxDelay_ = 0.0;
+    timestamped_ = false;
+    lastTimestamp_ = 0;
+    sentMs_ = 0.0;
+    lastDelay_ = 0.0;
+    jitter_ = 0.0;
+    target_ = msToSamples(INITIAL_DEPTH_MS);
+    level_ = 0.0f;
+}
+
+void AdaptiveJitter::onArrival(double arrivalMs) {
+    if (count_ == 0 || timestamped_) {
+        origin_ = arrivalMs;
+        packets_ = 0;
+        count_ = 0;
+        timestamped_ = false;
+    } else if (arrivalMs - lastArrival_ > SPURT_GAP_MS) {
+        // New talk spurt: restart the packet clock no earlier than any packet
+        // in the history, so the pause does not read as lateness
+        origin_ = arrivalMs - maxDelay_;
+        packets_ = 0;
+    }
+    lastArrival_ = arrivalMs;
+
+    addDelay(arrivalMs - origin_ - static_cast<double>(packets_) * Protocol::FRAME_DURATION_MS);
+    packets_++;
+}
+
+void AdaptiveJitter::onArrival(double arrivalMs, uint32_t timestamp) {
+    if (count_ == 0 || !timestamped_) {
+        count_ = 0;
+        timestamped_ = true;
+        sentMs_ = 0.0;
+    } else {
+        // Unwrap the 32-bit sample clock (reordered packets step back)
+        const int32_t step = static_cast<int32_t>(timestamp - lastTimestamp_);
+        sentMs_ += step * 1000.0 / Protocol::SAMPLE_RATE;
+    }
+    lastTimestamp_ = timestamp;
+    lastArrival_ = arrivalMs;
+
+    double delay = arrivalMs - sentMs_;
+    if (count_ > 0 && std::abs(delay - lastDelay_) > CLOCK_JUMP_MS) {
+        // The sender restarted its clock: start a new history on it
+        count_ = 0;
+        sentMs_ = 0.0;
+        delay = arrivalMs;
+    }
+    lastDelay_ = delay;
+    addDelay(delay);
+}
+
+AdaptiveJitter::Action AdaptiveJitter::onFrame(size_t buffered, bool stretch) {
+    const float level = static_cast<float>(buffered);
+    if (!stretch) {
+        level_ = level;
+        return Action::None;
+    }
+
+    level_ += LEVEL_SMOOTH * (level - level_);
+    const float target = static_cast<float>(target_);
+    if (level_ > target + ACCELERATE_ABOVE) return Action::Accelerate;
+    if (level_ < target - EXPAND_BELOW) return Action::Expand;
+    return Action::None;
+}
+
+void AdaptiveJitter::addDelay(double delay) {
+    delays_[head_] = delay;
+    head_ = (head_ + 1) % HISTORY;
+    count_ = std::min(count_ + 1, HISTORY);
+    updateTarget();
+}
+
+void AdaptiveJitter::updateTarget() {
+    // Lateness of each packet: its delay over the fastest packet after it,
+    // newest to oldest
+    std::array<double, HISTORY> late;
+    double fastest = delays_[(head_ + HISTORY - 1) % HISTORY];
+    maxDelay_ = fastest;
+    for (int i = 0; i < count_; i++) {
+        const double d = delays_[(head_ + HISTORY - 1 - i) % HISTORY];
+        fastest = std::min(fastest, d);
+        maxDelay_ = std::max(maxDelay_, d);
+        late[i] = d - fastest;
+    }
+    if (count_ < MIN_HISTORY) {
+        jitter_ = 0.0;
+        target_ = msToSamples(INITIAL_DEPTH_MS);
+        return;
+    }
+
+    auto q = late.begin() + static_cast<int>(QUANTILE * static_cast<float>(count_ - 1));
+    std::nth_element(late.begin(), q, late.begin() + count_);
+    jitter_ = *q;
+    target_ = msToSamples(std::min(jitter_ + DEPTH_MARGIN_MS, MAX_DEPTH_MS));
+}
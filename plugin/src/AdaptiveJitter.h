@@ -0,0 +1,101 @@
+#pragma once
+#include "Protocol.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Playout control of one peer's jitter buffer: how deep it should be, and
+ * whether the frame about to be buffered should be time-stretched
+ * (TimeStretch) to get there.
+ *
+ *   jitter : every packet's lateness: its delay over the fastest packet
+ *            after it. The delay is the arrival time minus the sender
+ *            timestamp for sequenced packets, else minus 20 ms per packet
+ *            received (the clock restarting after a SPURT_GAP_MS pause).
+ *            A late packet is followed by faster ones; a lost packet, or a
+ *            lasting change of route or clock, shifts every later delay
+ *            alike and so reads as no lateness at all. The target depth is
+ *            the QUANTILE of the last HISTORY latenesses plus
+ *            DEPTH_MARGIN_MS, up to MAX_DEPTH_MS
+ *   level  : samples still buffered when a decoded frame is buffered,
+ *            smoothed over a few frames
+ *   action : accelerate while the level sits ACCELERATE_ABOVE over the
+ *            target, expand while it sits EXPAND_BELOW under it; a stretch
+ *            moves the level right away, so one excursion is not corrected
+ *            twice
+ *
+ * Arrivals are recorded as packets come in and frames are steered as they
+ * are decoded, which differ when packets are held back for reordering.
+ * A spike raises the target only while its packets are in the history,
+ * and the buffer it filled is then played down by accelerating instead of
+ * staying as latency. Until MIN_HISTORY packets arrived the target is
+ * INITIAL_DEPTH_MS, the old fixed pre-roll minus the frame in play.
+ *
+ * Not thread-safe: one instance per peer, used by its decode job.
+ */
+class AdaptiveJitter {
+public:
+    enum class Action { None, Accelerate, Expand };
+
+    static constexpr int    HISTORY          = 128;     // Packets (~2.5 s of speech)
+    static constexpr int    MIN_HISTORY      = 16;
+    static constexpr float  QUANTILE         = 0.98f;
+    static constexpr double SPURT_GAP_MS     = 200.0;   // Longer silence = new talk spurt, not a delay
+    static constexpr double CLOCK_JUMP_MS    = 2000.0;  // Sender clock moved this far: it restarted
+    static constexpr double INITIAL_DEPTH_MS = 40.0;
+    static constexpr double MAX_DEPTH_MS     = 200.0;
+    static constexpr double DEPTH_MARGIN_MS  = 20.0;    // One frame: the callback takes whole frames
+    static constexpr float  LEVEL_SMOOTH     = 0.125f;  // Per-packet EMA coefficient
+    static constexpr int    ACCELERATE_ABOVE = Protocol::FRAME_SIZE / 2;   // Samples over the target
+    static constexpr int    EXPAND_BELOW     = Protocol::FRAME_SIZE / 4;   // Samples under the target
+
+    AdaptiveJitter() { reset(); }
+
+    /** A packet without sequence fields arrived at arrivalMs (steady clock). */
+    void onArrival(double arrivalMs);
+
+    /** A sequenced packet arrived at arrivalMs; timestamp is its sender sample clock. */
+    void onArrival(double arrivalMs, uint32_t timestamp);
+
+    /**
+     * A decoded frame is about to be buffered behind buffered samples.
+     * stretch = false while playback has not started (the pre-roll builds
+     * up), which only records the level.
+     */
+    Action onFrame(size_t buffered, bool stretch);
+
+    /** The frame was stretched by delta samples (< 0 = accelerated). */
+    void onStretched(int delta) { level_ += static_cast<float>(delta); }
+
+    /** Depth to keep buffered between packets, in samples. */
+    size_t targetSamples() const { return target_; }
+
+    /** Arrival delay quantile of the recent packets, in ms. */
+    double jitterMs() const { return jitter_; }
+
+    void reset();
+
+private:
+    /** Append a delay to the history and recompute jitter_ and target_. */
+    void addDelay(double delay);
+
+    /** Recompute jitter_ and target_ from the history. */
+    void updateTarget();
+
+    std::array<double, HISTORY> delays_{};   // Arrival minus the packet clock, ring
+    int count_ = 0;                          // Entries of delays_ in use
+    int head_ = 0;                           // Next slot of delays_
+    double origin_ = 0.0;                    // Packet clock: packet k is due at origin_ + 20k ms
+    double lastArrival_ = 0.0;
+    long packets_ = 0;                       // Packets on the current clock
+    double maxDelay_ = 0.0;                  // Of the history
+    bool timestamped_ = false;               // Delays are against sender timestamps
+    uint32_t lastTimestamp_ = 0;
+    double sentMs_ = 0.0;                    // Sender clock of lastTimestamp_, unwrapped
+    double lastDelay_ = 0.0;
+
+    double jitter_ = 0.0;
+    size_t target_ = 0;
+    float level_ = 0.0f;
+};
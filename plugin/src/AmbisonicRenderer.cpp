@@ -0,0 +1,342 @@
+#include "AmbisonicRenderer.h"
+#include "SpatialTables.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int CHANNELS = AmbisonicRenderer::CHANNELS;
+constexpr float PI = SpatialTables::PI;
+
+// Encoder table resolution
+constexpr int AZ_STEPS = 128;   // Intervals over [-PI, PI] (~2.8° each)
+constexpr int EL_STEPS = 64;    // Intervals over [-PI/2, PI/2]
+
+/** Real spherical harmonics up to order 3, ACN order, SN3D, for a unit vector (x front, y left, z up). */
+void evaluate(float x, float y, float z, float* out) {
+    const float s3 = 1.7320508f;    // sqrt(3)
+    const float s15 = 3.8729833f;   // sqrt(15)
+    const float s58 = 0.7905694f;   // sqrt(5/8)
+    const float s38 = 0.6123724f;   // sqrt(3/8)
+    const float x2 = x * x, y2 = y * y, z2 = z * z;
+
+    out[0]  = 1.0f;
+    out[1]  = y;
+    out[2]  = z;
+    out[3]  = x;
+    out[4]  = s3 * x * y;
+    out[5]  = s3 * y * z;
+    out[6]  = 0.5f * (3.0f * z2 - 1.0f);
+    out[7]  = s3 * x * z;
+    out[8]  = 0.5f * s3 * (x2 - y2);
+    out[9]  = s58 * y * (3.0f * x2 - y2);
+    out[10] = s15 * x * y * z;
+    out[11] = s38 * y * (5.0f * z2 - 1.0f);
+    out[12] = 0.5f * z * (5.0f * z2 - 3.0f);
+    out[13] = s38 * x * (5.0f * z2 - 1.0f);
+    out[14] = 0.5f * s15 * z * (x2 - y2);
+    out[15] = s58 * x * (x2 - 3.0f * y2);
+}
+
+int degreeOf(int channel) {
+    int l = 0;
+    while ((l + 1) * (l + 1) <= channel) l++;
+    return l;
+}
+
+struct EncoderTable {
+    std::vector<float> gains;   // [(EL_STEPS + 1) × (AZ_STEPS + 1)][CHANNELS]
+
+    EncoderTable() : gains(static_cast<size_t>(EL_STEPS + 1) * (AZ_STEPS + 1) * CHANNELS) {
+        for (int e = 0; e <= EL_STEPS; e++) {
+            float el = -0.5f * PI + PI * e / EL_STEPS;
+            for (int a = 0; a <= AZ_STEPS; a++) {
+                float az = -PI + 2.0f * PI * a / AZ_STEPS;
+                evaluate(std::cos(el) * std::cos(az), std::cos(el) * std::sin(az), std::sin(el),
+                         &gains[(static_cast<size_t>(e) * (AZ_STEPS + 1) + a) * CHANNELS]);
+            }
+        }
+    }
+};
+
+const EncoderTable& encoderTable() {
+    static const EncoderTable t;
+    return t;
+}
+
+/** Bilinear table lookup for azimuth in [-PI, PI], elevation in [-PI/2, PI/2]. */
+void lookupEncoder(float azimuth, float elevation, float* out) {
+    const std::vector<float>& g = encoderTable().gains;
+    float fa = std::clamp((azimuth + PI) * (AZ_STEPS / (2.0f * PI)), 0.0f, static_cast<float>(AZ_STEPS));
+    float fe = std::clamp((elevation + 0.5f * PI) * (EL_STEPS / PI), 0.0f, static_cast<float>(EL_STEPS));
+    int a = std::min(static_cast<int>(fa), AZ_STEPS - 1);
+    int e = std::min(static_cast<int>(fe), EL_STEPS - 1);
+    float ta = fa - a, te = fe - e;
+
+    const float* g00 = &g[(static_cast<size_t>(e) * (AZ_STEPS + 1) + a) * CHANNELS];
+    const float* g01 = g00 + CHANNELS;
+    const float* g10 = g00 + (AZ_STEPS + 1) * CHANNELS;
+    const float* g11 = g10 + CHANNELS;
+    for (int c = 0; c < CHANNELS; c++) {
+        float lo = g00[c] + ta * (g01[c] - g00[c]);
+        float hi = g10[c] + ta * (g11[c] - g10[c]);
+        out[c] = lo + te * (hi - lo);
+    }
+}
+
+} // namespace
+
+// =============================================================================
+//  Setup: virtual speaker layout, head-model parameters, decoder weights
+// =============================================================================
+
+AmbisonicRenderer::AmbisonicRenderer() {
+    static_assert(ITD_PAD >= SpatialTables::MAX_ITD_SAMPLES + ItdInterpolator::REACH, "ITD history too short");
+
+    bus_.assign(static_cast<size_t>(MAX_BLOCK) * CHANNELS, 0.0f);
+    feed_.assign(static_cast<size_t>(ITD_PAD + MAX_BLOCK) * SPEAKERS, 0.0f);
+    left_.assign(static_cast<size_t>(MAX_BLOCK) * SPEAKERS, 0.0f);
+    right_.assign(static_cast<size_t>(MAX_BLOCK) * SPEAKERS, 0.0f);
+
+    // Spherical Fibonacci layout (near-uniform for any count)
+    const float golden = PI * (3.0f - std::sqrt(5.0f));
+    for (int s = 0; s < SPEAKERS; s++) {
+        const float z = 1.0f - 2.0f * (s + 0.5f) / SPEAKERS;
+        const float r = std::sqrt(1.0f - z * z);
+        const float x = r * std::cos(golden * s);
+        const float y = r * std::sin(golden * s);
+        dirX_[s] = x;
+        dirY_[s] = y;
+        dirZ_[s] = z;
+
+        // Same angles SpatialAudio::place() derives for a source in this direction
+        float frontBack = std::sqrt(x * x + z * z);
+        frontBack = x < 0.0f ? -frontBack : frontBack;
+        const float lateral = SpatialTables::azimuthOf(y, frontBack + 1e-9f);
+        const float elevation = SpatialTables::azimuthOf(z, std::sqrt(x * x + y * y));
+
+        const SpatialTables::AzimuthEntry hrtf = SpatialTables::lookupAzimuth(lateral);
+        const SpatialTables::ElevationEntry cue = SpatialTables::lookupElevation(elevation);
+        delayL_[s] = hrtf.delayL;
+        delayR_[s] = hrtf.delayR;
+        ItdInterpolator::design(itdL_[s], delayL_[s]);
+        ItdInterpolator::design(itdR_[s], delayR_[s]);
+        gainL_[s] = hrtf.gainL * cue.gain;
+        gainR_[s] = hrtf.gainR * cue.gain;
+        // SpatialAudio::HeadShadowFilter with b1 == b0: y = b0·x + (b0 − a1)·y[-1]
+        shadowB0L_[s] = hrtf.shadowB0L;
+        shadowFbL_[s] = hrtf.shadowB0L - hrtf.shadowA1L;
+        shadowB0R_[s] = hrtf.shadowB0R;
+        shadowFbR_[s] = hrtf.shadowB0R - hrtf.shadowA1R;
+        cueAlpha_[s] = cue.cueAlpha;
+        cueHf_[s] = cue.hfGain;
+    }
+
+    // Sampling decoder with max-rE weights: a_l = P_l(rE), rE = cos(137.9° / (N + 1.51))
+    const float rE = std::cos((137.9f / (ORDER + 1.51f)) * (PI / 180.0f));
+    const float legendre[4] = {
+        1.0f,
+        rE,
+        0.5f * (3.0f * rE * rE - 1.0f),
+        0.5f * (5.0f * rE * rE * rE - 3.0f * rE)
+    };
+    static_assert(ORDER == 3, "legendre[] holds P0..P3");
+    for (int l = 0; l <= ORDER; l++) {
+        degreeWeights_[l] = legendre[l] * (2 * l + 1) / static_cast<float>(SPEAKERS);
+    }
+
+    warmUp();
+}
+
+void AmbisonicRenderer::warmUp() {
+    (void)encoderTable();
+}
+
+void AmbisonicRenderer::clear() {
+    std::fill(bus_.begin(), bus_.end(), 0.0f);
+    std::fill(feed_.begin(), feed_.end(), 0.0f);
+    cueLp_ = {};
+    shadowL_ = {};
+    shadowR_ = {};
+    for (int s = 0; s < SPEAKERS; s++) {
+        itdL_[s] = {};
+        itdR_[s] = {};
+        ItdInterpolator::design(itdL_[s], delayL_[s]);
+        ItdInterpolator::design(itdR_[s], delayR_[s]);
+    }
+    decodePrimed_ = false;
+    busActive_ = false;
+    tailBlocks_ = 0;
+}
+
+// =============================================================================
+//  Per-peer encode
+// =============================================================================
+
+void AmbisonicRenderer::addSource(Source& src, const float* mono, int n, float gain,
+                                  const Protocol::Vec3& direction) {
+    if (n <= 0 || n > MAX_BLOCK) return;
+
+    // UE is left-handed (+Y = right at yaw 0); the bus is x front, y left, z up
+    const float x = direction.x, y = -direction.y, z = direction.z;
+    const float azimuth = SpatialTables::azimuthOf(y, x + 1e-9f);
+    const float elevation = SpatialTables::azimuthOf(z, std::sqrt(x * x + y * y));
+
+    std::array<float, CHANNELS> target;
+    lookupEncoder(azimuth, elevation, target.data());
+    for (float& g : target) g *= gain;
+
+    if (!src.primed) {
+        src.gains = target;
+        src.primed = true;
+    }
+
+    // Gains ramp linearly from the previous block's direction and level
+    const std::array<float, CHANNELS> start = src.gains;
+    std::array<float, CHANNELS> step;
+    const float inv = 1.0f / static_cast<float>(n);
+    for (int c = 0; c < CHANNELS; c++) step[c] = (target[c] - start[c]) * inv;
+
+    for (int i = 0; i < n; i++) {
+        float* row = &bus_[static_cast<size_t>(i) * CHANNELS];
+        const float xi = mono[i];
+        const float t = static_cast<float>(i + 1);
+        for (int c = 0; c < CHANNELS; c++) {
+            row[c] += (start[c] + step[c] * t) * xi;
+        }
+    }
+
+    src.gains = target;
+    busActive_ = true;
+}
+
+// =============================================================================
+//  Once per block: rotate (via the decode matrix), decode, binauralize
+// =============================================================================
+
+void AmbisonicRenderer::computeDecodeMatrix(const Protocol::Rot& listenerRot, DecodeMatrix& out) const {
+    float sy, cy, sp, cp, sr, cr;
+    SpatialTables::rotatorSinCos(listenerRot.yaw,   sy, cy);
+    SpatialTables::rotatorSinCos(listenerRot.pitch, sp, cp);
+    SpatialTables::rotatorSinCos(listenerRot.roll,  sr, cr);
+
+    // Listener axes in the bus frame (UE FRotationMatrix axes with Y mirrored)
+    const float fwd[3]  = { cp * cy, -(cp * sy), sp };
+    const float left[3] = { cr * sy - sr * sp * cy, sr * sp * sy + cr * cy, sr * cp };
+    const float up[3]   = { -(cr * sp * cy + sr * sy), -(cy * sr - cr * sp * sy), cr * cp };
+
+    float sh[CHANNELS];
+    for (int s = 0; s < SPEAKERS; s++) {
+        // Head-frame speaker direction → world
+        evaluate(dirX_[s] * fwd[0] + dirY_[s] * left[0] + dirZ_[s] * up[0],
+                 dirX_[s] * fwd[1] + dirY_[s] * left[1] + dirZ_[s] * up[1],
+                 dirX_[s] * fwd[2] + dirY_[s] * left[2] + dirZ_[s] * up[2], sh);
+        for (int c = 0; c < CHANNELS; c++) {
+            out[c][s] = sh[c] * degreeWeights_[degreeOf(c)];
+        }
+    }
+}
+
+void AmbisonicRenderer::render(const Protocol::Rot& listenerRot, float* outL, float* outR, int n) {
+    std::fill(outL, outL + n, 0.0f);
+    std::fill(outR, outR + n, 0.0f);
+    if (!isActive() || n <= 0 || n > MAX_BLOCK) return;
+
+    // One silent block after the last input flushes the ITD history and filters
+    if (busActive_) tailBlocks_ = 1;
+    else tailBlocks_--;
+
+    DecodeMatrix next;
+    computeDecodeMatrix(listenerRot, next);
+    if (!decodePrimed_) {
+        decode_ = next;
+        decodePrimed_ = true;
+    }
+    const bool rotating = next != decode_;
+
+    // ── Decode: feed[i][s] = Σ_c D[c][s] · bus[i][c] ──
+    DecodeMatrix step = next;
+    for (int i0 = 0; i0 < n; i0 += DECODE_STEP) {
+        const int i1 = std::min(n, i0 + DECODE_STEP);
+        if (rotating) {
+            const float t = static_cast<float>(i1) / static_cast<float>(n);
+            for (int c = 0; c < CHANNELS; c++) {
+                for (int s = 0; s < SPEAKERS; s++) {
+                    step[c][s] = decode_[c][s] + t * (next[c][s] - decode_[c][s]);
+                }
+            }
+        }
+        for (int i = i0; i < i1; i++) {
+            const float* in = &bus_[static_cast<size_t>(i) * CHANNELS];
+            float* row = &feed_[static_cast<size_t>(ITD_PAD + i) * SPEAKERS];
+            for (int s = 0; s < SPEAKERS; s++) row[s] = step[0][s] * in[0];
+            for (int c = 1; c < CHANNELS; c++) {
+                const float b = in[c];
+                for (int s = 0; s < SPEAKERS; s++) row[s] += step[c][s] * b;
+            }
+        }
+    }
+    decode_ = next;
+
+    // ── Elevation cue (mono per speaker) ──
+    // Filter state and coefficients as locals: no aliasing with the rows, so the s-loops vectorize
+    SpeakerRow lp = cueLp_;
+    const SpeakerRow alpha = cueAlpha_, hf = cueHf_;
+    for (int i = 0; i < n; i++) {
+        float* row = &feed_[static_cast<size_t>(ITD_PAD + i) * SPEAKERS];
+        for (int s = 0; s < SPEAKERS; s++) {
+            lp[s] += alpha[s] * (row[s] - lp[s]);
+            row[s] = lp[s] + hf[s] * (row[s] - lp[s]);
+        }
+    }
+    cueLp_ = lp;
+
+    // ── ITD: fixed fractional delay per speaker and ear, read from the history rows ──
+    // Row-by-row: the taps of one output row come from the ≤ ITD_PAD rows above it
+    for (int i = 0; i < n; i++) {
+        const float* row = &feed_[static_cast<size_t>(ITD_PAD + i) * SPEAKERS];
+        float* l = &left_[static_cast<size_t>(i) * SPEAKERS];
+        float* r = &right_[static_cast<size_t>(i) * SPEAKERS];
+        for (int s = 0; s < SPEAKERS; s++) {
+            const FractionalDelay::Strided history{ row + s, SPEAKERS };
+            l[s] = ItdInterpolator::read(history, delayL_[s], itdL_[s]);
+            r[s] = ItdInterpolator::read(history, delayR_[s], itdR_[s]);
+        }
+    }
+
+    // ── Head shadow (SpatialAudio's one-pole, 95% filtered) + ILD gain ──
+    // Coefficients and state are passed by value: local copies cannot alias the
+    // rows, so the s-loop vectorizes
+    auto shadow = [n](std::vector<float>& ear, SpeakerRow& state, const SpeakerRow b0,
+                      const SpeakerRow fb, const SpeakerRow gain) {
+        SpeakerRow y = state;
+        for (int i = 0; i < n; i++) {
+            float* x = &ear[static_cast<size_t>(i) * SPEAKERS];
+            for (int s = 0; s < SPEAKERS; s++) {
+                y[s] = b0[s] * x[s] + fb[s] * y[s];
+                x[s] = gain[s] * (0.05f * x[s] + 0.95f * y[s]);
+            }
+        }
+        state = y;
+    };
+    shadow(left_,  shadowL_, shadowB0L_, shadowFbL_, gainL_);
+    shadow(right_, shadowR_, shadowB0R_, shadowFbR_, gainR_);
+
+    // ── Sum the speakers into the ears ──
+    for (int s = 0; s < SPEAKERS; s++) {
+        for (int i = 0; i < n; i++) {
+            outL[i] += left_[static_cast<size_t>(i) * SPEAKERS + s];
+            outR[i] += right_[static_cast<size_t>(i) * SPEAKERS + s];
+        }
+    }
+
+    // Keep the newest rows as ITD history for the next block
+    std::copy(feed_.begin() + static_cast<size_t>(n) * SPEAKERS,
+              feed_.begin() + static_cast<size_t>(n + ITD_PAD) * SPEAKERS, feed_.begin());
+
+    if (busActive_) {
+        std::fill_n(bus_.begin(), static_cast<size_t>(n) * CHANNELS, 0.0f);
+        busActive_ = false;
+    }
+    if (tailBlocks_ <= 0) decodePrimed_ = false;   // Idle: snap to the listener on the next input
+}
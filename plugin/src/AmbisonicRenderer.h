@@ -0,0 +1,117 @@
+#pragma once
+#include "Protocol.h"
+#include "FractionalDelay.h"
+#include <array>
+#include <vector>
+
+/**
+ * Third-order Ambisonic mix bus with a single binaural decode.
+ *
+ * Per callback block:
+ *
+ *   addSource() (per peer) : one gain vector (16 real spherical harmonics,
+ *                            ACN order, SN3D) from a precomputed table over
+ *                            world azimuth/elevation, ramped across the
+ *                            block and multiply-added into the bus
+ *   render()   (once)      : listener rotation + decode to SPEAKERS virtual
+ *                            loudspeakers, each rendered with the parametric
+ *                            head model (ITD, head shadow, ILD, elevation cue)
+ *
+ * Sources are encoded in the world frame, so the per-peer cost does not
+ * depend on where the listener looks. Rotating a sound field by R is the
+ * same as decoding it with the virtual speakers rotated by R⁻¹, so the
+ * rotation is folded into the decode matrix: the speakers' world directions
+ * are recomputed from the listener rotator once per block (not per sample
+ * and not per peer). When the rotation changed, the decode matrix is
+ * interpolated across the block in DECODE_STEP steps.
+ *
+ * Buffers are sample-major and speaker state is kept as arrays over all
+ * speakers, so the filter recursions (serial in time) run as independent
+ * lanes across speakers and vectorize.
+ *
+ * The decoder samples the field at the virtual speakers (spherical
+ * Fibonacci layout) with max-rE weights, which keeps the amplitude sum of
+ * all speaker gains at ~1 for every direction.
+ *
+ * Not thread-safe: addSource()/render() run on the audio thread.
+ */
+class AmbisonicRenderer {
+public:
+    static constexpr int ORDER    = 3;
+    static constexpr int CHANNELS = (ORDER + 1) * (ORDER + 1);   // 16
+    static constexpr int SPEAKERS = 32;
+    static constexpr int MAX_BLOCK = Protocol::FRAME_SIZE;
+
+    /** Per-source encoder state (one per peer). */
+    struct Source {
+        std::array<float, CHANNELS> gains{};   // Encoder gains at the end of the last block
+        bool primed = false;
+
+        void reset() { primed = false; }
+    };
+
+    AmbisonicRenderer();
+
+    AmbisonicRenderer(const AmbisonicRenderer&) = delete;
+    AmbisonicRenderer& operator=(const AmbisonicRenderer&) = delete;
+
+    /**
+     * Encode one block of a source into the bus. direction is the world
+     * vector from the listener to the source (Unreal units, any length).
+     * n must not exceed MAX_BLOCK.
+     */
+    void addSource(Source& src, const float* mono, int n, float gain,
+                   const Protocol::Vec3& direction);
+
+    /** True while the bus holds input or the decoder tail is still ringing. */
+    bool isActive() const { return busActive_ || tailBlocks_ > 0; }
+
+    /** Rotate to the listener, decode to n samples per ear and start the next block. */
+    void render(const Protocol::Rot& listenerRot, float* outL, float* outR, int n);
+
+    /** Drop the bus contents and the decoder state. */
+    void clear();
+
+    /** Build the encoder table now instead of on first use (call off the audio thread). */
+    static void warmUp();
+
+private:
+    /** Rows of ITD history kept ahead of each block (≥ max ITD + interpolator reach) */
+    static constexpr int ITD_PAD = 16;
+
+    /** Speaker ITDs never change, so an allpass: flat magnitude, designed once */
+    using ItdInterpolator = FractionalDelay::Thiran;
+    /** Decode matrix is interpolated in steps of this many samples while the listener turns */
+    static constexpr int DECODE_STEP = 32;
+
+    using SpeakerRow = std::array<float, SPEAKERS>;
+    using DecodeMatrix = std::array<SpeakerRow, CHANNELS>;   // [channel][speaker]
+
+    void computeDecodeMatrix(const Protocol::Rot& listenerRot, DecodeMatrix& out) const;
+
+    // Virtual speakers, head frame (x front, y left, z up), structure of arrays
+    // so the per-sample filter recursions vectorize across speakers
+    SpeakerRow dirX_{}, dirY_{}, dirZ_{};
+    SpeakerRow delayL_{}, delayR_{};                        // ITD in samples
+    std::array<ItdInterpolator::State, SPEAKERS> itdL_{}, itdR_{};
+    SpeakerRow gainL_{}, gainR_{};                          // ILD × elevation level
+    SpeakerRow shadowB0L_{}, shadowFbL_{};                  // Head shadow: y = b0·x + fb·y[-1]
+    SpeakerRow shadowB0R_{}, shadowFbR_{};
+    SpeakerRow cueAlpha_{}, cueHf_{};                       // Elevation spectral cue
+
+    // Filter state per speaker
+    SpeakerRow cueLp_{}, shadowL_{}, shadowR_{};
+
+    std::array<float, ORDER + 1> degreeWeights_{};   // max-rE × (2l + 1) / SPEAKERS
+
+    // Sample-major buffers: row i holds all channels / speakers of sample i
+    std::vector<float> bus_;     // MAX_BLOCK × CHANNELS
+    std::vector<float> feed_;    // (ITD_PAD + MAX_BLOCK) × SPEAKERS, cue-filtered speaker feeds
+    std::vector<float> left_;    // MAX_BLOCK × SPEAKERS, per-speaker ear signals
+    std::vector<float> right_;
+
+    DecodeMatrix decode_{};      // Matrix at the end of the last block
+    bool decodePrimed_ = false;
+    bool busActive_ = false;
+    int  tailBlocks_ = 0;        // Blocks left to flush the decoder state
+};
@@ -0,0 +1,367 @@
+#include "ArenaOcclusion.h"
+#include "ArenaReflections.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace ArenaOcclusion {
+
+namespace {
+
+using Protocol::Vec3;
+
+// Sound let through per part (pressure): solid arena surfaces pass only
+// what diffracts around them, the goal net barely blocks anything
+constexpr float SOLID_TRANSMISSION    = 0.20f;
+constexpr float GOAL_BOX_TRANSMISSION = 0.35f;   // Goal box side walls and roof
+constexpr float NET_TRANSMISSION      = 0.70f;   // Back net of the goal
+constexpr float FRAME_TRANSMISSION    = 0.50f;   // Posts and crossbar (thin, sound bends around)
+
+constexpr float POST_THICKNESS = 80.0f;
+constexpr float SEGMENT_EPSILON = 1e-4f;   // Ignore hits at the segment ends
+constexpr int   SAH_BINS = 12;
+
+Vec3 cross(const Vec3& a, const Vec3& b) {
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+float axis(const Vec3& v, int a) { return a == 0 ? v.x : a == 1 ? v.y : v.z; }
+
+// ── Mesh building ────────────────────────────────────────────────────────
+
+int addPart(Mesh& mesh, float transmission) {
+    mesh.transmission.push_back(transmission);
+    return static_cast<int>(mesh.transmission.size()) - 1;
+}
+
+void quad(Mesh& mesh, const Vec3& p0, const Vec3& p1, const Vec3& p2, const Vec3& p3, int part) {
+    mesh.triangles.push_back({ p0, p1, p2, part });
+    mesh.triangles.push_back({ p0, p2, p3, part });
+}
+
+/** Axis-aligned rectangle in the plane x = c (axis 0), y = c (1) or z = c (2). */
+void rect(Mesh& mesh, int planeAxis, float c, float u0, float u1, float v0, float v1, int part) {
+    auto at = [&](float u, float v) -> Vec3 {
+        if (planeAxis == 0) return { c, u, v };
+        if (planeAxis == 1) return { u, c, v };
+        return { u, v, c };
+    };
+    quad(mesh, at(u0, v0), at(u1, v0), at(u1, v1), at(u0, v1), part);
+}
+
+void box(Mesh& mesh, const Vec3& lo, const Vec3& hi, int part) {
+    rect(mesh, 0, lo.x, lo.y, hi.y, lo.z, hi.z, part);
+    rect(mesh, 0, hi.x, lo.y, hi.y, lo.z, hi.z, part);
+    rect(mesh, 1, lo.y, lo.x, hi.x, lo.z, hi.z, part);
+    rect(mesh, 1, hi.y, lo.x, hi.x, lo.z, hi.z, part);
+    rect(mesh, 2, lo.z, lo.x, hi.x, lo.y, hi.y, part);
+    rect(mesh, 2, hi.z, lo.x, hi.x, lo.y, hi.y, part);
+}
+
+// ── Intersection ─────────────────────────────────────────────────────────
+
+/** Two-sided segment/triangle test (Möller–Trumbore), t in the open segment. */
+bool hitsTriangle(const Triangle& tri, const Vec3& from, const Vec3& dir) {
+    const Vec3 e1 = tri.b - tri.a;
+    const Vec3 e2 = tri.c - tri.a;
+    const Vec3 p = cross(dir, e2);
+    const float det = e1.dot(p);
+    if (std::abs(det) < 1e-9f) return false;   // Parallel
+    const float inv = 1.0f / det;
+    const Vec3 s = from - tri.a;
+    const float u = s.dot(p) * inv;
+    if (u < 0.0f || u > 1.0f) return false;
+    const Vec3 q = cross(s, e1);
+    const float v = dir.dot(q) * inv;
+    if (v < 0.0f || u + v > 1.0f) return false;
+    const float t = e2.dot(q) * inv;
+    return t > SEGMENT_EPSILON && t < 1.0f - SEGMENT_EPSILON;
+}
+
+struct Segment {
+    Vec3 from, dir;
+    float origin[3], invDir[3];
+
+    Segment(const Vec3& a, const Vec3& b) : from(a), dir(b - a) {
+        for (int i = 0; i < 3; i++) {
+            const float d = axis(dir, i);
+            origin[i] = axis(a, i);
+            invDir[i] = std::abs(d) > 1e-12f ? 1.0f / d : (d < 0.0f ? -1e30f : 1e30f);
+        }
+    }
+
+    bool overlaps(const float lo[3], const float hi[3]) const {
+        float tmin = 0.0f, tmax = 1.0f;
+        for (int i = 0; i < 3; i++) {
+            const float t0 = (lo[i] - origin[i]) * invDir[i];
+            const float t1 = (hi[i] - origin[i]) * invDir[i];
+            tmin = std::max(tmin, std::min(t0, t1));
+            tmax = std::min(tmax, std::max(t0, t1));
+        }
+        return tmin <= tmax;
+    }
+};
+
+/** Tracks the parts a segment has crossed and the transmission so far. */
+struct Hits {
+    uint64_t parts = 0;
+    float transmission = 1.0f;
+
+    void add(const Mesh& mesh, int part) {
+        const uint64_t bit = uint64_t{ 1 } << part;
+        if (parts & bit) return;   // A closed solid or a two-triangle quad counts once
+        parts |= bit;
+        transmission *= mesh.transmission[part];
+    }
+    bool blocked() const { return transmission < MIN_TRANSMISSION; }
+};
+
+// ── Build helpers ────────────────────────────────────────────────────────
+
+struct Bounds {
+    float lo[3] = { 1e30f, 1e30f, 1e30f };
+    float hi[3] = { -1e30f, -1e30f, -1e30f };
+
+    void grow(const Vec3& p) {
+        for (int i = 0; i < 3; i++) {
+            lo[i] = std::min(lo[i], axis(p, i));
+            hi[i] = std::max(hi[i], axis(p, i));
+        }
+    }
+    void grow(const Triangle& t) { grow(t.a); grow(t.b); grow(t.c); }
+    void grow(const Bounds& b) {
+        for (int i = 0; i < 3; i++) {
+            lo[i] = std::min(lo[i], b.lo[i]);
+            hi[i] = std::max(hi[i], b.hi[i]);
+        }
+    }
+    float area() const {
+        const float dx = hi[0] - lo[0], dy = hi[1] - lo[1], dz = hi[2] - lo[2];
+        if (dx < 0.0f) return 0.0f;
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+float centroid(const Triangle& t, int a) {
+    return (axis(t.a, a) + axis(t.b, a) + axis(t.c, a)) * (1.0f / 3.0f);
+}
+
+} // namespace
+
+// =============================================================================
+//  BVH
+// =============================================================================
+
+void Bvh::build(Mesh mesh) {
+    mesh_ = std::move(mesh);
+    nodes_.clear();
+    if (mesh_.triangles.empty()) return;
+    nodes_.reserve(mesh_.triangles.size() * 2);
+    buildNode(0, static_cast<int>(mesh_.triangles.size()), 0);
+}
+
+int Bvh::buildNode(int first, int count, int depth) {
+    const int index = static_cast<int>(nodes_.size());
+    nodes_.push_back({});
+
+    Bounds bounds, centres;
+    for (int i = first; i < first + count; i++) {
+        const Triangle& t = mesh_.triangles[i];
+        bounds.grow(t);
+        centres.grow(Vec3{ centroid(t, 0), centroid(t, 1), centroid(t, 2) });
+    }
+    {
+        Node& node = nodes_[index];
+        std::copy(bounds.lo, bounds.lo + 3, node.lo);
+        std::copy(bounds.hi, bounds.hi + 3, node.hi);
+        node.first = first;
+        node.count = count;
+    }
+    if (count <= MAX_LEAF || depth >= MAX_DEPTH) return index;
+
+    // Binned SAH along the longest centroid axis
+    int a = 0;
+    for (int i = 1; i < 3; i++) {
+        if (centres.hi[i] - centres.lo[i] > centres.hi[a] - centres.lo[a]) a = i;
+    }
+    const float extent = centres.hi[a] - centres.lo[a];
+    if (extent <= 0.0f) return index;   // All centroids coincide: keep as a leaf
+
+    std::array<Bounds, SAH_BINS> binBounds;
+    std::array<int, SAH_BINS> binCount{};
+    const float scale = SAH_BINS / extent;
+    auto binOf = [&](const Triangle& t) {
+        return std::min(static_cast<int>((centroid(t, a) - centres.lo[a]) * scale), SAH_BINS - 1);
+    };
+    for (int i = first; i < first + count; i++) {
+        const int b = binOf(mesh_.triangles[i]);
+        binBounds[b].grow(mesh_.triangles[i]);
+        binCount[b]++;
+    }
+
+    // Sweep from the right, then from the left, to cost every split plane
+    std::array<float, SAH_BINS - 1> rightCost{};
+    Bounds acc;
+    int n = 0;
+    for (int b = SAH_BINS - 1; b > 0; b--) {
+        acc.grow(binBounds[b]);
+        n += binCount[b];
+        rightCost[b - 1] = acc.area() * static_cast<float>(n);
+    }
+    float bestCost = bounds.area() * static_cast<float>(count);   // Cost of not splitting
+    int bestSplit = -1;
+    acc = Bounds{};
+    n = 0;
+    for (int b = 0; b < SAH_BINS - 1; b++) {
+        acc.grow(binBounds[b]);
+        n += binCount[b];
+        const float cost = acc.area() * static_cast<float>(n) + rightCost[b];
+        if (n > 0 && n < count && cost < bestCost) {
+            bestCost = cost;
+            bestSplit = b;
+        }
+    }
+    if (bestSplit < 0) return index;
+
+    auto* begin = mesh_.triangles.data() + first;
+    auto* mid = std::partition(begin, begin + count,
+                               [&](const Triangle& t) { return binOf(t) <= bestSplit; });
+    const int leftCount = static_cast<int>(mid - begin);
+
+    buildNode(first, leftCount, depth + 1);
+    const int right = buildNode(first + leftCount, count - leftCount, depth + 1);
+    nodes_[index].first = right;
+    nodes_[index].count = 0;
+    return index;
+}
+
+float Bvh::transmission(const Protocol::Vec3& from, const Protocol::Vec3& to) const {
+    if (nodes_.empty()) return 1.0f;
+
+    const Segment seg(from, to);
+    Hits hits;
+    std::array<int, MAX_DEPTH + 2> stack;
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = nodes_[stack[--top]];
+        if (!seg.overlaps(node.lo, node.hi)) continue;
+        if (node.count > 0) {
+            for (int i = node.first; i < node.first + node.count; i++) {
+                const Triangle& t = mesh_.triangles[i];
+                if (hits.parts & (uint64_t{ 1 } << t.part)) continue;
+                if (hitsTriangle(t, seg.from, seg.dir)) {
+                    hits.add(mesh_, t.part);
+                    if (hits.blocked()) return 0.0f;
+                }
+            }
+        } else {
+            const int self = static_cast<int>(&node - nodes_.data());
+            stack[top++] = node.first;   // Right
+            stack[top++] = self + 1;     // Left, visited first
+        }
+    }
+    return hits.transmission;
+}
+
+float Bvh::transmissionBruteForce(const Protocol::Vec3& from, const Protocol::Vec3& to) const {
+    const Vec3 dir = to - from;
+    Hits hits;
+    for (const Triangle& t : mesh_.triangles) {
+        if (hitsTriangle(t, from, dir)) {
+            hits.add(mesh_, t.part);
+            if (hits.blocked()) return 0.0f;
+        }
+    }
+    return hits.transmission;
+}
+
+// =============================================================================
+//  Soccar
+// =============================================================================
+
+Mesh soccarMesh() {
+    Mesh mesh;
+
+    // Arena dimensions shared with the reflection model
+    const float X  = ArenaReflections::SIDE_WALL_X;
+    const float Y  = ArenaReflections::BACK_WALL_Y;
+    const float Z  = ArenaReflections::CEILING_Z;
+    const float GX = ArenaReflections::GOAL_HALF_WIDTH;
+    const float GY = ArenaReflections::GOAL_BACK_Y;
+    const float GZ = ArenaReflections::GOAL_HEIGHT;
+
+    // ── Shell ──
+    const int floor = addPart(mesh, SOLID_TRANSMISSION);
+    rect(mesh, 2, 0.0f, -X, X, -Y, Y, floor);
+    rect(mesh, 2, 0.0f, -GX, GX, Y, GY, floor);
+    rect(mesh, 2, 0.0f, -GX, GX, -GY, -Y, floor);
+
+    const int ceiling = addPart(mesh, SOLID_TRANSMISSION);
+    rect(mesh, 2, Z, -X, X, -Y, Y, ceiling);
+
+    for (float sx : { -X, X }) {
+        rect(mesh, 0, sx, -Y, Y, 0.0f, Z, addPart(mesh, SOLID_TRANSMISSION));
+    }
+
+    // ── Back walls (mouth cut out) and goals ──
+    for (float sign : { -1.0f, 1.0f }) {
+        const float wallY = sign * Y;
+        const int wall = addPart(mesh, SOLID_TRANSMISSION);
+        rect(mesh, 1, wallY, -X, -GX, 0.0f, Z, wall);
+        rect(mesh, 1, wallY, GX, X, 0.0f, Z, wall);
+        rect(mesh, 1, wallY, -GX, GX, GZ, Z, wall);
+
+        const float y0 = std::min(wallY, sign * GY), y1 = std::max(wallY, sign * GY);
+        const int goalBox = addPart(mesh, GOAL_BOX_TRANSMISSION);
+        rect(mesh, 0, -GX, y0, y1, 0.0f, GZ, goalBox);
+        rect(mesh, 0, GX, y0, y1, 0.0f, GZ, goalBox);
+        rect(mesh, 2, GZ, -GX, GX, y0, y1, goalBox);
+
+        rect(mesh, 1, sign * GY, -GX, GX, 0.0f, GZ, addPart(mesh, NET_TRANSMISSION));
+
+        // Posts and crossbar stand just in front of the wall, around the mouth
+        const int frame = addPart(mesh, FRAME_TRANSMISSION);
+        const float f0 = std::min(wallY, wallY - sign * POST_THICKNESS);
+        const float f1 = std::max(wallY, wallY - sign * POST_THICKNESS);
+        box(mesh, { -GX - POST_THICKNESS, f0, 0.0f }, { -GX, f1, GZ + POST_THICKNESS }, frame);
+        box(mesh, { GX, f0, 0.0f }, { GX + POST_THICKNESS, f1, GZ + POST_THICKNESS }, frame);
+        box(mesh, { -GX, f0, GZ }, { GX, f1, GZ + POST_THICKNESS }, frame);
+    }
+    return mesh;
+}
+
+namespace {
+
+const Bvh& soccar() {
+    static const Bvh bvh(soccarMesh());
+    return bvh;
+}
+
+} // namespace
+
+float openness(const Protocol::Vec3& listenerPos, const Protocol::Vec3& sourcePos) {
+    const Vec3 dir = sourcePos - listenerPos;
+    if (dir.lengthSq() < 1.0f) return 1.0f;
+
+    // Spread the extra rays across the source, perpendicular to the line of sight
+    const Vec3 forward = dir.normalized();
+    Vec3 u = cross(forward, Vec3{ 0.0f, 0.0f, 1.0f });
+    if (u.lengthSq() < 1e-6f) u = Vec3{ 1.0f, 0.0f, 0.0f };   // Straight up/down
+    u = u.normalized() * RAY_SPREAD;
+    const Vec3 v = cross(forward, u);
+
+    const std::array<Vec3, RAYS> targets = {
+        sourcePos, sourcePos + u, sourcePos - u, sourcePos + v, sourcePos - v
+    };
+    const Bvh& bvh = soccar();
+    float sum = 0.0f;
+    for (const Vec3& t : targets) sum += bvh.transmission(listenerPos, t);
+    return sum * (1.0f / RAYS);
+}
+
+void warmUp() {
+    (void)soccar();
+}
+
+} // namespace ArenaOcclusion
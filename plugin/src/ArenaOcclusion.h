@@ -0,0 +1,92 @@
+#pragma once
+#include "Protocol.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Line-of-sight occlusion against a simplified Soccar collision mesh.
+ *
+ * The mesh is the arena shell (floor, ceiling, side walls, back walls
+ * with the goal mouths cut out) plus both goals: box side walls, roof,
+ * back net, posts and crossbar. Corner ramps and rounding are ignored, as
+ * in ArenaReflections. Triangles are grouped into parts, each with the
+ * fraction of sound it lets through (diffraction and thin nets included).
+ *
+ * openness() casts RAYS segments from the listener to points spread
+ * around the source, multiplies the transmission of every distinct part
+ * each one crosses and averages the rays, so a post in front of half a
+ * car occludes it by half. It runs once per position update, not per
+ * sample; SpatialAudio turns the result into a gain and a low-pass.
+ *
+ * The triangles live in a BVH (binned SAH, flattened depth-first) built
+ * once at load; a segment visits a handful of nodes instead of every
+ * triangle.
+ */
+namespace ArenaOcclusion {
+
+    constexpr int   RAYS        = 5;        // Centre + 4 around the source
+    constexpr float RAY_SPREAD  = 80.0f;    // uu, about half a car
+    constexpr float MIN_TRANSMISSION = 0.02f;   // Stop tracing a ray below this
+    constexpr int   MAX_PARTS   = 64;       // Parts are tracked in a 64-bit mask per ray
+
+    /** One mesh triangle; part groups the triangles of one surface or solid. */
+    struct Triangle {
+        Protocol::Vec3 a, b, c;
+        int part;
+    };
+
+    struct Mesh {
+        std::vector<Triangle> triangles;
+        std::vector<float> transmission;   // Per part, 0 = blocks everything
+    };
+
+    /**
+     * Bounding volume hierarchy over a triangle mesh, answering
+     * "how much sound gets through along this segment".
+     */
+    class Bvh {
+    public:
+        static constexpr int MAX_LEAF  = 4;
+        static constexpr int MAX_DEPTH = 48;
+
+        Bvh() = default;
+        explicit Bvh(Mesh mesh) { build(std::move(mesh)); }
+
+        /** Build (or rebuild) over a mesh. Call off the audio thread. */
+        void build(Mesh mesh);
+
+        /** Product of the transmission of every part the segment crosses. */
+        float transmission(const Protocol::Vec3& from, const Protocol::Vec3& to) const;
+
+        /** Same result by testing every triangle (reference for the bench). */
+        float transmissionBruteForce(const Protocol::Vec3& from, const Protocol::Vec3& to) const;
+
+        int nodeCount() const { return static_cast<int>(nodes_.size()); }
+        int triangleCount() const { return static_cast<int>(mesh_.triangles.size()); }
+
+    private:
+        struct Node {
+            float lo[3], hi[3];
+            int first;   // Leaf: first triangle; inner: index of the right child (left is next)
+            int count;   // Triangles in a leaf, 0 for inner nodes
+        };
+
+        int buildNode(int first, int count, int depth);
+
+        Mesh mesh_;
+        std::vector<Node> nodes_;
+    };
+
+    /** The simplified Soccar mesh described above. */
+    Mesh soccarMesh();
+
+    /**
+     * Fraction of the source that reaches the listener, 1 = clear line of
+     * sight, averaged over RAYS segments. Uses the Soccar BVH.
+     */
+    float openness(const Protocol::Vec3& listenerPos, const Protocol::Vec3& sourcePos);
+
+    /** Build the BVH now instead of on first query (call off the audio thread). */
+    void warmUp();
+
+} // namespace ArenaOcclusion
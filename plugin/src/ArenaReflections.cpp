@@ -0,0 +1,129 @@
+#include "ArenaReflections.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ArenaReflections {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double UU_PER_METER = 100.0;
+constexpr double SPEED_OF_SOUND = 343.0;
+constexpr double MIN_DIRECT_UU = 100.0;   // Keep the spreading ratio finite up close
+
+// Surface absorption: fraction of pressure reflected
+constexpr double FLOOR_REFLECT   = 0.45;   // Turf
+constexpr double CEILING_REFLECT = 0.60;
+constexpr double WALL_REFLECT    = 0.75;   // Hard walls
+constexpr double GOAL_REFLECT    = 0.40;   // Goal net / back of the goal box
+
+struct Vec {
+    double x, y, z;
+};
+
+double length(const Vec& v) { return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z); }
+
+Vec cellCentre(int cell) {
+    int z = cell / (CELLS_X * CELLS_Y);
+    int y = (cell / CELLS_X) % CELLS_Y;
+    int x = cell % CELLS_X;
+    const double cx = 2.0 * SIDE_WALL_X / CELLS_X;
+    const double cy = 2.0 * GOAL_BACK_Y / CELLS_Y;
+    return {
+        -SIDE_WALL_X + (x + 0.5) * cx,
+        -GOAL_BACK_Y + (y + 0.5) * cy,
+        z == 0 ? 160.0 : 0.5 * (GROUND_LAYER_Z + CEILING_Z)
+    };
+}
+
+/** Image-source reflection off an axis-aligned plane (axis 0/1/2 = x/y/z at coord). */
+Tap reflect(const Vec& src, const Vec& lis, int axis, double coord, double reflectGain) {
+    Vec image = src;
+    double* c = axis == 0 ? &image.x : axis == 1 ? &image.y : &image.z;
+    *c = 2.0 * coord - *c;
+
+    double direct = std::max(length({ lis.x - src.x, lis.y - src.y, lis.z - src.z }), MIN_DIRECT_UU);
+    Vec path{ image.x - lis.x, image.y - lis.y, image.z - lis.z };
+    double reflected = length(path);
+
+    double delay = (reflected - direct) / UU_PER_METER / SPEED_OF_SOUND * Protocol::SAMPLE_RATE;
+    if (delay < 1.0 || delay > MAX_DELAY_SAMPLES) return { 0, 0, 0 };
+
+    double gain = std::clamp(reflectGain * direct / reflected, 0.0, 1.0);
+    double yaw = std::atan2(path.y, path.x) * (32768.0 / PI);   // UE units, [-32768, 32768]
+    return {
+        static_cast<uint16_t>(std::lround(delay)),
+        static_cast<uint16_t>(std::lround(gain * 65535.0)),
+        static_cast<uint16_t>(static_cast<int>(std::lround(yaw)) & 0xFFFF)
+    };
+}
+
+/** Point where the listener→image path crosses the back wall plane. */
+Vec crossing(const Vec& lis, const Vec& image, double planeY) {
+    double t = (planeY - lis.y) / (image.y - lis.y);
+    return { lis.x + t * (image.x - lis.x), planeY, lis.z + t * (image.z - lis.z) };
+}
+
+bool insideGoalMouth(const Vec& p) {
+    return std::abs(p.x) < GOAL_HALF_WIDTH && p.z < GOAL_HEIGHT;
+}
+
+/** Back wall at ±BACK_WALL_Y, or the goal box behind it when the path goes through the goal mouth. */
+Tap reflectBackWall(const Vec& src, const Vec& lis, double sign) {
+    Vec image{ src.x, 2.0 * sign * BACK_WALL_Y - src.y, src.z };
+    bool inGoal = std::abs(src.y) > BACK_WALL_Y || std::abs(lis.y) > BACK_WALL_Y;
+    if (inGoal || insideGoalMouth(crossing(lis, image, sign * BACK_WALL_Y))) {
+        return reflect(src, lis, 1, sign * GOAL_BACK_Y, GOAL_REFLECT);
+    }
+    return reflect(src, lis, 1, sign * BACK_WALL_Y, WALL_REFLECT);
+}
+
+struct Table {
+    std::vector<Tap> taps;   // [sourceCell][listenerCell][TAPS]
+
+    Table() : taps(static_cast<size_t>(CELLS) * CELLS * TAPS) {
+        for (int s = 0; s < CELLS; s++) {
+            const Vec src = cellCentre(s);
+            for (int l = 0; l < CELLS; l++) {
+                const Vec lis = cellCentre(l);
+                Tap* t = &taps[(static_cast<size_t>(s) * CELLS + l) * TAPS];
+                t[0] = reflect(src, lis, 2, 0.0, FLOOR_REFLECT);
+                t[1] = reflect(src, lis, 2, CEILING_Z, CEILING_REFLECT);
+                t[2] = reflect(src, lis, 0, -SIDE_WALL_X, WALL_REFLECT);
+                t[3] = reflect(src, lis, 0, SIDE_WALL_X, WALL_REFLECT);
+                t[4] = reflectBackWall(src, lis, -1.0);
+                t[5] = reflectBackWall(src, lis, 1.0);
+            }
+        }
+    }
+};
+
+const Table& table() {
+    static const Table t;
+    return t;
+}
+
+int axisCell(float v, float lo, float hi, int cells) {
+    int c = static_cast<int>((v - lo) * (static_cast<float>(cells) / (hi - lo)));
+    return std::clamp(c, 0, cells - 1);
+}
+
+} // namespace
+
+int cellOf(const Protocol::Vec3& pos) {
+    int x = axisCell(pos.x, -SIDE_WALL_X, SIDE_WALL_X, CELLS_X);
+    int y = axisCell(pos.y, -GOAL_BACK_Y, GOAL_BACK_Y, CELLS_Y);
+    int z = pos.z < GROUND_LAYER_Z ? 0 : 1;
+    return (z * CELLS_Y + y) * CELLS_X + x;
+}
+
+const Tap* lookup(int sourceCell, int listenerCell) {
+    return &table().taps[(static_cast<size_t>(sourceCell) * CELLS + listenerCell) * TAPS];
+}
+
+void warmUp() {
+    (void)table();
+}
+
+} // namespace ArenaReflections
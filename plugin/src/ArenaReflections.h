@@ -0,0 +1,56 @@
+#pragma once
+#include "Protocol.h"
+#include <cstdint>
+
+/**
+ * First-order image-source model of the standard Soccar arena, baked into
+ * a grid over (source cell, listener cell) pairs.
+ *
+ * Surfaces: floor, ceiling, both side walls and both back walls; where the
+ * back-wall reflection point falls inside a goal mouth, the goal box's back
+ * wall is used instead. Corner ramps and rounding are ignored.
+ *
+ * For every pair of cell centres the table holds, per surface, the delay
+ * of the reflected path relative to the direct path, its gain (spreading
+ * relative to the direct path × surface absorption) and the world yaw the
+ * reflection arrives from. The table is built once at load; at runtime a
+ * lookup is two cell indices and a pointer. Reflections later than
+ * MAX_DELAY_SAMPLES belong to the late tail and are dropped (delay 0).
+ */
+namespace ArenaReflections {
+
+    // ── Arena geometry (Unreal units) ────────────────────────────────────
+    constexpr float SIDE_WALL_X     = 4096.0f;
+    constexpr float BACK_WALL_Y     = 5120.0f;
+    constexpr float CEILING_Z       = 2044.0f;
+    constexpr float GOAL_HALF_WIDTH = 893.0f;
+    constexpr float GOAL_HEIGHT     = 642.0f;
+    constexpr float GOAL_BACK_Y     = 6000.0f;
+
+    // ── Grid ─────────────────────────────────────────────────────────────
+    constexpr int CELLS_X = 8;     // 1024 uu over the field width
+    constexpr int CELLS_Y = 12;    // 1000 uu, goal box to goal box
+    constexpr int CELLS_Z = 2;     // Ground (< GROUND_LAYER_Z) / aerial
+    constexpr int CELLS   = CELLS_X * CELLS_Y * CELLS_Z;
+    constexpr float GROUND_LAYER_Z = 512.0f;
+
+    constexpr int TAPS = 6;                       // One per surface
+    constexpr int MAX_DELAY_SAMPLES = 8000;       // ~167ms: ceiling always, walls within ~half a field
+
+    /** One baked reflection (delaySamples == 0: no reflection). */
+    struct Tap {
+        uint16_t delaySamples;
+        uint16_t gain;          // Q16: 65535 = 1.0
+        uint16_t arrivalYaw;    // World direction, UE rotator units
+    };
+
+    /** Grid cell containing a world position (clamped to the arena). */
+    int cellOf(const Protocol::Vec3& pos);
+
+    /** Baked taps for a (source cell, listener cell) pair: TAPS entries. */
+    const Tap* lookup(int sourceCell, int listenerCell);
+
+    /** Build the table now instead of on first lookup (call off the audio thread). */
+    void warmUp();
+
+} // namespace ArenaReflections
@@ -1,22 +1,43 @@
 #include "pch.h"
 #include "AudioEngine.h"
+#include "SpatialKernels.h"
+#include "ArenaOcclusion.h"
 #include <cmath>
 #include <algorithm>
+#include <random>
 
 // ═════════════════════════════════════════════════════════════════════════════
 // Lifecycle
 // ═════════════════════════════════════════════════════════════════════════════
 
-AudioEngine::AudioEngine() {
+template <class Flavor>
+BasicAudioEngine<Flavor>::BasicAudioEngine() {
     captureAccumBuffer_.resize(Protocol::FRAME_SIZE, 0.0f);
     mixBuffer_.resize(Protocol::FRAME_SIZE * 2, 0.0f); // Stereo mix buffer
+
+    hrirOutL_.resize(Protocol::FRAME_SIZE, 0.0f);
+    hrirOutR_.resize(Protocol::FRAME_SIZE, 0.0f);
+
+    // Random sequence and clock origins, so a restarted sender is not taken
+    // for the tail of its previous stream
+    std::random_device seed;
+    captureTimestamp_ = static_cast<uint32_t>(seed());
+    sendSequence_ = static_cast<uint16_t>(seed());
+
+    ArenaOcclusion::warmUp();   // Build the arena BVH off the audio thread
+
+    batchQueue_.reserve(Fanout::MAX_SOURCES);
+    publishDistanceModel();
+    setWorkerThreads(Protocol::DEFAULT_AUDIO_WORKERS);
 }
 
-AudioEngine::~AudioEngine() {
+template <class Flavor>
+BasicAudioEngine<Flavor>::~BasicAudioEngine() {
     shutdown();
 }
 
-bool AudioEngine::initialize() {
+template <class Flavor>
+bool BasicAudioEngine<Flavor>::initialize() {
     if (initialized_) return true;
 
     PaError err = Pa_Initialize();
@@ -41,11 +62,14 @@ bool AudioEngine::initialize() {
     return true;
 }
 
-void AudioEngine::shutdown() {
+template <class Flavor>
+void BasicAudioEngine<Flavor>::shutdown() {
     stopStreams();
+    waitForLateRenders();
 
     {
         std::lock_guard<std::mutex> lock(peersMutex_);
+        decodePeers_.clear();
         peers_.clear();
     }
 
@@ -57,7 +81,8 @@ void AudioEngine::shutdown() {
     }
 }
 
-bool AudioEngine::startStreams() {
+template <class Flavor>
+bool BasicAudioEngine<Flavor>::startStreams() {
     if (!initialized_ || streaming_) return streaming_;
 
     PaError err;
@@ -89,11 +114,22 @@ bool AudioEngine::startStreams() {
         }
     }
 
-    // ── Playback stream (stereo output) ─────────────────────────────────
+    // ── Playback stream (stereo, or one channel per speaker) ────────────
     if (outputDeviceId_ >= 0) {
+        outputChannels_ = Protocol::CHANNELS_STEREO;
+        if (renderer_ == Renderer::Speakers) {
+            const PaDeviceInfo* info = Pa_GetDeviceInfo(outputDeviceId_);
+            if (info && info->maxOutputChannels >= speakerBus_.channels()) {
+                outputChannels_ = speakerBus_.channels();
+            } else {
+                setError("Output device has fewer than " + std::to_string(speakerBus_.channels()) +
+                         " channels - using stereo");
+            }
+        }
+
         PaStreamParameters outputParams{};
         outputParams.device = outputDeviceId_;
-        outputParams.channelCount = Protocol::CHANNELS_STEREO;
+        outputParams.channelCount = outputChannels_;
         outputParams.sampleFormat = paFloat32;
         outputParams.suggestedLatency = Pa_GetDeviceInfo(outputDeviceId_)->defaultLowOutputLatency;
         outputParams.hostApiSpecificStreamInfo = nullptr;
@@ -135,10 +171,14 @@ bool AudioEngine::startStreams() {
     }
 
     streaming_ = (captureStream_ != nullptr || playbackStream_ != nullptr);
+    if (playbackStream_) startDecodeWorker();
     return streaming_;
 }
 
-void AudioEngine::stopStreams() {
+template <class Flavor>
+void BasicAudioEngine<Flavor>::stopStreams() {
+    stopDecodeWorker();
+
     if (captureStream_) {
         Pa_StopStream(captureStream_);
         Pa_CloseStream(captureStream_);
@@ -152,6 +192,10 @@ void AudioEngine::stopStreams() {
     }
 
     streaming_ = false;
+    masterBus_.clear();
+    if (hrirBus_) hrirBus_->clear();
+    ambisonicBus_.clear();
+    speakerBus_.clear();
     captureAccumPos_ = 0;
     holdFramesRemaining_ = 0;
     isSpeaking_ = false;
@@ -161,7 +205,9 @@ void AudioEngine::stopStreams() {
 // Device Management
 // ═════════════════════════════════════════════════════════════════════════════
 
-std::vector<AudioEngine::DeviceInfo> AudioEngine::getInputDevices() const {
+template <class Flavor>
+std::vector<typename BasicAudioEngine<Flavor>::DeviceInfo>
+BasicAudioEngine<Flavor>::getInputDevices() const {
     std::vector<DeviceInfo> devices;
     if (!initialized_) return devices;
 
@@ -184,7 +230,9 @@ std::vector<AudioEngine::DeviceInfo> AudioEngine::getInputDevices() const {
     return devices;
 }
 
-std::vector<AudioEngine::DeviceInfo> AudioEngine::getOutputDevices() const {
+template <class Flavor>
+std::vector<typename BasicAudioEngine<Flavor>::DeviceInfo>
+BasicAudioEngine<Flavor>::getOutputDevices() const {
     std::vector<DeviceInfo> devices;
     if (!initialized_) return devices;
 
@@ -207,7 +255,8 @@ std::vector<AudioEngine::DeviceInfo> AudioEngine::getOutputDevices() const {
     return devices;
 }
 
-bool AudioEngine::setInputDevice(int deviceId) {
+template <class Flavor>
+bool BasicAudioEngine<Flavor>::setInputDevice(int deviceId) {
     if (!initialized_) return false;
 
     const PaDeviceInfo* info = Pa_GetDeviceInfo(deviceId);
@@ -222,7 +271,8 @@ bool AudioEngine::setInputDevice(int deviceId) {
     return true;
 }
 
-bool AudioEngine::setOutputDevice(int deviceId) {
+template <class Flavor>
+bool BasicAudioEngine<Flavor>::setOutputDevice(int deviceId) {
     if (!initialized_) return false;
 
     const PaDeviceInfo* info = Pa_GetDeviceInfo(deviceId);
@@ -241,28 +291,30 @@ bool AudioEngine::setOutputDevice(int deviceId) {
 // PortAudio Callbacks
 // ═════════════════════════════════════════════════════════════════════════════
 
-int AudioEngine::captureCallback(
+template <class Flavor>
+int BasicAudioEngine<Flavor>::captureCallback(
     const void* input, void* /*output*/,
     unsigned long frameCount,
     const PaStreamCallbackTimeInfo* /*timeInfo*/,
     PaStreamCallbackFlags /*statusFlags*/,
     void* userData)
 {
-    auto* engine = static_cast<AudioEngine*>(userData);
+    auto* engine = static_cast<BasicAudioEngine*>(userData);
     if (input) {
         engine->processCapturedAudio(static_cast<const float*>(input), frameCount);
     }
     return paContinue;
 }
 
-int AudioEngine::playbackCallback(
+template <class Flavor>
+int BasicAudioEngine<Flavor>::playbackCallback(
     const void* /*input*/, void* output,
     unsigned long frameCount,
     const PaStreamCallbackTimeInfo* /*timeInfo*/,
     PaStreamCallbackFlags /*statusFlags*/,
     void* userData)
 {
-    auto* engine = static_cast<AudioEngine*>(userData);
+    auto* engine = static_cast<BasicAudioEngine*>(userData);
     engine->processPlaybackAudio(static_cast<float*>(output), frameCount);
     return paContinue;
 }
@@ -271,11 +323,15 @@ int AudioEngine::playbackCallback(
 // Audio Processing
 // ═════════════════════════════════════════════════════════════════════════════
 
-void AudioEngine::processCapturedAudio(const float* input, unsigned long frameCount) {
+template <class Flavor>
+void BasicAudioEngine<Flavor>::processCapturedAudio(const float* input, unsigned long frameCount) {
     // When demolished, completely silence the microphone — others can't hear you
-    if (micMuted_ || isDemolished_) {
+    bool silenced = micMuted_;
+    if constexpr (Flavor::DEMOLITION_SILENCES) silenced = silenced || isDemolished_;
+    if (silenced) {
         isSpeaking_ = false;
         currentInputLevel_ = 0.0f;
+        captureTimestamp_ += static_cast<uint32_t>(frameCount);   // The sample clock runs on
         return;
     }
 
@@ -290,6 +346,8 @@ void AudioEngine::processCapturedAudio(const float* input, unsigned long frameCo
         if (captureAccumPos_ >= Protocol::FRAME_SIZE) {
             // We have a full frame — process it
             captureAccumPos_ = 0;
+            const uint32_t frameTimestamp = captureTimestamp_;
+            captureTimestamp_ += Protocol::FRAME_SIZE;
 
             // Calculate input level
             float rms = 0.0f;
@@ -313,9 +371,10 @@ void AudioEngine::processCapturedAudio(const float* input, unsigned long frameCo
                 // Encode with Opus
                 auto encoded = localCodec_.encode(captureAccumBuffer_.data(), Protocol::FRAME_SIZE);
                 if (!encoded.empty()) {
-                    // Build network packet with local position
+                    // Build network packet with local position, sequence number and capture clock
                     Protocol::Vec3 pos = localPosition_;
-                    auto packet = Protocol::buildOutgoingAudioPacket(pos, encoded.data(), encoded.size());
+                    auto packet = Protocol::buildOutgoingSequencedAudioPacket(
+                        sendSequence_++, frameTimestamp, pos, encoded.data(), encoded.size());
                     packetReadyCb_(packet);
                 }
             }
@@ -323,155 +382,279 @@ void AudioEngine::processCapturedAudio(const float* input, unsigned long frameCo
     }
 }
 
-void AudioEngine::processPlaybackAudio(float* output, unsigned long frameCount) {
-    // Clear output buffer (stereo)
-    std::memset(output, 0, frameCount * Protocol::CHANNELS_STEREO * sizeof(float));
+template <class Flavor>
+void BasicAudioEngine<Flavor>::processPlaybackAudio(float* output, unsigned long frameCount) {
+    const auto callbackStart = std::chrono::steady_clock::now();
+
+    // Clear output buffer (all channels)
+    const int channels = outputChannels_;
+    std::memset(output, 0, frameCount * channels * sizeof(float));
 
     // When demolished, output pure silence — you can't hear anyone
-    if (isDemolished_) {
-        return;
+    if constexpr (Flavor::DEMOLITION_SILENCES) {
+        if (isDemolished_) return;
     }
 
-    // Process all pending incoming packets
-    while (auto pktOpt = incomingPackets_.tryPop()) {
-        const auto& pkt = *pktOpt;
-        auto& peer = getOrCreatePeerState(pkt.senderSteamId);
-
-        // Decode
-        if (!pkt.opusData.empty()) {
-            int decoded = peer.codec.decode(
-                pkt.opusData.data(), static_cast<int>(pkt.opusData.size()),
-                peer.decodeBuffer.data(), Protocol::FRAME_SIZE
-            );
-
-            if (decoded > 0) {
-                peer.lastPosition = pkt.senderPosition;
-                peer.lastPacketTime = std::chrono::steady_clock::now();
-                peer.plcFrames = 0;
-                peer.active = true;
-
-                // Spatialize into stereo
-                Protocol::Vec3 lPos = listenerPos_;
-                int lYaw = listenerYaw_.load();
-
-                // Use the CVar-configured spatial params from the main spatialAudio_ instance
-                peer.spatial.setDistanceParams(
-                    spatialAudio_.isEnabled() ? spatialAudio_.getInnerRadius() : 0.0f,
-                    spatialAudio_.isEnabled() ? spatialAudio_.getOuterRadius() : 100000.0f,
-                    spatialAudio_.getRolloff()
-                );
-                peer.spatial.setEnabled(spatialAudio_.isEnabled());
-                peer.spatial.setMasterVolume(outputVolume_.load());
-                peer.spatial.setReverbEnabled(spatialAudio_.isEnabled());
-                peer.spatial.setReverbMix(spatialAudio_.getReverbMix());
-
-                peer.spatial.process(
-                    peer.decodeBuffer.data(), decoded, peer.spatialBuffer.data(),
-                    lPos, lYaw, peer.lastPosition
-                );
-
-                // Insert into ring buffer jitter buffer
-                size_t stereoSamples = static_cast<size_t>(decoded) * 2;
-                peer.jitterBuffer.write(peer.spatialBuffer.data(), stereoSamples);
-            }
+    // The stream asks for one Opus frame per callback; peers play out in
+    // blocks of at most that size
+    frameCount = std::min<unsigned long>(frameCount, Protocol::FRAME_SIZE);
+    spatialDeadline_ = callbackStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(SPATIAL_DEADLINE * frameCount / Protocol::SAMPLE_RATE));
+
+    // Everything below mixes stereo; with a speaker layout that is the bed
+    // in mixBuffer_, interleaved with the speaker bus at the end
+    const bool multichannel = channels > Protocol::CHANNELS_STEREO;
+    if (multichannel) {
+        std::fill(mixBuffer_.begin(), mixBuffer_.end(), 0.0f);
+    }
+    float* stereo = multichannel ? mixBuffer_.data() : output;
+
+    // Object-mode peers render through a bus instead of SpatialAudio
+    const Renderer renderer = renderer_;
+    const bool objectMode = spatialEnabled_ &&
+        ((renderer == Renderer::Hrir && hrirLoaded_) || renderer == Renderer::Ambisonic ||
+         (renderer == Renderer::Speakers && multichannel));
+
+    // Play out every peer's jitter buffer as one mono block, rendered with this
+    // callback's listener pose: parametric peers through SpatialFanout (dry and
+    // reverb send mixed once its jobs joined), object-mode peers into their bus
+    size_t busFrames = std::min<size_t>(frameCount, MasterBus::MAX_BLOCK);
+    masterBus_.beginBlock();
+    float* sendMix = masterBus_.sendMix();
+    std::lock_guard<std::mutex> mixLock(mixMutex_);
+
+    // The map lock only covers copying the peer pointers (the lists have
+    // room for every peer; see getOrCreatePeerState()); what the decode
+    // worker publishes per packet is read without it
+    {
+        std::lock_guard<std::mutex> lock(peersMutex_);
+        if (spareMixPeers_.capacity() > mixPeers_.capacity()) {
+            mixPeers_.swap(spareMixPeers_);
+            lodRanking_.swap(spareLodRanking_);
         }
+        mixPeers_.clear();
+        for (auto& [steamId, peer] : peers_) mixPeers_.push_back(peer.get());
     }
 
-    // Mix all peers' jitter buffers into output
-    size_t stereoFrameCount = frameCount * 2;
-    std::lock_guard<std::mutex> lock(peersMutex_);
-
-    for (auto& [steamId, peer] : peers_) {
+    for (PeerAudioState* peer : mixPeers_) {
         if (!peer->active) continue;
+        if (peer->rendering.load(std::memory_order_acquire)) continue;   // Late job: plays on once it ended
+        peer->mixInfo = peer->packetInfo.load();
+        peer->setObjectMode(objectMode);
 
-        // Pre-buffering: wait until enough data has accumulated
-        // This absorbs network jitter and prevents initial stutters
+        // Pre-buffering: wait for the adaptive target depth plus the frame
+        // about to play. This absorbs network jitter and prevents initial stutters
         if (peer->prebuffering) {
-            if (peer->jitterBuffer.available() >= PREBUFFER_STEREO_SAMPLES) {
+            if (peer->bufferedFrames() >= peer->playoutTarget + Protocol::FRAME_SIZE) {
                 peer->prebuffering = false;  // Start playback
             } else {
                 continue;  // Keep accumulating
             }
         }
 
-        size_t available = peer->jitterBuffer.available();
-
-        if (available >= stereoFrameCount) {
-            // Enough data — mix directly (additive)
-            peer->jitterBuffer.readAdditive(output, stereoFrameCount);
-        } else if (available > 0) {
-            // Partial data — play what we have then apply PLC for remainder
-            peer->jitterBuffer.readAdditive(output, available);
-
-            // PLC for the gap
-            auto now = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - peer->lastPacketTime
-            ).count();
-
-            if (elapsed < 500 && peer->plcFrames < 10) {
-                int plcSamples = peer->codec.decodePLC(
-                    peer->decodeBuffer.data(), Protocol::FRAME_SIZE
-                );
-                if (plcSamples > 0) {
-                    peer->plcFrames++;
-                    Protocol::Vec3 lPos = listenerPos_;
-                    int lYaw = listenerYaw_.load();
-                    peer->spatial.process(
-                        peer->decodeBuffer.data(), plcSamples, peer->spatialBuffer.data(),
-                        lPos, lYaw, peer->lastPosition
-                    );
-                    // Buffer the PLC output for next callback
-                    size_t plcStereo = static_cast<size_t>(plcSamples) * 2;
-                    peer->jitterBuffer.write(peer->spatialBuffer.data(), plcStereo);
+        // Lost and late frames were concealed by the decode worker; a buffer
+        // that still runs dry plays silence, and a long-silent peer goes idle
+        size_t played = peer->readPlayout(0, frameCount);
+        if (played < frameCount) {
+            if (played == 0) {
+                auto now = std::chrono::steady_clock::now();
+                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    now - peer->mixInfo.time
+                ).count();
+                if (elapsed > 2000) {
+                    peer->active = false;
+                    peer->prebuffering = true;   // Reset pre-buffer for next activation
+                    peer->clearBuffers();
+                    continue;
                 }
             }
-        } else {
-            // No data — apply packet loss concealment
-            auto now = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - peer->lastPacketTime
-            ).count();
-
-            if (elapsed < 500 && peer->plcFrames < 10) {
-                int plcSamples = peer->codec.decodePLC(
-                    peer->decodeBuffer.data(), Protocol::FRAME_SIZE
-                );
-                if (plcSamples > 0) {
-                    peer->plcFrames++;
-                    Protocol::Vec3 lPos = listenerPos_;
-                    int lYaw = listenerYaw_.load();
-
-                    peer->spatial.process(
-                        peer->decodeBuffer.data(), plcSamples, peer->spatialBuffer.data(),
-                        lPos, lYaw, peer->lastPosition
-                    );
-
-                    size_t plcStereo = static_cast<size_t>(plcSamples) * 2;
-                    size_t plcToMix = std::min(plcStereo, stereoFrameCount);
-                    for (size_t i = 0; i < plcToMix; i++) {
-                        output[i] += peer->spatialBuffer[i];
-                    }
-                }
-            } else if (elapsed > 2000) {
-                peer->active = false;
-                peer->prebuffering = true;   // Reset pre-buffer for next activation
-                peer->jitterBuffer.clear();
+            std::fill(peer->playoutBuffer.begin() + played, peer->playoutBuffer.begin() + frameCount, 0.0f);
+        }
+
+        configurePeer(*peer);
+        if (peer->objectMode) {
+            // Silent blocks too, so the buses keep draining
+            renderObjectPeer(*peer, frameCount, busFrames, stereo);
+        } else if (played > 0) {
+            queueSpatialFrame(*peer, static_cast<int>(frameCount), stereo, sendMix, busFrames);
+        }
+    }
+    flushSpatialBatch(stereo, sendMix, busFrames);
+
+    // Measured-HRIR bus: two inverse FFTs for all object-mode peers together.
+    // Runs whenever loaded so the overlap-add tail plays out after a toggle.
+    if (hrirBus_ && frameCount == static_cast<unsigned long>(hrirBus_->blockSize())) {
+        int n = static_cast<int>(frameCount);
+        hrirBus_->render(hrirOutL_.data(), hrirOutR_.data(), n);
+        SpatialKernels::active().accumulateStereo(stereo, hrirOutL_.data(), hrirOutR_.data(), n);
+    }
+
+    // Ambisonic bus: rotation + binaural decode once for all object-mode peers
+    if (ambisonicBus_.isActive()) {
+        int n = static_cast<int>(std::min<size_t>(frameCount, hrirOutL_.size()));
+        ambisonicBus_.render(listenerRotation(), hrirOutL_.data(), hrirOutR_.data(), n);
+        SpatialKernels::active().accumulateStereo(stereo, hrirOutL_.data(), hrirOutR_.data(), n);
+    }
+
+    // Shared reverb bus: one reverb pass on the summed sends, for all peers
+    masterBus_.addReverb(stereo, static_cast<int>(busFrames));
+
+    // Speaker bus: panned peers on their channels, the stereo bed on the front pair
+    if (multichannel) {
+        speakerBus_.render(stereo, output, static_cast<int>(frameCount));
+    }
+
+    masterBus_.finish(output, static_cast<int>(frameCount), channels);
+    updateLodTiers();
+
+    // Callback time against its deadline (frameCount samples of playback),
+    // the LOD pass included
+    if (frameCount > 0) {
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - callbackStart).count();
+        float load = static_cast<float>(elapsed * Protocol::SAMPLE_RATE / frameCount);
+        float smoothed = callbackLoad_.load();
+        callbackLoad_ = smoothed + LOD_LOAD_SMOOTH * (load - smoothed);
+    }
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::updateLodTiers() {
+    // Adjust the slot budget: demote one peer at a time while over budget,
+    // hand slots back once there is clear headroom again
+    if (++lodCounter_ >= LOD_ADJUST_CALLBACKS) {
+        lodCounter_ = 0;
+        const float load = callbackLoad_;
+        if (load > LOD_HIGH_LOAD) {
+            if (fullSlots_ > 0) fullSlots_--;
+            else if (reducedSlots_ > 0) reducedSlots_--;
+        } else if (load < LOD_LOW_LOAD) {
+            if (reducedSlots_ < LOD_MAX_SLOTS) reducedSlots_++;
+            else if (fullSlots_ < LOD_MAX_SLOTS) fullSlots_++;
+        }
+    }
+
+    // Rank playing parametric peers by how loud they arrive (distance gain
+    // of their last rendered block × talker level); a peer still filling its
+    // pre-roll keeps its tier until it has played. lodRanking_ has room for
+    // every peer (see getOrCreatePeerState()), so this never allocates
+    lodRanking_.clear();
+    for (PeerAudioState* peer : mixPeers_) {
+        if (peer->tierHold < LOD_HOLD_CALLBACKS) peer->tierHold++;
+        if (!peer->active || peer->prebuffering || peer->objectMode) continue;
+        if (peer->rendering.load(std::memory_order_acquire)) continue;   // Keeps its tier while a late job renders it
+        lodRanking_.emplace_back(peer->distVolume, peer);
+    }
+    std::sort(lodRanking_.begin(), lodRanking_.end(), [](const auto& a, const auto& b) {
+        return a.first * a.second->mixInfo.level > b.first * b.second->mixInfo.level;
+    });
+
+    // Loudest first: full tier while slots last (and only if close enough to
+    // matter), then reduced; floored far talkers are always pan-only. A peer
+    // held in its tier takes that tier's slot
+    int full = 0, reduced = 0;
+    for (auto& [distVolume, peer] : lodRanking_) {
+        typename Spatial::Tier tier = Spatial::Tier::Minimal;
+        if (peer->tierHold < LOD_HOLD_CALLBACKS) {
+            tier = peer->spatial.getTier();
+        } else if (distVolume > LOD_MINIMAL_VOLUME) {
+            if (distVolume >= LOD_REDUCED_VOLUME && full < fullSlots_) {
+                tier = Spatial::Tier::Full;
+            } else if (reduced < reducedSlots_) {
+                tier = Spatial::Tier::Reduced;
             }
         }
+        if (tier == Spatial::Tier::Full) full++;
+        else if (tier == Spatial::Tier::Reduced) reduced++;
+
+        if (tier != peer->spatial.getTier()) {
+            peer->spatial.setTier(tier);
+            peer->tierHold = 0;
+        }
+    }
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::configurePeer(PeerAudioState& peer) {
+    // The CVar-configured settings: one distance table for every peer, built
+    // by publishDistanceModel() (mixMutex_ is held, so it stays while we mix)
+    const bool spatial = spatialEnabled_;
+    peer.spatial.shareDistanceModel(peerDistance_.get());
+    peer.spatial.setEnabled(spatial);
+    peer.spatial.setMasterVolume(outputVolume_.load());
+    peer.spatial.setReverbEnabled(spatial);
+    peer.spatial.setOcclusion(peer.mixInfo.openness);
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::queueSpatialFrame(PeerAudioState& peer, int samples,
+                                                 float* stereo, float* sendMix, size_t sendFrames) {
+    if (batchQueue_.size() == static_cast<size_t>(Fanout::MAX_SOURCES)) flushSpatialBatch(stereo, sendMix, sendFrames);
+
+    Protocol::Vec3 lPos = listenerPosition();
+    Protocol::Rot lRot = listenerRotation();
+    if (!spatialFanout_.submit(
+            peer.spatial, peer.playoutBuffer.data(), samples, peer.spatialBuffer.data(),
+            lPos, lRot, peer.mixInfo.position, peer.sendBuffer.data(), &peer.distVolume, &peer.rendering)) {
+        return;   // Both frame sets still held by late jobs: this block is dropped
     }
+    batchQueue_.emplace_back(&peer, samples);
+}
 
-    // Soft clamp output to prevent clipping
-    for (size_t i = 0; i < stereoFrameCount; i++) {
-        output[i] = std::tanh(output[i]);
+template <class Flavor>
+void BasicAudioEngine<Flavor>::flushSpatialBatch(float* stereo, float* sendMix, size_t sendFrames) {
+    spatialFanout_.render(spatialDeadline_);
+    const SpatialKernels::KernelTable& k = SpatialKernels::active();
+    for (auto& [peer, samples] : batchQueue_) {
+        if (peer->rendering.load(std::memory_order_acquire)) continue;   // Late: misses this mix
+        k.accumulate(stereo, peer->spatialBuffer.data(), samples * 2);
+        k.accumulate(sendMix, peer->sendBuffer.data(), static_cast<int>(std::min<size_t>(samples, sendFrames)));
     }
+    batchQueue_.clear();
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::renderObjectPeer(PeerAudioState& peer, size_t frames, size_t busFrames, float* output) {
+    const Renderer renderer = renderer_;
+    const bool ambisonic = renderer == Renderer::Ambisonic;
+    const bool speakers = renderer == Renderer::Speakers && outputChannels_ == speakerBus_.channels();
+    if (!ambisonic && !speakers && !hrirBus_) return;
+
+    Protocol::Vec3 lPos = listenerPosition();
+    Protocol::Rot lRot = listenerRotation();
+    const typename Spatial::Placement pl = peer.spatial.place(lPos, lRot, peer.mixInfo.position);
+
+    float gain = pl.distVolume * peer.spatial.getMasterVolume();
+    if (ambisonic) {
+        // World-frame encode (rotation is applied once on the bus); the bus decodes
+        // through the parametric head model, so it takes the parametric output boost
+        ambisonicBus_.addSource(peer.ambisonic, peer.playoutBuffer.data(), static_cast<int>(frames),
+                                gain * Spatial::OUTPUT_GAIN_BOOST, peer.mixInfo.position - lPos);
+    } else if (speakers) {
+        // The room's speakers place the voice: one gain pair, no head model,
+        // at the parametric output level
+        speakerBus_.addSource(peer.speakers, peer.playoutBuffer.data(), static_cast<int>(frames),
+                              gain * Spatial::OUTPUT_GAIN_BOOST, pl.azimuth);
+    } else {
+        // Silent blocks are still fed so older partitions keep draining into the bus
+        hrirBus_->addSource(peer.hrir, peer.playoutBuffer.data(), static_cast<int>(frames), gain,
+                            pl.azimuth, pl.elevation);
+    }
+
+    // Reverb send: same level as the parametric path (distance × send, no master).
+    // Rendered even at zero send so the early-reflection delay line keeps moving.
+    const SpatialKernels::KernelTable& k = SpatialKernels::active();
+    int n = static_cast<int>(std::min(busFrames, peer.playoutBuffer.size()));
+    k.scale(peer.sendBuffer.data(), peer.playoutBuffer.data(), pl.distVolume * pl.reverbSend, n);
+    k.accumulate(masterBus_.sendMix(), peer.sendBuffer.data(), n);
+    peer.spatial.renderEarlyReflections(peer.sendBuffer.data(), n, output, lPos, lRot, peer.mixInfo.position);
 }
 
 // ═════════════════════════════════════════════════════════════════════════════
 // Voice Activity Detection
 // ═════════════════════════════════════════════════════════════════════════════
 
-bool AudioEngine::detectVoiceActivity(const float* samples, int count) {
+template <class Flavor>
+bool BasicAudioEngine<Flavor>::detectVoiceActivity(const float* samples, int count) {
     float threshold = voiceThreshold_.load();
 
     // Calculate RMS energy
@@ -503,13 +686,15 @@ bool AudioEngine::detectVoiceActivity(const float* samples, int count) {
 // Remote Peer Management
 // ═════════════════════════════════════════════════════════════════════════════
 
-void AudioEngine::feedIncomingPacket(const Protocol::AudioPacket& packet) {
+template <class Flavor>
+void BasicAudioEngine<Flavor>::feedIncomingPacket(const Protocol::AudioPacket& packet) {
     incomingPackets_.push(packet);
 }
 
-AudioEngine::PeerAudioState& AudioEngine::getOrCreatePeerState(const std::string& steamId) {
-    std::lock_guard<std::mutex> lock(peersMutex_);
-
+template <class Flavor>
+typename BasicAudioEngine<Flavor>::PeerAudioState&
+BasicAudioEngine<Flavor>::getOrCreatePeerState(const std::string& steamId) {
+    // No other thread inserts, so the lookup needs no lock
     auto it = peers_.find(steamId);
     if (it != peers_.end()) {
         return *it->second;
@@ -518,13 +703,359 @@ AudioEngine::PeerAudioState& AudioEngine::getOrCreatePeerState(const std::string
     auto state = std::make_unique<PeerAudioState>();
     state->codec.initialize();
     state->lastPacketTime = std::chrono::steady_clock::now();
+    state->packetInfo.store({ {}, state->lastPacketTime });
+
+    // The callback's peer lists must hold one more: allocate larger ones
+    // here and hand them over with the insert (the callback swaps them in)
+    std::vector<PeerAudioState*> mixPeers;
+    std::vector<std::pair<float, PeerAudioState*>> lodRanking;
+    if (peers_.size() + 1 > peerListCapacity_) {
+        peerListCapacity_ = 2 * (peers_.size() + 1);
+        mixPeers.reserve(peerListCapacity_);
+        lodRanking.reserve(peerListCapacity_);
+    }
 
     auto& ref = *state;
-    peers_[steamId] = std::move(state);
-    return ref;
+    {
+        std::lock_guard<std::mutex> lock(peersMutex_);
+        if (hrirBus_) hrirBus_->allocate(ref.hrir);   // Under the lock loadHrirDataset() swaps the bus in
+        if (mixPeers.capacity() > 0) {
+            spareMixPeers_.swap(mixPeers);
+            spareLodRanking_.swap(lodRanking);
+        }
+        peers_[steamId] = std::move(state);
+        decodePeers_.push_back(&ref);
+    }
+    return ref;   // Lists the callback gave back (if any) are freed here
+}
+
+template <class Flavor>
+std::vector<typename BasicAudioEngine<Flavor>::JitterStats>
+BasicAudioEngine<Flavor>::getJitterStats() const {
+    constexpr float msPerSample = 1000.0f / Protocol::SAMPLE_RATE;
+
+    std::vector<JitterStats> stats;
+    std::lock_guard<std::mutex> lock(peersMutex_);
+    stats.reserve(peers_.size());
+    for (const auto& [steamId, peer] : peers_) {
+        stats.push_back({
+            steamId,
+            static_cast<float>(peer->bufferedFrames()) * msPerSample,
+            static_cast<float>(peer->playoutTarget.load()) * msPerSample,
+            peer->jitterMs.load(),
+            peer->accelerated.load(std::memory_order_relaxed),
+            peer->expanded.load(std::memory_order_relaxed),
+            peer->concealed.load(std::memory_order_relaxed),
+            peer->recovered.load(std::memory_order_relaxed),
+            peer->lost.load(std::memory_order_relaxed),
+            peer->reordered.load(std::memory_order_relaxed),
+            peer->late.load(std::memory_order_relaxed),
+        });
+    }
+    return stats;
+}
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Decode Worker
+// ═════════════════════════════════════════════════════════════════════════════
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::setWorkerThreads(int n) {
+    n = std::clamp(n, 0, WorkStealingPool::MAX_WORKERS);
+    if (n == pool_.workerCount()) return;
+    spatialFanout_.reserveWorkers(n);   // Batches for the new slots before their threads exist
+    pool_.setWorkerCount(n);
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::startDecodeWorker() {
+    if (decodeRunning_) return;
+    decodeRunning_ = true;
+    decodeThread_ = std::thread(&BasicAudioEngine::decodeWorkerLoop, this);
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::stopDecodeWorker() {
+    decodeRunning_ = false;
+    if (decodeThread_.joinable()) decodeThread_.join();
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::decodeWorkerLoop() {
+    while (decodeRunning_) {
+        // Wake on a packet, or every DECODE_POLL_MS to keep concealing a silent peer
+        if (auto pkt = incomingPackets_.popWait(std::chrono::milliseconds(DECODE_POLL_MS))) {
+            auto& peer = getOrCreatePeerState(pkt->senderSteamId);
+            peer.pendingPackets.push_back(std::move(*pkt));
+        }
+        decodePending();
+    }
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::decodePending() {
+    while (auto pkt = incomingPackets_.tryPop()) {
+        auto& peer = getOrCreatePeerState(pkt->senderSteamId);
+        peer.pendingPackets.push_back(std::move(*pkt));
+    }
+    pool_.run(static_cast<int>(decodePeers_.size()), &BasicAudioEngine::decodePeerJob, this);
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::decodePeerJob(void* ctx, int job, int /*slot*/) {
+    auto* self = static_cast<BasicAudioEngine*>(ctx);
+    PeerAudioState& peer = *self->decodePeers_[job];
+
+    // Arrival jitter is measured as packets come in, before any wait in reorder
+    const auto now = std::chrono::steady_clock::now();
+    const double arrivalMs = std::chrono::duration<double, std::milli>(now.time_since_epoch()).count();
+    for (auto& pkt : peer.pendingPackets) {
+        if (pkt.sequenced) {
+            peer.jitter.onArrival(arrivalMs, pkt.timestamp);
+            peer.reorder.push(pkt);
+        } else {
+            peer.jitter.onArrival(arrivalMs);
+            self->decodePacket(peer, pkt);   // Version 1 sender: arrival order
+        }
+    }
+    peer.pendingPackets.clear();
+    self->decodeInOrder(peer);
+
+    self->concealUnderrun(peer, now);
+    peer.lost.store(peer.reorder.lost(), std::memory_order_relaxed);
+    peer.reordered.store(peer.reorder.reordered(), std::memory_order_relaxed);
+    peer.late.store(peer.reorder.late(), std::memory_order_relaxed);
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::decodeInOrder(PeerAudioState& peer) {
+    while (peer.reorder.pop(peer.orderedPacket)) {
+        decodePacket(peer, peer.orderedPacket);
+    }
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::decodePacket(PeerAudioState& peer, const Protocol::AudioPacket& pkt) {
+    if (pkt.opusData.empty()) return;
+
+    int decoded = peer.codec.decode(
+        pkt.opusData.data(), static_cast<int>(pkt.opusData.size()),
+        peer.decodeBuffer.data(), Protocol::FRAME_SIZE
+    );
+    if (decoded <= 0) return;
+
+    float energy = 0.0f;
+    for (int i = 0; i < decoded; i++) energy += peer.decodeBuffer[i] * peer.decodeBuffer[i];
+
+    // Occlusion rays at position-update rate (once per packet)
+    const bool occlude = occlusionEnabled_ && spatialEnabled_;
+    const float openness = occlude ? ArenaOcclusion::openness(listenerPosition(), pkt.senderPosition) : 1.0f;
+
+    // Playout control: stretch the frame toward the target depth (not while
+    // the pre-roll builds up, nothing plays yet)
+    const auto now = std::chrono::steady_clock::now();
+    int samples = decoded;
+    switch (peer.jitter.onFrame(peer.bufferedFrames(), !peer.prebuffering)) {
+        case AdaptiveJitter::Action::Accelerate:
+            samples = TimeStretch::accelerate(peer.decodeBuffer.data(), decoded);
+            break;
+        case AdaptiveJitter::Action::Expand:
+            samples = TimeStretch::expand(peer.decodeBuffer.data(), decoded, static_cast<int>(peer.decodeBuffer.size()));
+            break;
+        case AdaptiveJitter::Action::None:
+            break;
+    }
+    if (samples != decoded) {
+        peer.jitter.onStretched(samples - decoded);
+        (samples < decoded ? peer.accelerated : peer.expanded).fetch_add(1, std::memory_order_relaxed);
+    }
+    peer.playoutTarget = peer.jitter.targetSamples();
+    peer.jitterMs = static_cast<float>(peer.jitter.jitterMs());
+
+    // Buffer the mono (it is spatialized when it plays), then publish
+    peer.plcFrames = 0;
+    peer.bufferFrame(samples);
+
+    peer.lastPacketTime = now;
+    peer.level += LOD_LEVEL_SMOOTH * (std::sqrt(energy / decoded) - peer.level);
+    peer.packetInfo.store({ pkt.senderPosition, now, openness, peer.level });
+    peer.active = true;
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::concealUnderrun(PeerAudioState& peer, std::chrono::steady_clock::time_point now) {
+    constexpr size_t frame = static_cast<size_t>(Protocol::FRAME_SIZE);
+
+    // Sequenced peer with a gap before the packets held in reorder: the
+    // missing packet gets one frame (or keeps the PLC already played while
+    // it was only late), then playback goes on with the packets after it.
+    // The frame comes from the in-band FEC of the packet right after it when
+    // that is here, as the encoder only encodes the frames it sends; PLC
+    // otherwise
+    while (peer.reorder.missing()) {
+        if (peer.plcFrames > 0) {
+            peer.plcFrames--;
+        } else {
+            if (peer.bufferedFrames() >= frame) return;   // It may still come
+            int samples = 0;
+            const Protocol::AudioPacket* next = peer.reorder.following();
+            if (next && !next->opusData.empty()) {
+                samples = peer.codec.decodeFEC(next->opusData.data(), static_cast<int>(next->opusData.size()),
+                                               peer.decodeBuffer.data(), Protocol::FRAME_SIZE);
+            }
+            if (samples > 0) {
+                peer.recovered.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                samples = peer.codec.decodePLC(peer.decodeBuffer.data(), Protocol::FRAME_SIZE);
+                if (samples <= 0) return;
+                peer.concealed.fetch_add(1, std::memory_order_relaxed);
+            }
+            peer.bufferFrame(samples);
+        }
+        peer.reorder.skip();
+        decodeInOrder(peer);
+    }
+
+    // No later packet here: the next one is late, or the talker paused
+    if (peer.bufferedFrames() >= frame) return;
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now - peer.lastPacketTime
+    ).count();
+    if (elapsed < Protocol::FRAME_DURATION_MS || elapsed >= 500 || peer.plcFrames >= 10) return;
+
+    int plcSamples = peer.codec.decodePLC(
+        peer.decodeBuffer.data(), Protocol::FRAME_SIZE
+    );
+    if (plcSamples > 0) {
+        peer.plcFrames++;
+        peer.concealed.fetch_add(1, std::memory_order_relaxed);
+        peer.bufferFrame(plcSamples);
+    }
+}
+
+template <class Flavor>
+bool BasicAudioEngine<Flavor>::loadHrirDataset(const std::string& path) {
+    auto renderer = std::make_unique<HrirRenderer>();
+    if (!renderer->load(path, Protocol::FRAME_SIZE, Protocol::SAMPLE_RATE)) {
+        setError("HRIR load failed: " + renderer->lastError());
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> mixLock(mixMutex_);
+        std::lock_guard<std::mutex> lock(peersMutex_);
+        hrirBus_.swap(renderer);
+        for (auto& [steamId, peer] : peers_) hrirBus_->allocate(peer->hrir);   // Sized here, not in the callback
+    }
+    hrirLoaded_ = true;
+    return true;   // Previous renderer (if any) is freed here, off the audio lock
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::setRenderer(Renderer renderer) {
+    const Renderer previous = renderer_.exchange(renderer);
+    if (previous == renderer) return;
+
+    // The speaker layout needs its own channel count on the playback stream
+    if (streaming_ && (previous == Renderer::Speakers) != (renderer == Renderer::Speakers)) {
+        stopStreams();
+        startStreams();
+    }
+
+    // Peers that stay in object mode switch bus: start their state clean
+    std::lock_guard<std::mutex> mixLock(mixMutex_);
+    std::lock_guard<std::mutex> lock(peersMutex_);
+    for (auto& [steamId, peer] : peers_) {
+        peer->hrir.reset();
+        peer->ambisonic.reset();
+        peer->speakers.reset();
+    }
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::setSpeakerLayout(VbapRenderer::Layout layout) {
+    if (layout == speakerBus_.getLayout()) return;
+
+    const bool restart = streaming_ && renderer_ == Renderer::Speakers;
+    if (restart) stopStreams();
+
+    speakerBus_.setLayout(layout);
+    {
+        std::lock_guard<std::mutex> mixLock(mixMutex_);
+        std::lock_guard<std::mutex> lock(peersMutex_);
+        for (auto& [steamId, peer] : peers_) peer->speakers.reset();
+    }
+
+    if (restart) startStreams();
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::setSpatialEnabled(bool enabled) {
+    if (spatialEnabled_.exchange(enabled) == enabled) return;
+    publishDistanceModel();
 }
 
-void AudioEngine::setListenerState(const Protocol::Vec3& pos, int yaw) {
-    listenerPos_ = pos;
-    listenerYaw_ = yaw;
+template <class Flavor>
+void BasicAudioEngine<Flavor>::setDistanceModel(const DistanceModel::Settings& settings) {
+    DistanceModel::Settings clamped = settings;
+    clamped.rolloff = std::max(settings.rolloff, 0.1f);
+    if (clamped == distanceSettings_) return;
+    distanceSettings_ = clamped;
+    publishDistanceModel();
 }
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::publishDistanceModel() {
+    // With 3D audio off every peer is in range and at full volume
+    DistanceModel::Settings settings = distanceSettings_;
+    if (!spatialEnabled_) {
+        settings.inner = 0.0f;
+        settings.outer = 100000.0f;
+    }
+    std::unique_ptr<const DistanceModel> previous = std::make_unique<DistanceModel>(settings);
+    {
+        std::lock_guard<std::mutex> lock(mixMutex_);
+        peerDistance_.swap(previous);
+    }
+    waitForLateRenders();
+    // Previous table (if any) is freed here, off the audio lock
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::waitForLateRenders() {
+    while (!spatialFanout_.idle()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+template <class Flavor>
+void BasicAudioEngine<Flavor>::setListenerState(const Protocol::Vec3& pos, const Protocol::Rot& rot) {
+    listenerX_ = pos.x;
+    listenerY_ = pos.y;
+    listenerZ_ = pos.z;
+    listenerYaw_ = rot.yaw;
+    listenerPitch_ = rot.pitch;
+    listenerRoll_ = rot.roll;
+}
+
+template <class Flavor>
+Protocol::Vec3 BasicAudioEngine<Flavor>::listenerPosition() const {
+    return { listenerX_.load(), listenerY_.load(), listenerZ_.load() };
+}
+
+template <class Flavor>
+Protocol::Rot BasicAudioEngine<Flavor>::listenerRotation() const {
+    Protocol::Rot rot;
+    rot.pitch = listenerPitch_.load();
+    rot.yaw   = listenerYaw_.load();
+    rot.roll  = listenerRoll_.load();
+    return rot;
+}
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Build flavors (see BuildFlavor.h)
+// ═════════════════════════════════════════════════════════════════════════════
+
+template class BasicAudioEngine<BuildFlavor::Plugin>;
+template class BasicAudioEngine<BuildFlavor::Upload>;
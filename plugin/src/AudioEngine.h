@@ -1,7 +1,18 @@
 #pragma once
 #include "Protocol.h"
+#include "BuildFlavor.h"
 #include "VoiceCodec.h"
+#include "AdaptiveJitter.h"
+#include "PacketReorder.h"
+#include "TimeStretch.h"
 #include "SpatialAudio.h"
+#include "SpatialBatch.h"
+#include "SpatialFanout.h"
+#include "WorkStealingPool.h"
+#include "MasterBus.h"
+#include "HrirRenderer.h"
+#include "AmbisonicRenderer.h"
+#include "VbapRenderer.h"
 #include "ThreadSafeQueue.h"
 #include <portaudio.h>
 #include <string>
@@ -9,6 +20,8 @@
 #include <functional>
 #include <atomic>
 #include <mutex>
+#include <memory>
+#include <thread>
 #include <unordered_map>
 
 /**
@@ -23,12 +36,50 @@
  *
  * Threading model:
  *   - PortAudio runs its own threads for capture/playback callbacks
- *   - Encoded packets are pushed to an outgoing queue (for NetworkManager)
+ *   - Encoded packets are pushed to an outgoing queue (for NetworkManager),
+ *     stamped with a sequence number and the capture sample clock
  *   - Incoming packets are pushed by NetworkManager into the incoming queue
- *   - Playback callback mixes all incoming audio with 3D spatialization
+ *   - A decode worker (started with the streams) drains that queue, puts
+ *     each sequenced peer's packets back in order (PacketReorder), Opus
+ *     decodes into the peers' jitter buffers and conceals lost frames
+ *     (PLC) before the callback would run dry: once per missing sequence
+ *     number, or while the next packet is late; each peer's AdaptiveJitter
+ *     sizes its buffer from the packets' arrival jitter and time-stretches
+ *     decoded frames (TimeStretch) to converge on that depth; it hands
+ *     each packet's metadata to the callback without a lock
+ *   - Both fan their per-peer jobs out over one WorkStealingPool (decode
+ *     per peer on the worker side, SpatialBatch jobs in the callback) and
+ *     join before going on, so a period's cost stays flat as peers join;
+ *     the callback waits on a worker only until SPATIAL_DEADLINE
+ *   - Playback callback only mixes: a bounded, allocation-free pass over
+ *     the peers' jitter buffers with 3D spatialization, ending in
+ *     MasterBus: one shared reverb on the summed per-peer sends, then the
+ *     output limiter
+ *
+ * Rendering paths (every peer's jitter buffer holds decoded mono; each
+ * path renders it as it plays, with the listener pose of that callback):
+ *   - Parametric (default): SpatialAudio renders stereo, the peers of a
+ *     callback in SpatialBatch jobs across the pool (SpatialFanout)
+ *   - Measured HRIR (optional): peers are convolved into one
+ *     frequency-domain bus (HrirRenderer)
+ *   - Ambisonic (optional): each peer is encoded into one third-order
+ *     world-frame bus; one rotation to the listener and one binaural
+ *     decode per callback (AmbisonicRenderer)
+ *   - Speakers (optional): the playback stream opens with one channel per
+ *     speaker of the layout and peers are amplitude-panned at mix time
+ *     (VbapRenderer); everything else is a stereo bed on the front pair
+ *
+ * Templated on a BuildFlavor policy, which it passes on to SpatialAudio and
+ * SpatialBatch/SpatialFanout and which decides whether demolition silences the player;
+ * AudioEngine is the flavor of this build.
  */
-class AudioEngine {
+template <class Flavor>
+class BasicAudioEngine {
 public:
+    using Spatial = BasicSpatialAudio<Flavor>;
+    using Batch   = BasicSpatialBatch<Flavor>;
+    using Fanout  = BasicSpatialFanout<Flavor>;
+
     /** Audio device info for UI display. */
     struct DeviceInfo {
         int    id;
@@ -42,11 +93,11 @@ public:
     /** Callback for encoded audio packets ready to send. */
     using PacketReadyCallback = std::function<void(const std::vector<uint8_t>& packet)>;
 
-    AudioEngine();
-    ~AudioEngine();
+    BasicAudioEngine();
+    ~BasicAudioEngine();
 
-    AudioEngine(const AudioEngine&) = delete;
-    AudioEngine& operator=(const AudioEngine&) = delete;
+    BasicAudioEngine(const BasicAudioEngine&) = delete;
+    BasicAudioEngine& operator=(const BasicAudioEngine&) = delete;
 
     // ── Lifecycle ────────────────────────────────────────────────────────
     bool initialize();
@@ -88,6 +139,7 @@ public:
     void setMicMuted(bool muted) { micMuted_ = muted; }
     bool isMicMuted() const { return micMuted_; }
 
+    /** Silences capture and playback while set; ignored unless Flavor::DEMOLITION_SILENCES. */
     void setDemolished(bool demo) { isDemolished_ = demo; }
     bool isDemolished() const { return isDemolished_; }
 
@@ -100,15 +152,88 @@ public:
     void feedIncomingPacket(const Protocol::AudioPacket& packet);
 
     // ── Spatial state (updated from game thread) ─────────────────────────
-    /** Update the local player's position/rotation for 3D audio. */
-    void setListenerState(const Protocol::Vec3& pos, int yaw);
-
-    /** Access spatial audio processor for settings. */
-    SpatialAudio& getSpatialAudio() { return spatialAudio_; }
+    /** Update the local player's position/rotation (yaw, pitch, roll) for 3D audio. */
+    void setListenerState(const Protocol::Vec3& pos, const Protocol::Rot& rot);
+
+    /** 3D audio on/off (off: peers play centered, at full volume out to 1 km). */
+    void setSpatialEnabled(bool enabled);
+    bool isSpatialEnabled() const { return spatialEnabled_; }
+
+    /**
+     * Distance curve of every peer. Builds the shared table here and hands
+     * it to the playback callback; not for the audio thread.
+     */
+    void setDistanceModel(const DistanceModel::Settings& settings);
+    const DistanceModel::Settings& getDistanceModel() const { return distanceSettings_; }
+
+    /**
+     * Pool threads that decode and spatialize peers in parallel (0 = the
+     * decode worker and the playback callback do it all themselves). Not
+     * for the audio thread.
+     */
+    void setWorkerThreads(int n);
+    int getWorkerThreads() const { return pool_.workerCount(); }
+
+    /** Arena occlusion (ArenaOcclusion rays per peer packet). Thread-safe. */
+    void setOcclusionEnabled(bool on) { occlusionEnabled_ = on; }
+    bool isOcclusionEnabled() const { return occlusionEnabled_; }
+
+    // ── Renderer selection ───────────────────────────────────────────────
+    /**
+     * How peers are spatialized:
+     *   Parametric — SpatialAudio per peer (binaural model, Doppler, LOD tiers)
+     *   Hrir       — measured-HRIR convolution bus (falls back to Parametric until loaded)
+     *   Ambisonic  — third-order Ambisonic bus, one rotation + binaural decode per callback
+     *   Speakers   — VBAP onto a multichannel speaker layout (falls back to Parametric
+     *                when the output device has too few channels)
+     * Hrir, Ambisonic and Speakers render all peers through one shared bus.
+     */
+    enum class Renderer { Parametric, Hrir, Ambisonic, Speakers };
+
+    /**
+     * Select the renderer. Takes effect on the next playback callback. Switching
+     * to or from Speakers reopens the streams (not for the audio thread).
+     */
+    void setRenderer(Renderer renderer);
+    Renderer getRenderer() const { return renderer_; }
+
+    // ── Speaker output ───────────────────────────────────────────────────
+    /** Speaker layout for the Speakers renderer; reopens the streams if it is in use. */
+    void setSpeakerLayout(VbapRenderer::Layout layout);
+    VbapRenderer::Layout getSpeakerLayout() const { return speakerBus_.getLayout(); }
+
+    /** Channels of the open playback stream (2 unless the Speakers renderer got its layout). */
+    int getOutputChannels() const { return outputChannels_; }
+
+    // ── Measured-HRIR rendering ──────────────────────────────────────────
+    /** Load a measured HRIR set (.lhrir, see HrirDataset). Slow — not for the audio thread. */
+    bool loadHrirDataset(const std::string& path);
+
+    bool isHrirLoaded() const { return hrirLoaded_; }
 
     // ── Status ───────────────────────────────────────────────────────────
     bool   isSpeaking() const { return isSpeaking_; }
     float  getCurrentInputLevel() const { return currentInputLevel_; }
+    /** Smoothed playback callback time as a fraction of its deadline (1 = overrun). */
+    float  getCallbackLoad() const { return callbackLoad_; }
+
+    /** One peer's jitter buffer and its playout adjustments so far. */
+    struct JitterStats {
+        std::string steamId;
+        float depthMs;          // Buffered right now
+        float targetMs;         // Depth the playout control steers to
+        float jitterMs;         // Arrival delay quantile (AdaptiveJitter)
+        uint32_t accelerated;   // Frames shortened by time-stretch
+        uint32_t expanded;      // Frames lengthened by time-stretch
+        uint32_t concealed;     // Frames of PLC for late or lost packets
+        uint32_t recovered;     // Lost frames rebuilt from the next packet's in-band FEC
+        uint32_t lost;          // Sequence numbers that never arrived in time (PacketReorder)
+        uint32_t reordered;     // Packets that arrived after a later one, still in time
+        uint32_t late;          // Packets dropped because their slot had been concealed
+    };
+
+    /** Snapshot of every peer's jitter buffer. Thread-safe; not for the audio thread. */
+    std::vector<JitterStats> getJitterStats() const;
     std::string getLastError() const { std::lock_guard<std::mutex> l(errorMutex_); return lastError_; }
 
     /** Set the local player position for outgoing packets. */
@@ -136,81 +261,299 @@ private:
 
     // ── Per-peer decoder state ───────────────────────────────────────────
 
-    /** Ring buffer for jitter-free audio playback. O(1) read/write. */
+    /**
+     * Ring buffer for jitter-free audio playback. O(1) read/write, lock-free
+     * between one writer (decode worker) and one reader (playback callback).
+     */
     struct RingBuffer {
         std::vector<float> data;
-        size_t readPos  = 0;
-        size_t writePos = 0;
-        size_t count    = 0;  // Samples currently buffered
+        std::atomic<size_t> readPos{0};    // Samples ever read (reader only)
+        std::atomic<size_t> writePos{0};   // Samples ever written (writer only)
         size_t capacity = 0;
 
+        /** Before the buffer is shared. */
         void init(size_t cap) {
             capacity = cap;
             data.resize(cap, 0.0f);
-            readPos = writePos = count = 0;
+            readPos = writePos = 0;
         }
 
-        size_t available() const { return count; }
-        size_t freeSpace() const { return capacity - count; }
+        size_t available() const { return writePos.load(std::memory_order_acquire) - readPos.load(std::memory_order_acquire); }
+        size_t freeSpace() const { return capacity - available(); }
 
+        /** Writer side. */
         void write(const float* src, size_t n) {
             n = std::min(n, freeSpace());
+            const size_t w = writePos.load(std::memory_order_relaxed);
             for (size_t i = 0; i < n; i++) {
-                data[writePos] = src[i];
-                writePos = (writePos + 1) % capacity;
+                data[(w + i) % capacity] = src[i];
             }
-            count += n;
+            writePos.store(w + n, std::memory_order_release);
         }
 
+        /** Reader side. */
         void read(float* dst, size_t n) {
-            n = std::min(n, count);
+            n = std::min(n, available());
+            const size_t r = readPos.load(std::memory_order_relaxed);
             for (size_t i = 0; i < n; i++) {
-                dst[i] = data[readPos];
-                readPos = (readPos + 1) % capacity;
+                dst[i] = data[(r + i) % capacity];
             }
-            count -= n;
+            readPos.store(r + n, std::memory_order_release);
         }
 
-        void readAdditive(float* dst, size_t n) {
-            n = std::min(n, count);
-            for (size_t i = 0; i < n; i++) {
-                dst[i] += data[readPos];
-                readPos = (readPos + 1) % capacity;
+        /** Reader side: drop everything written so far. */
+        void clear() { readPos.store(writePos.load(std::memory_order_acquire), std::memory_order_release); }
+    };
+
+    /** What the playback callback needs of a peer's last decoded packet. */
+    struct PacketInfo {
+        Protocol::Vec3 position;
+        std::chrono::steady_clock::time_point time;
+        float openness = 1.0f;   // Occlusion toward the listener
+        float level = 0.0f;      // Smoothed RMS of decoded frames (LOD priority)
+    };
+
+    /**
+     * PacketInfo passed from one writer (the peer's decode job) to the
+     * playback callback without a lock: a sequence lock, odd while a store
+     * is under way. load() retries until it read one store whole, which
+     * takes a few loads as the writer holds it for a handful of stores.
+     */
+    class PublishedPacketInfo {
+    public:
+        /** Writer side. */
+        void store(const PacketInfo& info) {
+            const uint32_t seq = seq_.load(std::memory_order_relaxed);
+            seq_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            x_.store(info.position.x, std::memory_order_relaxed);
+            y_.store(info.position.y, std::memory_order_relaxed);
+            z_.store(info.position.z, std::memory_order_relaxed);
+            time_.store(info.time.time_since_epoch().count(), std::memory_order_relaxed);
+            openness_.store(info.openness, std::memory_order_relaxed);
+            level_.store(info.level, std::memory_order_relaxed);
+            seq_.store(seq + 2, std::memory_order_release);
+        }
+
+        /** Reader side. */
+        PacketInfo load() const {
+            PacketInfo info;
+            for (;;) {
+                const uint32_t seq = seq_.load(std::memory_order_acquire);
+                info.position = { x_.load(std::memory_order_relaxed), y_.load(std::memory_order_relaxed),
+                                  z_.load(std::memory_order_relaxed) };
+                info.time = std::chrono::steady_clock::time_point(
+                    std::chrono::steady_clock::duration(time_.load(std::memory_order_relaxed)));
+                info.openness = openness_.load(std::memory_order_relaxed);
+                info.level = level_.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if ((seq & 1) == 0 && seq_.load(std::memory_order_relaxed) == seq) return info;
             }
-            count -= n;
         }
 
-        void clear() { readPos = writePos = count = 0; }
+    private:
+        std::atomic<uint32_t> seq_{0};
+        std::atomic<float> x_{0.0f}, y_{0.0f}, z_{0.0f};
+        std::atomic<std::chrono::steady_clock::rep> time_{0};
+        std::atomic<float> openness_{1.0f};
+        std::atomic<float> level_{0.0f};
     };
 
-    /** Pre-buffer threshold: accumulate this many stereo frames before
-     *  starting playback to absorb network jitter (60ms = 3 frames). */
-    static constexpr int PREBUFFER_FRAMES = 3;
-    static constexpr size_t PREBUFFER_STEREO_SAMPLES =
-        PREBUFFER_FRAMES * Protocol::FRAME_SIZE * Protocol::CHANNELS_STEREO;
-
+    /**
+     * Per-peer state. The decode worker owns codec, decodeBuffer, jitter,
+     * reorder, plcFrames, lastPacketTime and level and writes jitterBuffer;
+     * it publishes each packet's metadata through packetInfo and sets
+     * active, and publishes the playout target and stats as atomics. No
+     * lock is taken on either side. Everything else belongs to the playback
+     * callback.
+     */
     struct PeerAudioState {
         VoiceCodec codec;
         std::vector<float> decodeBuffer;       // Decoded PCM (mono)
-        std::vector<float> spatialBuffer;      // Spatialized PCM (stereo)
-        RingBuffer jitterBuffer;               // Ring buffer for smooth playback
-        SpatialAudio spatial;                  // Per-peer spatial processor
-        Protocol::Vec3 lastPosition;
-        std::chrono::steady_clock::time_point lastPacketTime;
-        int plcFrames = 0;                     // Consecutive PLC frames
-        bool active = false;
-        bool prebuffering = true;              // Waiting to accumulate pre-buffer
+        std::vector<float> playoutBuffer;      // Mono block read from the jitter buffer at mix time
+        std::vector<float> spatialBuffer;      // Spatialized playout block (stereo)
+        std::vector<float> sendBuffer;         // Reverb send of the playout block (mono)
+        RingBuffer jitterBuffer;               // Decoded mono, spatialized as it plays
+        AdaptiveJitter jitter;                 // Target depth and time-stretch decisions
+        Spatial spatial;                       // Per-peer spatial processor
+        HrirRenderer::Source hrir;             // Per-peer HRIR convolution state
+        AmbisonicRenderer::Source ambisonic;   // Per-peer Ambisonic encoder state
+        VbapRenderer::Source speakers;         // Per-peer speaker panning state
+        std::chrono::steady_clock::time_point lastPacketTime;   // Decode worker
+        float level = 0.0f;                    // Decode worker: smoothed RMS of decoded frames
+        PublishedPacketInfo packetInfo;        // Last decoded packet, for the callback
+        PacketInfo mixInfo;                    // Callback: packetInfo as of this callback
+        std::vector<Protocol::AudioPacket> pendingPackets;   // Decode worker: this pass's packets, in order
+        PacketReorder reorder;                 // Sequenced packets back in order, missing ones found
+        Protocol::AudioPacket orderedPacket;   // Decode worker: the one reorder just released
+        int plcFrames = 0;                     // PLC frames for no known gap since the last decoded packet
+        std::atomic<bool> active{false};       // Set by the decode worker, cleared by the callback when idle
+        std::atomic<bool> rendering{false};    // Block queued in spatialFanout_, until its job wrote it
+        std::atomic<bool> prebuffering{true};  // Waiting for the target depth + one frame
+        std::atomic<size_t> playoutTarget{0};  // jitter.targetSamples(), for the callback
+        std::atomic<float> jitterMs{0.0f};     // jitter.jitterMs(), for stats
+        std::atomic<uint32_t> accelerated{0};
+        std::atomic<uint32_t> expanded{0};
+        std::atomic<uint32_t> concealed{0};
+        std::atomic<uint32_t> recovered{0};
+        std::atomic<uint32_t> lost{0};         // reorder counts, for stats
+        std::atomic<uint32_t> reordered{0};
+        std::atomic<uint32_t> late{0};
+        bool objectMode = false;               // Rendered by an object bus instead of SpatialAudio
+        float distVolume = 0.0f;               // Distance volume of the last parametric block (LOD priority)
+        int tierHold = LOD_HOLD_CALLBACKS;     // Callbacks since the last LOD tier change (saturates)
 
         PeerAudioState() {
-            decodeBuffer.resize(Protocol::FRAME_SIZE * 2);
-            spatialBuffer.resize(Protocol::FRAME_SIZE * 2 * 2); // Stereo
-            // Ring buffer holds up to 500ms of stereo audio (generous)
-            jitterBuffer.init(Protocol::SAMPLE_RATE * Protocol::CHANNELS_STEREO / 2);
+            decodeBuffer.resize(TimeStretch::MAX_FRAME);   // A decoded frame plus its expansion
+            playoutBuffer.resize(Protocol::FRAME_SIZE);
+            spatialBuffer.resize(Protocol::FRAME_SIZE * 2); // Stereo
+            sendBuffer.resize(Protocol::FRAME_SIZE);
+            // Ring buffer holds up to 500ms of mono audio (generous)
+            jitterBuffer.init(Protocol::SAMPLE_RATE / 2);
+            playoutTarget = jitter.targetSamples();
+        }
+
+        /** Switch between SpatialAudio and the object buses; buffered audio plays on either. */
+        void setObjectMode(bool on) {
+            if (on == objectMode) return;
+            objectMode = on;
+            resetRenderers();
+        }
+
+        void resetRenderers() {
+            hrir.reset();
+            ambisonic.reset();
+            speakers.reset();
+        }
+
+        void clearBuffers() {
+            jitterBuffer.clear();
+            resetRenderers();
+        }
+
+        /** Frames ready for playback. */
+        size_t bufferedFrames() const { return jitterBuffer.available(); }
+
+        /** Buffer one decoded (or concealed) frame for playback. Decode worker. */
+        void bufferFrame(int samples) {
+            jitterBuffer.write(decodeBuffer.data(), static_cast<size_t>(samples));
+        }
+
+        /** Read up to frames buffered samples into playoutBuffer at offset; returns the count read. Playback callback. */
+        size_t readPlayout(size_t offset, size_t frames) {
+            frames = std::min({frames, bufferedFrames(), playoutBuffer.size() - offset});
+            jitterBuffer.read(playoutBuffer.data() + offset, frames);
+            return frames;
         }
     };
 
+    /** Decode worker only: it is the one thread that adds peers. */
     PeerAudioState& getOrCreatePeerState(const std::string& steamId);
 
+    // ── Decode worker ────────────────────────────────────────────────────
+
+    /** Worker wake-up interval without packets (underrun checks for PLC) */
+    static constexpr int DECODE_POLL_MS = 5;
+
+    void startDecodeWorker();
+    void stopDecodeWorker();
+    void decodeWorkerLoop();
+
+    /**
+     * One worker pass: sort the queued packets by peer, then one pool job
+     * per peer decodes them and conceals the peer if it is about to run
+     * dry. Decode worker thread (or any one thread while the worker is
+     * stopped).
+     */
+    void decodePending();
+
+    /**
+     * Pool job: record the peer's pending packets' arrival, decodePacket()
+     * them (sequenced ones in order, through reorder), then concealUnderrun().
+     */
+    static void decodePeerJob(void* ctx, int job, int slot);
+
+    /** decodePacket() every packet reorder releases in order. */
+    void decodeInOrder(PeerAudioState& peer);
+
+    /**
+     * Decode one packet into its peer's jitter buffer (time-stretched as
+     * its AdaptiveJitter decides) and publish its metadata.
+     */
+    void decodePacket(PeerAudioState& peer, const Protocol::AudioPacket& pkt);
+
+    /**
+     * Before the peer's buffer is under one frame: a missing sequence number
+     * with later packets here is filled once (counting PLC already played
+     * for it) — from the FEC data of the packet right after it if that is
+     * here, else by PLC — and playback goes on after it; with none here,
+     * PLC for a late next packet.
+     */
+    void concealUnderrun(PeerAudioState& peer, std::chrono::steady_clock::time_point now);
+
+    /** Per-callback SpatialAudio settings (shared CVars, occlusion) of a playing peer. */
+    void configurePeer(PeerAudioState& peer);
+
+    /**
+     * Build the distance table peers read (distanceSettings_, or the flat
+     * model while 3D audio is off) and swap it in under mixMutex_. Not
+     * for the audio thread.
+     */
+    void publishDistanceModel();
+
+    /**
+     * Wait until no late SpatialFanout job runs (one may still read peers
+     * and the distance table they share). Not for the audio thread.
+     */
+    void waitForLateRenders();
+
+    /**
+     * Share of the period after which the callback stops waiting for
+     * SpatialFanout jobs still running on workers: their peers miss this
+     * callback's mix and sit out until the job ends.
+     */
+    static constexpr float SPATIAL_DEADLINE = 0.5f;
+
+    /**
+     * Queue a peer's playout block into spatialFanout_; it is mixed into
+     * stereo/sendMix by the next flushSpatialBatch() (same arguments).
+     * Dropped if the fanout has no frame set free of late jobs.
+     */
+    void queueSpatialFrame(PeerAudioState& peer, int samples, float* stereo, float* sendMix, size_t sendFrames);
+
+    /**
+     * Render the queued playout blocks (waiting until spatialDeadline_) and
+     * add the ones done to the stereo mix and the reverb send.
+     */
+    void flushSpatialBatch(float* stereo, float* sendMix, size_t sendFrames);
+
+    /** Spatialize a peer's playout block into the HRIR, Ambisonic or speaker bus, reverb send and early reflections. */
+    void renderObjectPeer(PeerAudioState& peer, size_t frames, size_t busFrames, float* output);
+
+    /** Snapshot of the listener position written by setListenerState() (any thread). */
+    Protocol::Vec3 listenerPosition() const;
+
+    /** Snapshot of the listener rotator written by setListenerState(). */
+    Protocol::Rot listenerRotation() const;
+
+    // ── Level of detail ──────────────────────────────────────────────────
+
+    /** Load above which tiers are demoted / below which they are promoted again */
+    static constexpr float LOD_HIGH_LOAD = 0.5f;
+    static constexpr float LOD_LOW_LOAD  = 0.25f;
+    static constexpr float LOD_LOAD_SMOOTH = 0.1f;        // Per-callback EMA coefficient
+    static constexpr int   LOD_ADJUST_CALLBACKS = 10;     // Budget re-evaluated every ~200ms
+    static constexpr int   LOD_HOLD_CALLBACKS = 25;       // Min time in a tier (~500ms)
+    static constexpr int   LOD_MAX_SLOTS = 64;            // "Unlimited" slot count
+    /** Distance volume below which a peer never gets the full tier */
+    static constexpr float LOD_REDUCED_VOLUME = 0.3f;
+    /** Distance volume at or below which a peer is pan-only (covers the 0.04 floor) */
+    static constexpr float LOD_MINIMAL_VOLUME = 0.05f;
+    static constexpr float LOD_LEVEL_SMOOTH = 0.2f;       // Per-frame RMS EMA coefficient
+
+    /** Re-rank mixPeers_ and assign SpatialAudio tiers. Audio thread, mixMutex_ held. */
+    void updateLodTiers();
+
     // ── State ────────────────────────────────────────────────────────────
     bool initialized_ = false;
     bool streaming_   = false;
@@ -219,11 +562,14 @@ private:
     PaStream* playbackStream_ = nullptr;
     int inputDeviceId_  = -1;   // -1 = default
     int outputDeviceId_ = -1;
+    int outputChannels_ = Protocol::CHANNELS_STEREO;   // Of playbackStream_, set before it starts
 
     // Encoding
     VoiceCodec localCodec_;
     std::vector<float> captureAccumBuffer_;    // Accumulate samples to frame size
     int captureAccumPos_ = 0;
+    uint32_t captureTimestamp_ = 0;            // Sample clock of captureAccumBuffer_[0]; random start
+    uint16_t sendSequence_ = 0;                // Of the next packet sent; random start
 
     // Voice settings
     std::atomic<bool>  pushToTalk_{false};
@@ -235,32 +581,94 @@ private:
     std::atomic<bool>  micMuted_{false};
     std::atomic<bool>  isDemolished_{false};
     std::atomic<bool>  isSpeaking_{false};
+    std::atomic<bool>  occlusionEnabled_{true};
     std::atomic<float> currentInputLevel_{0.0f};
 
     // VAD hold state
     int holdFramesRemaining_ = 0;
 
-    // Spatial state
-    Protocol::Vec3 listenerPos_;
+    // Spatial state: the listener pose one atomic per component, read by the
+    // callback and the decode jobs (a read racing an update may mix two
+    // consecutive poses, which lie a tick of movement apart)
+    std::atomic<float> listenerX_{0.0f};
+    std::atomic<float> listenerY_{0.0f};
+    std::atomic<float> listenerZ_{0.0f};
     std::atomic<int> listenerYaw_{0};
+    std::atomic<int> listenerPitch_{0};
+    std::atomic<int> listenerRoll_{0};
     Protocol::Vec3 localPosition_;
 
-    // Spatial audio
-    SpatialAudio spatialAudio_;
-
-    // Per-peer audio decoders and spatial processors
-    std::mutex peersMutex_;
+    // Spatial audio settings shared by every peer: the game thread sets them,
+    // and the callback reads peerDistance_ under mixMutex_ (never rebuilt there)
+    std::atomic<bool> spatialEnabled_{true};
+    DistanceModel::Settings distanceSettings_;      // Game thread
+    std::unique_ptr<const DistanceModel> peerDistance_;
+
+    // Held by the playback callback for its whole mix, and by the game thread
+    // while it swaps what the mix reads (HRIR bus, distance table) or resets
+    // peers' renderer state. The decode worker never takes it. Taken before
+    // peersMutex_ where both are held
+    std::mutex mixMutex_;
+
+    // Per-peer audio decoders and spatial processors. Only the decode worker
+    // inserts (and peers are cleared only while it is stopped), so the worker
+    // may read the map without peersMutex_; the callback takes it only to
+    // copy the peer pointers into mixPeers_
+    mutable std::mutex peersMutex_;
     std::unordered_map<std::string, std::unique_ptr<PeerAudioState>> peers_;
 
-    // Incoming packet queue (fed by network thread)
+    // The callback's per-peer lists, with room for every peer. The decode
+    // worker allocates larger ones into the spares before it adds a peer
+    // (under peersMutex_), and the callback swaps them in with its snapshot
+    std::vector<PeerAudioState*> mixPeers_;                       // Callback: this callback's peers
+    std::vector<std::pair<float, PeerAudioState*>> lodRanking_;   // Callback: reused per LOD update
+    std::vector<PeerAudioState*> spareMixPeers_;
+    std::vector<std::pair<float, PeerAudioState*>> spareLodRanking_;
+    size_t peerListCapacity_ = 0;                                 // Decode worker: of the spares it made
+
+    // Incoming packet queue (fed by network thread, drained by the decode worker)
     ThreadSafeQueue<Protocol::AudioPacket> incomingPackets_{128};
+    std::thread decodeThread_;
+    std::atomic<bool> decodeRunning_{false};
+    std::vector<PeerAudioState*> decodePeers_;   // Decode worker: every peer, one pool job each
 
     // Outgoing packet callback
     PacketReadyCallback packetReadyCb_;
 
-    // Mix buffer (stereo, reused)
+    // Mix buffer (stereo, reused): the stereo bed when the output is multichannel
     std::vector<float> mixBuffer_;
 
+    // Shared reverb bus (summed per-peer sends → one stereo reverb per callback) and output clamp
+    MasterBus masterBus_;
+
+    // Measured-HRIR bus (frequency-domain mix of all object-mode peers)
+    std::unique_ptr<HrirRenderer> hrirBus_;
+    std::atomic<bool> hrirLoaded_{false};
+    std::vector<float> hrirOutL_;
+    std::vector<float> hrirOutR_;
+
+    // Per-peer decode and spatialization jobs of each period; parametric peers
+    // playing in one callback are spatialized in SpatialBatch jobs across it
+    WorkStealingPool pool_;
+    Fanout spatialFanout_{pool_};
+    std::vector<std::pair<PeerAudioState*, int>> batchQueue_;   // Reserved, (peer, samples)
+    std::chrono::steady_clock::time_point spatialDeadline_;    // Callback: this period's SPATIAL_DEADLINE
+
+    // Ambisonic bus (world-frame encode of all object-mode peers, one decode)
+    AmbisonicRenderer ambisonicBus_;
+
+    // Speaker bus (VBAP of all object-mode peers onto the output channels)
+    VbapRenderer speakerBus_;
+
+    std::atomic<Renderer> renderer_{Renderer::Parametric};
+
+    // Level of detail: the N most prominent peers get the full tier, the next
+    // M the reduced tier; N and M shrink while the callback runs over budget
+    std::atomic<float> callbackLoad_{0.0f};
+    int lodCounter_   = 0;
+    int fullSlots_    = LOD_MAX_SLOTS;
+    int reducedSlots_ = LOD_MAX_SLOTS;
+
     // Error
     mutable std::mutex errorMutex_;
     std::string lastError_;
@@ -270,3 +678,8 @@ private:
         lastError_ = err;
     }
 };
+
+extern template class BasicAudioEngine<BuildFlavor::Plugin>;
+extern template class BasicAudioEngine<BuildFlavor::Upload>;
+
+using AudioEngine = BasicAudioEngine<BuildFlavor::Active>;
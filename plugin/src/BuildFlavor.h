@@ -0,0 +1,48 @@
+#pragma once
+
+/**
+ * Build flavors: the compile-time policies that SpatialAudio, SpatialBatch
+ * and AudioEngine are specialized on.
+ *
+ * The plugin (plugin/) and the BakkesPlugins upload (bakkesmod-upload/)
+ * build from the same sources and differ only here:
+ *
+ *   Plugin : strong, clearly audible Doppler, distance high-pass, and a
+ *            demolished player neither talks nor hears
+ *   Upload : subtle Doppler, no distance high-pass, demolition ignored
+ *
+ * A stage a flavor does not have is removed with `if constexpr`, so it
+ * costs nothing at run time. Both flavors are instantiated in every build
+ * (the linker drops the unused one), so neither can rot unnoticed.
+ *
+ * The flavor of a build is picked by defining LEO_FLAVOR_UPLOAD (set by
+ * bakkesmod-upload/CMakeLists.txt and its .vcxproj); the plain names
+ * SpatialAudio, SpatialBatch and AudioEngine refer to that flavor.
+ */
+namespace BuildFlavor {
+
+struct Plugin {
+    static constexpr float DOPPLER_EXAGGERATION = 4.0f;    // Strong audible Doppler
+    static constexpr float DOPPLER_SMOOTH       = 0.002f;  // Responsive pitch smoothing (per sample)
+    static constexpr float DOPPLER_MIN_PITCH    = 0.70f;   // Wide, clearly audible range
+    static constexpr float DOPPLER_MAX_PITCH    = 1.40f;
+    static constexpr bool  DISTANCE_HIGH_PASS   = true;    // Cut bass at long range
+    static constexpr bool  DEMOLITION_SILENCES  = true;    // Mute capture and playback while demolished
+};
+
+struct Upload {
+    static constexpr float DOPPLER_EXAGGERATION = 1.2f;     // Subtle exaggeration, realistic feel
+    static constexpr float DOPPLER_SMOOTH       = 0.00005f; // Very slow smoothing, gradual pitch glide
+    static constexpr float DOPPLER_MIN_PITCH    = 0.88f;    // Tight range, about ±2 semitones
+    static constexpr float DOPPLER_MAX_PITCH    = 1.12f;
+    static constexpr bool  DISTANCE_HIGH_PASS   = false;
+    static constexpr bool  DEMOLITION_SILENCES  = false;
+};
+
+#ifdef LEO_FLAVOR_UPLOAD
+using Active = Upload;
+#else
+using Active = Plugin;
+#endif
+
+} // namespace BuildFlavor
@@ -0,0 +1,120 @@
+#include "DistanceModel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float PI = 3.14159265358979323846f;
+
+float smoothstep(float edge0, float edge1, float x) {
+    float t = std::clamp((x - edge0) / (edge1 - edge0 + 1e-9f), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+/** Soft fade: gentle logarithmic-style rolloff, loud for most of the range */
+float softShape(float t) {
+    return 1.0f - std::pow(t, 0.6f);
+}
+
+} // namespace
+
+// =============================================================================
+//  Reference formulas
+// =============================================================================
+
+DistanceModel::Entry DistanceModel::compute(const Settings& s, float distUU) {
+    const float inner = std::max(s.inner, 0.0f);
+    const float outer = std::max(s.outer, inner + 1.0f);
+
+    // ── Attenuation ──
+    float gain = 1.0f;
+    if (distUU > inner) {
+        const float t = std::clamp((distUU - inner) / (outer - inner), 0.0f, 1.0f);
+        const float ref = std::max(inner, MIN_REFERENCE_UU);
+        const float r = s.rolloff;
+        switch (s.curve) {
+        case Curve::Soft:
+            gain = std::pow(softShape(t), r);
+            break;
+        case Curve::Inverse:
+            gain = ref / (ref + r * std::max(distUU - ref, 0.0f));
+            break;
+        case Curve::Linear:
+            gain = 1.0f - r * t;
+            break;
+        case Curve::Exponential:
+            gain = std::pow(std::max(distUU, ref) / ref, -r);
+            break;
+        case Curve::Custom: {
+            float shape;
+            if (s.pointCount >= 2) {
+                const float x = t * static_cast<float>(s.pointCount - 1);
+                const int i = std::min(static_cast<int>(x), s.pointCount - 2);
+                const float f = x - static_cast<float>(i);
+                shape = s.points[i] + f * (s.points[i + 1] - s.points[i]);
+            } else {
+                shape = softShape(t);
+            }
+            gain = std::pow(std::clamp(shape, 0.0f, 1.0f), r);
+            break;
+        }
+        }
+        // Floor: always slightly audible within the outer radius
+        gain = std::clamp(gain, MIN_GAIN, 1.0f);
+    }
+
+    // ── Air absorption: gentle high-frequency rolloff, none at close range ──
+    const float distMeters = distUU / 100.0f;   // UE4: 1uu ≈ 1cm
+    float airAlpha = 1.0f;
+    if (distMeters >= 5.0f) {
+        airAlpha = std::clamp(1.0f / (1.0f + 0.008f * distMeters), 0.15f, 1.0f);
+    }
+
+    // ── Distance high-pass: cutoff from ~20 Hz (close) to ~600 Hz (outer radius) ──
+    // alpha for one-pole HP: alpha = 1 / (1 + 2*pi*fc/sr); 1 = no filtering
+    const float ramp = distUU <= inner ? 0.0f : smoothstep(inner, outer, distUU);
+    const float hpCutoff = 20.0f + ramp * 580.0f;
+    const float hpAlpha = std::clamp(
+        1.0f / (1.0f + (2.0f * PI * hpCutoff) / static_cast<float>(Protocol::SAMPLE_RATE)),
+        0.90f, 1.0f);
+
+    // ── Reverb send: noticeable room ambience up close, up to 100% far out ──
+    const float reverbSend = 0.15f + ramp * 0.85f;
+
+    return { gain, airAlpha, hpAlpha, reverbSend };
+}
+
+// =============================================================================
+//  Table
+// =============================================================================
+
+void DistanceModel::configure(const Settings& settings) {
+    if (settings == settings_) return;
+    settings_ = settings;
+    build();
+}
+
+void DistanceModel::build() {
+    const float outer = std::max(settings_.outer, std::max(settings_.inner, 0.0f) + 1.0f);
+    stepScale_ = static_cast<float>(STEPS) / outer;
+    for (int i = 0; i <= STEPS; i++) {
+        table_[i] = compute(settings_, outer * static_cast<float>(i) / static_cast<float>(STEPS));
+    }
+}
+
+DistanceModel::Entry DistanceModel::lookup(float distUU) const {
+    const float x = std::max(distUU, 0.0f) * stepScale_;
+    if (x >= static_cast<float>(STEPS)) {
+        Entry e = table_[STEPS];
+        e.gain = 0.0f;   // Out of range
+        return e;
+    }
+    const int i = static_cast<int>(x);
+    const float f = x - static_cast<float>(i);
+    const Entry& a = table_[i];
+    const Entry& b = table_[i + 1];
+    return { a.gain       + f * (b.gain       - a.gain),
+             a.airAlpha   + f * (b.airAlpha   - a.airAlpha),
+             a.hpAlpha    + f * (b.hpAlpha    - a.hpAlpha),
+             a.reverbSend + f * (b.reverbSend - a.reverbSend) };
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "Protocol.h"
+#include <array>
+
+/**
+ * Distance model: every distance-dependent parameter of a source, baked
+ * into one table and read with one interpolated lookup per packet.
+ *
+ * An entry holds the attenuation, the air-absorption and distance
+ * high-pass coefficients and the (pre-mix) reverb send. The table spans
+ * [0, outer radius]; beyond it a source is silent. It is rebuilt only
+ * when configure() sees different settings, not per packet.
+ *
+ * Attenuation curves (d = distance, ref = inner radius, at least 1 m;
+ * t = (d - inner) / (outer - inner); r = rolloff):
+ *
+ *   Soft        : (1 - t^0.6)^r           slow fade, stays loud far out
+ *   Inverse     : ref / (ref + r (d - ref))
+ *   Linear      : 1 - r t
+ *   Exponential : (d / ref)^-r
+ *   Custom      : curve(t)^r, curve = user points evenly spaced over
+ *                 inner..outer (Soft's shape while no points are set)
+ *
+ * All curves are 1 inside the inner radius and never drop below MIN_GAIN
+ * inside the outer radius, so every peer in range stays slightly audible.
+ */
+class DistanceModel {
+public:
+    enum class Curve { Soft, Inverse, Linear, Exponential, Custom };
+
+    static constexpr int   STEPS = 512;                // Intervals over [0, outer]
+    static constexpr int   MAX_CURVE_POINTS = 16;
+    static constexpr float MIN_GAIN = 0.04f;
+    static constexpr float MIN_REFERENCE_UU = 100.0f;  // Inverse/Exponential reference floor (1 m)
+
+    struct Settings {
+        float inner   = Protocol::DEFAULT_FULL_VOL_DISTANCE;
+        float outer   = Protocol::DEFAULT_MAX_DISTANCE;
+        float rolloff = Protocol::DEFAULT_ROLLOFF_FACTOR;
+        Curve curve   = Curve::Soft;
+        std::array<float, MAX_CURVE_POINTS> points{};   // Custom curve gains, inner → outer
+        int pointCount = 0;                             // < 2: Soft's shape
+
+        bool operator==(const Settings& o) const {
+            return inner == o.inner && outer == o.outer && rolloff == o.rolloff &&
+                   curve == o.curve && pointCount == o.pointCount && points == o.points;
+        }
+        bool operator!=(const Settings& o) const { return !(*this == o); }
+    };
+
+    /** Distance-dependent parameters of one source. */
+    struct Entry {
+        float gain;         // Attenuation (0 = out of range)
+        float airAlpha;     // Air absorption one-pole LP (1 = no filtering)
+        float hpAlpha;      // Distance high-pass (1 = no bass cut)
+        float reverbSend;   // Reverb send before the reverb mix
+    };
+
+    DistanceModel() { build(); }
+    explicit DistanceModel(const Settings& settings) : settings_(settings) { build(); }
+
+    /** Adopt new settings; rebuilds the table only if they changed. */
+    void configure(const Settings& settings);
+    const Settings& settings() const { return settings_; }
+
+    /** Interpolated lookup (distance in Unreal units). */
+    Entry lookup(float distUU) const;
+
+    /** Reference formulas the table is built from (no clamping to the table range). */
+    static Entry compute(const Settings& settings, float distUU);
+
+private:
+    void build();
+
+    Settings settings_;
+    float stepScale_ = 0.0f;   // STEPS / outer
+    std::array<Entry, STEPS + 1> table_{};
+};
@@ -0,0 +1,148 @@
+#include "DopplerEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// =============================================================================
+//  Polyphase windowed-sinc table
+//  Row p holds the taps for a read position p/PHASES past the integer sample;
+//  row PHASES (= next integer) is included so neighbouring rows interpolate.
+// =============================================================================
+
+constexpr int TAPS   = DopplerEngine::TAPS;
+constexpr int PHASES = DopplerEngine::PHASES;
+constexpr int HALF   = TAPS / 2;
+static_assert(TAPS == 8, "readInterpolated() sums exactly 8 products");
+
+double besselI0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; k++) {
+        term *= (x * 0.5 / k) * (x * 0.5 / k);
+        sum += term;
+    }
+    return sum;
+}
+
+struct SincTable {
+    alignas(32) std::array<std::array<float, TAPS>, PHASES + 1> taps;
+
+    SincTable() {
+        const double pi = 3.14159265358979323846;
+        const double beta = 6.0;   // Kaiser: ~-60dB sidelobes at 8 taps
+        const double norm = besselI0(beta);
+        for (int p = 0; p <= PHASES; p++) {
+            double frac = static_cast<double>(p) / PHASES;
+            double sum = 0.0;
+            for (int k = 0; k < TAPS; k++) {
+                // Tap k reads sample (index - HALF + 1 + k); distance from the read point
+                double x = static_cast<double>(k - (HALF - 1)) - frac;
+                double sinc = (x == 0.0) ? 1.0 : std::sin(pi * x) / (pi * x);
+                double r = x / HALF;
+                double w = (std::abs(r) >= 1.0) ? 0.0 : besselI0(beta * std::sqrt(1.0 - r * r)) / norm;
+                taps[p][k] = static_cast<float>(sinc * w);
+                sum += taps[p][k];
+            }
+            // Unity DC gain at every phase (no level ripple while the pitch moves)
+            for (int k = 0; k < TAPS; k++) taps[p][k] = static_cast<float>(taps[p][k] / sum);
+        }
+    }
+};
+
+const SincTable& sincTable() {
+    static const SincTable t;
+    return t;
+}
+
+} // namespace
+
+// =============================================================================
+//  State
+// =============================================================================
+
+void DopplerEngine::reset() {
+    taps_ = sincTable().taps.data();   // Built here, off the audio thread
+    buffer_.fill(0.0f);
+    writePos_ = 0;
+    readPhase_ = static_cast<uint32_t>(-MIN_LAG) << FRAC_BITS;   // MIN_LAG behind, integer
+}
+
+void DopplerEngine::clampLag() {
+    // Modulo the ring; the head moves < 2 samples per call, so lag never goes negative
+    const uint32_t lag = (writePos_ << FRAC_BITS) - readPhase_;
+    if (lag > (static_cast<uint32_t>(MAX_LAG) << FRAC_BITS)) {
+        readPhase_ = (writePos_ - MAX_LAG) << FRAC_BITS;
+    } else if (lag < (static_cast<uint32_t>(MIN_LAG) << FRAC_BITS)) {
+        readPhase_ = (writePos_ - MIN_LAG) << FRAC_BITS;
+    }
+}
+
+float DopplerEngine::readInterpolated() const {
+    const uint32_t index = readPhase_ >> FRAC_BITS;
+    const uint32_t frac  = readPhase_ & FRAC_MASK;
+    const int p = static_cast<int>(frac >> PHASE_SHIFT);
+    const float t = static_cast<float>(frac & ((1u << PHASE_SHIFT) - 1)) * (1.0f / (1u << PHASE_SHIFT));
+
+    const TapRow& row0 = taps_[p];
+    const TapRow& row1 = taps_[p + 1];
+    const float* x = &buffer_[(index - (HALF - 1)) & BUF_MASK];   // Contiguous thanks to the guard
+
+    // Element-wise products, then a fixed pairwise sum (vectorizes without fast-math)
+    float prod[TAPS];
+    for (int k = 0; k < TAPS; k++) {
+        prod[k] = (row0[k] + t * (row1[k] - row0[k])) * x[k];
+    }
+    return ((prod[0] + prod[4]) + (prod[1] + prod[5])) + ((prod[2] + prod[6]) + (prod[3] + prod[7]));
+}
+
+// =============================================================================
+//  Processing
+// =============================================================================
+
+void DopplerEngine::process(const float* in, const float* pitch, float* out, int n) {
+    for (int i = 0; i < n; i++) {
+        write(in[i]);
+        readPhase_ += static_cast<uint32_t>(pitch[i] * static_cast<float>(ONE) + 0.5f);
+        clampLag();
+        out[i] = readInterpolated();
+    }
+}
+
+void DopplerEngine::processUnity(const float* in, float* out, int n) {
+    int i = 0;
+
+    // Glide: read slightly slower until the phase lands on a sample. At most
+    // half a sample per call over a block, i.e. a few cents for one block.
+    const uint32_t frac = readPhase_ & FRAC_MASK;
+    if (frac != 0) {
+        uint32_t remaining = frac;
+        const uint32_t perSample = (frac + static_cast<uint32_t>(n) - 1) / static_cast<uint32_t>(n);
+        for (; i < n && remaining != 0; i++) {
+            uint32_t d = std::min(perSample, remaining);
+            remaining -= d;
+            write(in[i]);
+            readPhase_ += ONE - d;
+            out[i] = readInterpolated();
+        }
+    }
+
+    // Bypass: integer delay, phase 0 of the sinc is a unit impulse
+    for (; i < n; ) {
+        const uint32_t lag = (writePos_ - (readPhase_ >> FRAC_BITS)) & BUF_MASK;
+        const uint32_t w = writePos_ & BUF_MASK;
+        // Stay within the ring end, and never overwrite samples this chunk still reads
+        int chunk = std::min({ n - i, BUF_SIZE - static_cast<int>(w), BUF_SIZE - static_cast<int>(lag) });
+        std::memcpy(&buffer_[w], in + i, sizeof(float) * chunk);
+        if (w < TAPS) {
+            int guard = std::min(chunk, TAPS - static_cast<int>(w));
+            std::memcpy(&buffer_[w + BUF_SIZE], in + i, sizeof(float) * guard);
+        }
+        writePos_ += chunk;
+        readPhase_ += static_cast<uint32_t>(chunk) << FRAC_BITS;
+        for (int j = 0; j < chunk; j++) {
+            out[i + j] = buffer_[(w + j - lag + 1) & BUF_MASK];
+        }
+        i += chunk;
+    }
+}
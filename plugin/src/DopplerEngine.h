@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+/**
+ * Variable-rate delay line for Doppler pitch shifting.
+ *
+ * One mono line per source: both ears see the same input and the same
+ * pitch ratio, so the left and right lines SpatialAudio used to keep were
+ * always identical. The read head is a Q12.20 fixed-point phase: the 12
+ * integer bits index the 4096-sample ring directly, so the phase wraps with
+ * the buffer and no floor()/double math is needed per sample.
+ *
+ * Reads use an 8-tap Kaiser-windowed sinc, tabulated at 32 sub-sample
+ * phases with linear interpolation between neighbouring phases. Its cutoff
+ * sits at Nyquist, so phase 0 is an exact unit impulse; decoded Opus voice
+ * carries nothing near Nyquist, so no pitch-dependent cutoff is needed to
+ * stay alias-free up to the 1.4x pitch limit.
+ *
+ * When the pitch sits at unity, processUnity() first glides any leftover
+ * fractional offset to zero, then degenerates into a plain integer delay
+ * (ring write + copy, no filtering).
+ */
+class DopplerEngine {
+public:
+    static constexpr int BUF_SIZE = 4096;          // Must match the 12 integer phase bits
+    static constexpr int BUF_MASK = BUF_SIZE - 1;
+    static constexpr int TAPS     = 8;
+    static constexpr int PHASES   = 32;
+
+    DopplerEngine() { reset(); }
+
+    /** Shift n samples; pitch[i] is the read-rate ratio (> 1 = higher pitch). out may alias in. */
+    void process(const float* in, const float* pitch, float* out, int n);
+
+    /** Unity-pitch path: settle the fractional phase, then a plain delay. out may alias in. */
+    void processUnity(const float* in, float* out, int n);
+
+    /** True once the read head is on an integer sample (unity path is a plain copy). */
+    bool isBypassed() const { return (readPhase_ & FRAC_MASK) == 0; }
+
+    void reset();
+
+private:
+    static constexpr int      FRAC_BITS  = 20;          // 12 + 20 = 32: phase wraps with the ring
+    static constexpr uint32_t ONE        = 1u << FRAC_BITS;
+    static constexpr uint32_t FRAC_MASK  = ONE - 1;
+    static constexpr int      PHASE_BITS = 5;       // log2(PHASES)
+    static constexpr int      PHASE_SHIFT = FRAC_BITS - PHASE_BITS;
+
+    /** Keep the read head far enough behind the write head for all taps */
+    static constexpr int MIN_LAG = TAPS / 2 + 1;
+    static constexpr int MAX_LAG = BUF_SIZE - 64;
+
+    void write(float sample) {
+        const uint32_t w = writePos_ & BUF_MASK;
+        buffer_[w] = sample;
+        if (w < TAPS) buffer_[w + BUF_SIZE] = sample;   // Guard copy: taps never wrap
+        writePos_++;
+    }
+    float readInterpolated() const;
+    void clampLag();
+
+    using TapRow = std::array<float, TAPS>;
+
+    alignas(32) std::array<float, BUF_SIZE + TAPS> buffer_{};
+    const TapRow* taps_ = nullptr;   // Shared polyphase table, PHASES + 1 rows
+    uint32_t writePos_  = 0;   // Sample counter (wraps)
+    uint32_t readPhase_ = 0;   // Q12.20 read position (wraps with the ring)
+};
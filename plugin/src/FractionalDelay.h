@@ -0,0 +1,135 @@
+#pragma once
+#include <array>
+
+/**
+ * Fractional delay for the ITD stages, with the interpolator picked at
+ * compile time.
+ *
+ * Interpolators read a history through an accessor x(i) = the sample i
+ * samples ago, so the same arithmetic serves DelayLine's ring buffer and
+ * the sample-major rows of SpatialBatch and AmbisonicRenderer:
+ *
+ *   Linear    : 2 taps. A delay-dependent low-pass (-6 dB at Nyquist for
+ *               half a sample), so a sweeping ITD modulates the tone.
+ *   Lagrange3 : 4 taps, third-order Lagrange in Farrow form: four fixed
+ *               FIR branches combined by Horner in the fraction, so the
+ *               delay can change every sample and no coefficients are
+ *               recomputed. Flat to ~8 kHz at any fraction.
+ *   Thiran    : first-order allpass. Flat magnitude at every frequency,
+ *               but the coefficient is recursive state, so it is designed
+ *               once per block (design()) and suits delays that hold
+ *               still, such as fixed speaker ITDs.
+ *
+ * Lagrange3 and Thiran need a tap on both sides of the delayed point and
+ * add LATENCY whole samples to every delay; both ears get the same, so
+ * the ITD is unchanged. REACH is how far past floor(delay) a read looks,
+ * for sizing history buffers.
+ */
+namespace FractionalDelay {
+
+    struct Linear {
+        static constexpr int LATENCY = 0;
+        static constexpr int REACH   = 1;
+        struct State {};
+
+        static void design(State&, float) {}
+
+        template <class History>
+        static float read(const History& x, float delay, State&) {
+            const int d0 = static_cast<int>(delay);
+            const float frac = delay - static_cast<float>(d0);
+            const float s0 = x(d0), s1 = x(d0 + 1);
+            return s0 + frac * (s1 - s0);
+        }
+    };
+
+    struct Lagrange3 {
+        static constexpr int LATENCY = 1;
+        static constexpr int REACH   = 3;
+        struct State {};
+
+        static void design(State&, float) {}
+
+        template <class History>
+        static float read(const History& x, float delay, State&) {
+            // Taps around delay + 1, which sits between x1 and x2
+            const int d0 = static_cast<int>(delay);
+            const float f = delay - static_cast<float>(d0);
+            const float x0 = x(d0), x1 = x(d0 + 1), x2 = x(d0 + 2), x3 = x(d0 + 3);
+
+            // Farrow branches: Lagrange weights expanded in powers of f
+            const float c1 = x2 - 0.5f * x1 - (1.0f / 3.0f) * x0 - (1.0f / 6.0f) * x3;
+            const float c2 = 0.5f * (x0 + x2) - x1;
+            const float c3 = 0.5f * (x1 - x2) + (1.0f / 6.0f) * (x3 - x0);
+            return x1 + f * (c1 + f * (c2 + f * c3));
+        }
+    };
+
+    struct Thiran {
+        static constexpr int LATENCY = 1;
+        static constexpr int REACH   = 2;
+        struct State {
+            int   whole = 0;      // Integer part of the delay (before the allpass)
+            float a     = 0.0f;   // Allpass coefficient for the remaining 0.5–1.5 samples
+            float y1    = 0.0f;   // Previous output
+        };
+
+        /** Design for delay (plus LATENCY); call once per block. */
+        static void design(State& st, float delay) {
+            const float total = delay + static_cast<float>(LATENCY);
+            st.whole = static_cast<int>(delay + 0.5f);   // floor(total - 0.5), delay >= 0
+            const float d = total - static_cast<float>(st.whole);
+            st.a = (1.0f - d) / (1.0f + d);
+        }
+
+        /** delay is ignored: the allpass runs at the delay passed to design(). */
+        template <class History>
+        static float read(const History& x, float, State& st) {
+            const float y = st.a * (x(st.whole) - st.y1) + x(st.whole + 1);
+            st.y1 = y;
+            return y;
+        }
+    };
+
+    /** History with a fixed stride: x(i) = base[-i * stride] (sample-major rows). */
+    struct Strided {
+        const float* base;
+        int stride;
+        float operator()(int i) const { return base[-i * stride]; }
+    };
+
+    /**
+     * Ring-buffer delay line. process() writes and reads a block, designing
+     * the interpolator once from the delay at the middle of the block.
+     */
+    template <class Interp>
+    struct DelayLine {
+        static constexpr int SIZE = 64;   // Power of 2
+        static constexpr int MASK = SIZE - 1;
+
+        std::array<float, SIZE> buffer{};
+        int writePos = 0;
+        typename Interp::State state{};
+
+        void write(float sample) {
+            buffer[writePos & MASK] = sample;
+            writePos++;
+        }
+
+        float read(float delaySamples) {
+            const int newest = writePos - 1;
+            const float* buf = buffer.data();
+            auto x = [buf, newest](int i) { return buf[(newest - i) & MASK]; };
+            return Interp::read(x, delaySamples, state);
+        }
+
+        void process(const float* in, const float* delay, float* out, int n) {
+            Interp::design(state, delay[n / 2]);
+            for (int i = 0; i < n; i++) {
+                write(in[i]);
+                out[i] = read(delay[i]);
+            }
+        }
+    };
+
+} // namespace FractionalDelay
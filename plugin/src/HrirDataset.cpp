@@ -0,0 +1,132 @@
+#include "HrirDataset.h"
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct FileHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t sampleRate;
+    uint32_t length;
+    uint32_t azimuthCount;
+    uint32_t elevationCount;
+    float    elevationMin;
+    float    elevationMax;
+};
+static_assert(sizeof(FileHeader) == 32, "HRIR header must be 32 bytes");
+
+// Sanity limits — anything larger is not an HRIR set
+constexpr uint32_t MAX_LENGTH     = 8192;
+constexpr uint32_t MAX_GRID_AXIS  = 1024;
+
+} // namespace
+
+HrirDataset::~HrirDataset() {
+    close();
+}
+
+bool HrirDataset::fail(const std::string& err) {
+    close();
+    lastError_ = err;
+    return false;
+}
+
+bool HrirDataset::open(const std::string& path) {
+    close();
+    lastError_.clear();
+
+    // ── Map the file read-only ───────────────────────────────────────────
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return fail("Cannot open HRIR file: " + path);
+    file_ = file;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) return fail("Cannot stat HRIR file: " + path);
+    viewSize_ = static_cast<size_t>(size.QuadPart);
+    if (viewSize_ < sizeof(FileHeader)) return fail("HRIR file too small: " + path);
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) return fail("Cannot map HRIR file: " + path);
+    mapping_ = mapping;
+
+    view_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view_) return fail("Cannot map HRIR file: " + path);
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) return fail("Cannot open HRIR file: " + path);
+
+    struct stat st{};
+    if (fstat(fd_, &st) != 0) return fail("Cannot stat HRIR file: " + path);
+    viewSize_ = static_cast<size_t>(st.st_size);
+    if (viewSize_ < sizeof(FileHeader)) return fail("HRIR file too small: " + path);
+
+    void* view = mmap(nullptr, viewSize_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (view == MAP_FAILED) return fail("Cannot map HRIR file: " + path);
+    view_ = view;
+#endif
+
+    // ── Validate header ──────────────────────────────────────────────────
+    FileHeader h;
+    std::memcpy(&h, view_, sizeof(h));
+
+    if (std::memcmp(h.magic, "LHRI", 4) != 0) return fail("Not an HRIR file (bad magic): " + path);
+    if (h.version != VERSION) return fail("Unsupported HRIR file version " + std::to_string(h.version));
+    if (h.length == 0 || h.length > MAX_LENGTH) return fail("Invalid HRIR length " + std::to_string(h.length));
+    if (h.azimuthCount == 0 || h.azimuthCount > MAX_GRID_AXIS ||
+        h.elevationCount == 0 || h.elevationCount > MAX_GRID_AXIS) {
+        return fail("Invalid HRIR grid size");
+    }
+    if (h.elevationCount > 1 && !(h.elevationMax > h.elevationMin)) {
+        return fail("Invalid HRIR elevation range");
+    }
+
+    size_t floats = static_cast<size_t>(h.elevationCount) * h.azimuthCount * 2 * h.length;
+    if (viewSize_ < sizeof(FileHeader) + floats * sizeof(float)) {
+        return fail("HRIR file truncated: " + path);
+    }
+
+    data_           = reinterpret_cast<const float*>(static_cast<const char*>(view_) + sizeof(FileHeader));
+    sampleRate_     = static_cast<int>(h.sampleRate);
+    length_         = static_cast<int>(h.length);
+    azimuthCount_   = static_cast<int>(h.azimuthCount);
+    elevationCount_ = static_cast<int>(h.elevationCount);
+    elevationMin_   = h.elevationMin;
+    elevationMax_   = h.elevationCount > 1 ? h.elevationMax : h.elevationMin;
+    return true;
+}
+
+void HrirDataset::close() {
+#ifdef _WIN32
+    if (view_)    UnmapViewOfFile(view_);
+    if (mapping_) CloseHandle(static_cast<HANDLE>(mapping_));
+    if (file_)    CloseHandle(static_cast<HANDLE>(file_));
+    mapping_ = nullptr;
+    file_ = nullptr;
+#else
+    if (view_)     munmap(view_, viewSize_);
+    if (fd_ >= 0)  ::close(fd_);
+    fd_ = -1;
+#endif
+    view_ = nullptr;
+    viewSize_ = 0;
+    data_ = nullptr;
+    sampleRate_ = length_ = azimuthCount_ = elevationCount_ = 0;
+    elevationMin_ = elevationMax_ = 0.0f;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * Read-only, memory-mapped set of measured HRIRs on a regular grid.
+ *
+ * File format (".lhrir", little-endian):
+ *
+ *   Header (32 bytes)
+ *     char     magic[4]        "LHRI"
+ *     uint32   version         1
+ *     uint32   sampleRate      must match Protocol::SAMPLE_RATE
+ *     uint32   length          taps per impulse response
+ *     uint32   azimuthCount    uniform over [0°, 360°)
+ *     uint32   elevationCount  uniform over [elevationMin, elevationMax]
+ *     float32  elevationMin    degrees
+ *     float32  elevationMax    degrees
+ *
+ *   Data
+ *     float32  hrir[elevationCount][azimuthCount][2][length]   (ear 0 = left)
+ *
+ * Azimuth is counter-clockwise seen from above (0° = front, 90° = left),
+ * the same convention as SOFA / CIPIC exports. The file is mapped, not
+ * copied; impulse responses are read in place.
+ */
+class HrirDataset {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    HrirDataset() = default;
+    ~HrirDataset();
+
+    HrirDataset(const HrirDataset&) = delete;
+    HrirDataset& operator=(const HrirDataset&) = delete;
+
+    /** Map and validate a dataset file. Returns false (see lastError()) on failure. */
+    bool open(const std::string& path);
+
+    /** Unmap the file. */
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+
+    int   sampleRate() const     { return sampleRate_; }
+    int   length() const         { return length_; }
+    int   azimuthCount() const   { return azimuthCount_; }
+    int   elevationCount() const { return elevationCount_; }
+    float elevationMin() const   { return elevationMin_; }
+    float elevationMax() const   { return elevationMax_; }
+
+    /** Impulse response for one grid point and ear (0 = left, 1 = right). */
+    const float* hrir(int elevation, int azimuth, int ear) const {
+        size_t index = (static_cast<size_t>(elevation) * azimuthCount_ + azimuth) * 2 + ear;
+        return data_ + index * length_;
+    }
+
+    const std::string& lastError() const { return lastError_; }
+
+private:
+    bool fail(const std::string& err);
+
+    // Mapping
+    void*       view_    = nullptr;
+    size_t      viewSize_ = 0;
+#ifdef _WIN32
+    void*       file_    = nullptr;   // HANDLE
+    void*       mapping_ = nullptr;   // HANDLE
+#else
+    int         fd_      = -1;
+#endif
+
+    // Parsed header
+    const float* data_ = nullptr;
+    int   sampleRate_     = 0;
+    int   length_         = 0;
+    int   azimuthCount_   = 0;
+    int   elevationCount_ = 0;
+    float elevationMin_   = 0.0f;
+    float elevationMax_   = 0.0f;
+
+    std::string lastError_;
+};
@@ -0,0 +1,201 @@
+#include "HrirRenderer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+
+constexpr float PI = 3.14159265358979323846f;
+
+unsigned nextGeneration() {
+    static std::atomic<unsigned> counter{0};
+    return ++counter;
+}
+
+} // namespace
+
+// =============================================================================
+//  Load: map the dataset, transform every partition of every HRIR
+// =============================================================================
+
+bool HrirRenderer::load(const std::string& path, int blockSize, int sampleRate) {
+    loaded_ = false;
+    lastError_.clear();
+
+    HrirDataset dataset;
+    if (!dataset.open(path)) {
+        lastError_ = dataset.lastError();
+        return false;
+    }
+    if (dataset.sampleRate() != sampleRate) {
+        lastError_ = "HRIR sample rate " + std::to_string(dataset.sampleRate()) +
+                     " does not match " + std::to_string(sampleRate);
+        return false;
+    }
+
+    blockSize_ = blockSize;
+    fftSize_ = 1;
+    while (fftSize_ < blockSize * 2) fftSize_ <<= 1;
+    bins_ = fftSize_ / 2 + 1;
+    partitionLength_ = blockSize_;   // FDL advances one block per partition
+    partitions_ = (dataset.length() + partitionLength_ - 1) / partitionLength_;
+
+    azimuthCount_ = dataset.azimuthCount();
+    elevationCount_ = dataset.elevationCount();
+    elevationMinRad_ = dataset.elevationMin() * (PI / 180.0f);
+    elevationStepRad_ = elevationCount_ > 1
+        ? (dataset.elevationMax() - dataset.elevationMin()) * (PI / 180.0f) / (elevationCount_ - 1)
+        : 0.0f;
+
+    fft_.init(fftSize_);
+    timeIn_.assign(fftSize_, 0.0f);
+    timeOut_.assign(fftSize_, 0.0f);
+    busL_.assign(bins_, Complex(0.0f, 0.0f));
+    busR_.assign(bins_, Complex(0.0f, 0.0f));
+    tailL_.assign(fftSize_ - blockSize_, 0.0f);
+    tailR_.assign(fftSize_ - blockSize_, 0.0f);
+
+    spectra_.assign(static_cast<size_t>(elevationCount_) * azimuthCount_ * 2 * partitions_ * bins_,
+                    Complex(0.0f, 0.0f));
+    for (int e = 0; e < elevationCount_; e++) {
+        for (int a = 0; a < azimuthCount_; a++) {
+            for (int ear = 0; ear < 2; ear++) {
+                const float* ir = dataset.hrir(e, a, ear);
+                for (int p = 0; p < partitions_; p++) {
+                    int start = p * partitionLength_;
+                    int count = std::min(partitionLength_, dataset.length() - start);
+                    std::fill(timeIn_.begin(), timeIn_.end(), 0.0f);
+                    std::copy(ir + start, ir + start + count, timeIn_.begin());
+                    fft_.forward(timeIn_.data(), &spectra_[spectrumIndex(e, a, ear, p)]);
+                }
+            }
+        }
+    }
+
+    // The mapping is only needed while building the spectra
+    dataset.close();
+
+    generation_ = nextGeneration();
+    busActive_ = false;
+    loaded_ = true;
+    return true;
+}
+
+void HrirRenderer::allocate(Source& src) const {
+    src.fdl.assign(static_cast<size_t>(partitions_) * bins_, Complex(0.0f, 0.0f));
+    src.fdlPos = 0;
+    src.gain = 0.0f;
+    src.generation = generation_;
+}
+
+bool HrirRenderer::prepare(Source& src) const {
+    if (src.generation == generation_) return true;
+    if (src.fdl.size() != static_cast<size_t>(partitions_) * bins_) return false;   // See allocate()
+    std::fill(src.fdl.begin(), src.fdl.end(), Complex(0.0f, 0.0f));
+    src.fdlPos = 0;
+    src.gain = 0.0f;
+    src.generation = generation_;
+    return true;
+}
+
+void HrirRenderer::clear() {
+    std::fill(busL_.begin(), busL_.end(), Complex(0.0f, 0.0f));
+    std::fill(busR_.begin(), busR_.end(), Complex(0.0f, 0.0f));
+    std::fill(tailL_.begin(), tailL_.end(), 0.0f);
+    std::fill(tailR_.begin(), tailR_.end(), 0.0f);
+    busActive_ = false;
+}
+
+// =============================================================================
+//  Per-source: forward FFT + partition multiply-add into the bus
+// =============================================================================
+
+void HrirRenderer::addSource(Source& src, const float* mono, int n, float gain,
+                             float azimuth, float elevation) {
+    if (!loaded_ || n != blockSize_ || !prepare(src)) return;
+
+    // Gain ramp from the previous block's gain (click-free distance changes)
+    const float step = (gain - src.gain) / static_cast<float>(n);
+    for (int i = 0; i < n; i++) {
+        timeIn_[i] = mono[i] * (src.gain + step * static_cast<float>(i + 1));
+    }
+    std::fill(timeIn_.begin() + n, timeIn_.end(), 0.0f);
+    src.gain = gain;
+
+    Complex* newest = &src.fdl[static_cast<size_t>(src.fdlPos) * bins_];
+    fft_.forward(timeIn_.data(), newest);
+
+    // ── Bilinear grid weights ──
+    float az = azimuth * (180.0f / PI);
+    az = std::fmod(az, 360.0f);
+    if (az < 0.0f) az += 360.0f;
+    float azPos = az * static_cast<float>(azimuthCount_) / 360.0f;
+    int a0 = static_cast<int>(azPos) % azimuthCount_;
+    int a1 = (a0 + 1) % azimuthCount_;
+    float fa = azPos - std::floor(azPos);
+
+    int e0 = 0, e1 = 0;
+    float fe = 0.0f;
+    if (elevationCount_ > 1) {
+        float ePos = (elevation - elevationMinRad_) / elevationStepRad_;
+        ePos = std::clamp(ePos, 0.0f, static_cast<float>(elevationCount_ - 1));
+        e0 = std::min(static_cast<int>(ePos), elevationCount_ - 2);
+        e1 = e0 + 1;
+        fe = ePos - static_cast<float>(e0);
+    }
+
+    const float w00 = (1.0f - fa) * (1.0f - fe);
+    const float w01 = fa * (1.0f - fe);
+    const float w10 = (1.0f - fa) * fe;
+    const float w11 = fa * fe;
+
+    // ── Y += Σ_p X[k−p] · H_p  for both ears ──
+    for (int p = 0; p < partitions_; p++) {
+        int slot = (src.fdlPos - p + partitions_) % partitions_;
+        const Complex* x = &src.fdl[static_cast<size_t>(slot) * bins_];
+
+        for (int ear = 0; ear < 2; ear++) {
+            const Complex* h00 = &spectra_[spectrumIndex(e0, a0, ear, p)];
+            const Complex* h01 = &spectra_[spectrumIndex(e0, a1, ear, p)];
+            const Complex* h10 = &spectra_[spectrumIndex(e1, a0, ear, p)];
+            const Complex* h11 = &spectra_[spectrumIndex(e1, a1, ear, p)];
+            Complex* bus = ear == 0 ? busL_.data() : busR_.data();
+            for (int k = 0; k < bins_; k++) {
+                Complex h = h00[k] * w00 + h01[k] * w01 + h10[k] * w10 + h11[k] * w11;
+                bus[k] += x[k] * h;
+            }
+        }
+    }
+
+    src.fdlPos = (src.fdlPos + 1) % partitions_;
+    busActive_ = true;
+}
+
+// =============================================================================
+//  Bus: two inverse FFTs + overlap-add, regardless of source count
+// =============================================================================
+
+void HrirRenderer::render(float* outL, float* outR, int n) {
+    if (!loaded_ || n != blockSize_) {
+        std::fill(outL, outL + n, 0.0f);
+        std::fill(outR, outR + n, 0.0f);
+        return;
+    }
+
+    const int tail = fftSize_ - blockSize_;
+    auto finish = [&](std::vector<Complex>& bus, std::vector<float>& carry, float* out) {
+        if (busActive_) {
+            fft_.inverse(bus.data(), timeOut_.data());
+            std::fill(bus.begin(), bus.end(), Complex(0.0f, 0.0f));
+        } else {
+            // Nothing new this block — only the carried tail plays out
+            std::fill(timeOut_.begin(), timeOut_.end(), 0.0f);
+        }
+        for (int i = 0; i < tail; i++) timeOut_[i] += carry[i];
+        std::copy(timeOut_.begin(), timeOut_.begin() + n, out);
+        std::copy(timeOut_.begin() + n, timeOut_.end(), carry.begin());
+    };
+    finish(busL_, tailL_, outL);
+    finish(busR_, tailR_, outR);
+    busActive_ = false;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include "HrirDataset.h"
+#include "RealFft.h"
+#include <string>
+#include <vector>
+
+/**
+ * Measured-HRIR binaural renderer with a frequency-domain mix bus.
+ *
+ * Every HRIR on the dataset grid is split into partitions and transformed
+ * once at load time. Per callback block:
+ *
+ *   addSource() (per peer) : 1 forward FFT of the peer's mono block into its
+ *                            frequency-domain delay line, then multiply-add
+ *                            of every partition against the HRIR spectrum,
+ *                            bilinearly interpolated over azimuth/elevation,
+ *                            into the shared L/R bus spectra
+ *   render()   (once)      : 2 inverse FFTs (L, R) + overlap-add
+ *
+ * So the inverse transforms do not scale with the number of peers. The
+ * convolution is uniformly partitioned overlap-add: block B, FFT size
+ * N = 2^k ≥ 2B, partitions of B taps each.
+ *
+ * Interpolating spectra linearly equals interpolating the impulse responses
+ * in time (the FFT is linear), so no per-peer inverse transform is needed.
+ * Filter changes take effect at block boundaries; input gain is ramped
+ * across the block to avoid zipper noise.
+ *
+ * Not thread-safe: load() builds a fresh instance, callers swap it in.
+ */
+class HrirRenderer {
+public:
+    using Complex = RealFft::Complex;
+
+    /** Per-source convolution state (one per peer). */
+    struct Source {
+        std::vector<Complex> fdl;   // partitions × bins input spectra
+        int   fdlPos = 0;
+        float gain = 0.0f;
+        unsigned generation = 0;    // Renderer this state was sized for
+
+        /** Start clean on the next block; keeps fdl's storage (no allocation on the audio thread). */
+        void reset() { fdlPos = 0; gain = 0.0f; generation = 0; }
+    };
+
+    HrirRenderer() = default;
+
+    HrirRenderer(const HrirRenderer&) = delete;
+    HrirRenderer& operator=(const HrirRenderer&) = delete;
+
+    /** Map a dataset and precompute its partition spectra. */
+    bool load(const std::string& path, int blockSize, int sampleRate);
+
+    bool isLoaded() const { return loaded_; }
+    int  blockSize() const { return blockSize_; }
+    int  partitions() const { return partitions_; }
+    const std::string& lastError() const { return lastError_; }
+
+    /**
+     * Size a source's state for this renderer. Allocates, so not for the
+     * audio thread: addSource() skips a source that was not allocated
+     * for the loaded dataset.
+     */
+    void allocate(Source& src) const;
+
+    /**
+     * Convolve one block of a source and sum it into the bus.
+     * n must equal blockSize(). Azimuth in radians, counter-clockwise from
+     * front (positive = left); elevation in radians (positive = up).
+     */
+    void addSource(Source& src, const float* mono, int n, float gain,
+                   float azimuth, float elevation);
+
+    /** Inverse-transform the bus into n samples per ear and start the next block. */
+    void render(float* outL, float* outR, int n);
+
+    /** Drop the overlap-add tail and bus contents. */
+    void clear();
+
+private:
+    /** Clear a source's state on its first block for this renderer; false if it is not sized for it. */
+    bool prepare(Source& src) const;
+    size_t spectrumIndex(int elevation, int azimuth, int ear, int partition) const {
+        return ((((static_cast<size_t>(elevation) * azimuthCount_ + azimuth) * 2 + ear)
+                 * partitions_ + partition) * bins_);
+    }
+
+    bool loaded_ = false;
+    unsigned generation_ = 0;
+    std::string lastError_;
+
+    int blockSize_ = 0;
+    int fftSize_ = 0;
+    int bins_ = 0;
+    int partitionLength_ = 0;
+    int partitions_ = 0;
+
+    // Grid
+    int   azimuthCount_ = 0;
+    int   elevationCount_ = 0;
+    float elevationMinRad_ = 0.0f;
+    float elevationStepRad_ = 0.0f;
+
+    std::vector<Complex> spectra_;   // [elev][az][ear][partition][bin]
+
+    RealFft fft_;
+    std::vector<float>   timeIn_;    // N
+    std::vector<float>   timeOut_;   // N
+    std::vector<Complex> busL_, busR_;
+    std::vector<float>   tailL_, tailR_;   // N − B overlap-add carry
+    bool busActive_ = false;
+};
@@ -3,6 +3,7 @@
 #include "version.h"
 
 #include <algorithm>
+#include <sstream>
 #include <vector>
 
 // ImGui (provided by BakkesMod)
@@ -160,37 +161,59 @@ void LeoProximityChat::registerCVars() {
         });
 
     cvarManager->registerCvar("leo_proxchat_max_distance", "8000", "Maximum hearing distance", true, true, 500, true, 15000)
-        .addOnValueChanged([this](std::string, CVarWrapper cvar) {
-            if (audioEngine_) {
-                auto& sa = audioEngine_->getSpatialAudio();
-                auto innerCvar = cvarManager->getCvar("leo_proxchat_full_vol_distance");
-                if (innerCvar) sa.setDistanceParams(innerCvar.getFloatValue(), cvar.getFloatValue());
-            }
+        .addOnValueChanged([this](std::string, CVarWrapper) {
+            applyDistanceSettings();
         });
 
     cvarManager->registerCvar("leo_proxchat_full_vol_distance", "1500", "Full volume distance", true, true, 0, true, 5000)
-        .addOnValueChanged([this](std::string, CVarWrapper cvar) {
-            if (audioEngine_) {
-                auto& sa = audioEngine_->getSpatialAudio();
-                auto outerCvar = cvarManager->getCvar("leo_proxchat_max_distance");
-                if (outerCvar) sa.setDistanceParams(cvar.getFloatValue(), outerCvar.getFloatValue());
-            }
+        .addOnValueChanged([this](std::string, CVarWrapper) {
+            applyDistanceSettings();
         });
 
     cvarManager->registerCvar("leo_proxchat_3d_audio", "1", "Enable 3D spatial audio", true, true, 0, true, 1)
         .addOnValueChanged([this](std::string, CVarWrapper cvar) {
-            if (audioEngine_) audioEngine_->getSpatialAudio().setEnabled(cvar.getBoolValue());
+            if (audioEngine_) audioEngine_->setSpatialEnabled(cvar.getBoolValue());
+        });
+
+    cvarManager->registerCvar("leo_proxchat_occlusion", "1", "Muffle voices behind goal walls, posts and the arena shell", true, true, 0, true, 1)
+        .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+            if (audioEngine_) audioEngine_->setOcclusionEnabled(cvar.getBoolValue());
         });
 
     cvarManager->registerCvar("leo_proxchat_rolloff", "10", "Distance rolloff factor (1-20)", true, true, 1, true, 20)
+        .addOnValueChanged([this](std::string, CVarWrapper) {
+            applyDistanceSettings();
+        });
+
+    cvarManager->registerCvar("leo_proxchat_distance_model", "0", "Distance curve: 0 = soft, 1 = inverse, 2 = linear, 3 = exponential, 4 = custom", true, true, 0, true, 4)
+        .addOnValueChanged([this](std::string, CVarWrapper) {
+            applyDistanceSettings();
+        });
+
+    cvarManager->registerCvar("leo_proxchat_distance_curve", "1 0.8 0.5 0.25 0.1", "Custom distance curve: up to 16 gains (0-1) spread from full volume distance to max distance")
+        .addOnValueChanged([this](std::string, CVarWrapper) {
+            applyDistanceSettings();
+        });
+
+    cvarManager->registerCvar("leo_proxchat_renderer", "0", "3D renderer: 0 = parametric, 1 = measured HRIR (needs an .lhrir file), 2 = Ambisonic, 3 = speakers (VBAP)", true, true, 0, true, 3)
         .addOnValueChanged([this](std::string, CVarWrapper cvar) {
-            if (audioEngine_) {
-                auto& sa = audioEngine_->getSpatialAudio();
-                auto innerCvar = cvarManager->getCvar("leo_proxchat_full_vol_distance");
-                auto outerCvar = cvarManager->getCvar("leo_proxchat_max_distance");
-                if (innerCvar && outerCvar)
-                    sa.setDistanceParams(innerCvar.getFloatValue(), outerCvar.getFloatValue(), cvar.getFloatValue() / 10.0f);
-            }
+            applyRenderer(cvar.getIntValue());
+        });
+
+    cvarManager->registerCvar("leo_proxchat_speaker_layout", "1", "Speaker layout for the speakers renderer: 0 = quad, 1 = 5.1, 2 = 7.1", true, true, 0, true, 2)
+        .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+            applySpeakerLayout(cvar.getIntValue());
+        });
+
+    cvarManager->registerCvar("leo_proxchat_hrir_file", "", "HRIR dataset path (empty = <data>/leoproxchat/default.lhrir)")
+        .addOnValueChanged([this](std::string, CVarWrapper) {
+            auto rendererCvar = cvarManager->getCvar("leo_proxchat_renderer");
+            if (audioEngine_ && rendererCvar && rendererCvar.getIntValue() == 1) loadHrirDataset();
+        });
+
+    cvarManager->registerCvar("leo_proxchat_audio_threads", "2", "Worker threads for per-peer decode and 3D rendering (0 = audio threads only)", true, true, 0, true, 8)
+        .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+            if (audioEngine_) audioEngine_->setWorkerThreads(cvar.getIntValue());
         });
 
     cvarManager->registerCvar("leo_proxchat_input_device", "-1", "Input audio device ID");
@@ -228,15 +251,22 @@ void LeoProximityChat::applyCVarSettings() {
     auto mutedCvar = getCvar("leo_proxchat_mic_muted");
     if (mutedCvar) audioEngine_->setMicMuted(mutedCvar.getBoolValue());
 
-    auto& sa = audioEngine_->getSpatialAudio();
     auto spatialCvar = getCvar("leo_proxchat_3d_audio");
-    if (spatialCvar) sa.setEnabled(spatialCvar.getBoolValue());
+    if (spatialCvar) audioEngine_->setSpatialEnabled(spatialCvar.getBoolValue());
+
+    applyDistanceSettings();
+
+    auto occlusionCvar = getCvar("leo_proxchat_occlusion");
+    if (occlusionCvar) audioEngine_->setOcclusionEnabled(occlusionCvar.getBoolValue());
+
+    auto layoutCvar = getCvar("leo_proxchat_speaker_layout");
+    if (layoutCvar) applySpeakerLayout(layoutCvar.getIntValue());
 
-    auto innerCvar = getCvar("leo_proxchat_full_vol_distance");
-    auto outerCvar = getCvar("leo_proxchat_max_distance");
-    auto rollCvar  = getCvar("leo_proxchat_rolloff");
-    if (innerCvar && outerCvar && rollCvar)
-        sa.setDistanceParams(innerCvar.getFloatValue(), outerCvar.getFloatValue(), rollCvar.getFloatValue() / 10.0f);
+    auto rendererCvar = getCvar("leo_proxchat_renderer");
+    if (rendererCvar) applyRenderer(rendererCvar.getIntValue());
+
+    auto threadsCvar = getCvar("leo_proxchat_audio_threads");
+    if (threadsCvar) audioEngine_->setWorkerThreads(threadsCvar.getIntValue());
 
     auto pttKeyCvar = getCvar("leo_proxchat_ptt_key");
     if (pttKeyCvar) pttKeyName_ = pttKeyCvar.getStringValue();
@@ -315,6 +345,72 @@ void LeoProximityChat::initSubsystems() {
     subsystemsInitialized_ = true;
 }
 
+void LeoProximityChat::loadHrirDataset() {
+    if (!audioEngine_) return;
+
+    std::string path;
+    auto fileCvar = cvarManager->getCvar("leo_proxchat_hrir_file");
+    if (fileCvar) path = fileCvar.getStringValue();
+    if (path.empty()) {
+        path = (gameWrapper->GetDataFolder() / "leoproxchat" / "default.lhrir").string();
+    }
+
+    if (audioEngine_->loadHrirDataset(path)) {
+        log("Loaded HRIR dataset: " + path);
+    } else {
+        logError(audioEngine_->getLastError() + " - using parametric 3D audio");
+    }
+}
+
+void LeoProximityChat::applyRenderer(int mode) {
+    if (!audioEngine_) return;
+
+    if (mode == 1 && !audioEngine_->isHrirLoaded()) loadHrirDataset();
+    audioEngine_->setRenderer(mode == 1 ? AudioEngine::Renderer::Hrir
+                            : mode == 2 ? AudioEngine::Renderer::Ambisonic
+                            : mode == 3 ? AudioEngine::Renderer::Speakers
+                            : AudioEngine::Renderer::Parametric);
+}
+
+void LeoProximityChat::applySpeakerLayout(int layout) {
+    if (!audioEngine_) return;
+
+    audioEngine_->setSpeakerLayout(layout == 0 ? VbapRenderer::Layout::Quad
+                                 : layout == 2 ? VbapRenderer::Layout::Surround71
+                                 : VbapRenderer::Layout::Surround51);
+}
+
+void LeoProximityChat::applyDistanceSettings() {
+    if (!audioEngine_) return;
+
+    DistanceModel::Settings settings = audioEngine_->getDistanceModel();
+
+    auto innerCvar = cvarManager->getCvar("leo_proxchat_full_vol_distance");
+    auto outerCvar = cvarManager->getCvar("leo_proxchat_max_distance");
+    auto rollCvar  = cvarManager->getCvar("leo_proxchat_rolloff");
+    auto modelCvar = cvarManager->getCvar("leo_proxchat_distance_model");
+    auto curveCvar = cvarManager->getCvar("leo_proxchat_distance_curve");
+    if (innerCvar) settings.inner = innerCvar.getFloatValue();
+    if (outerCvar) settings.outer = outerCvar.getFloatValue();
+    if (rollCvar)  settings.rolloff = rollCvar.getFloatValue() / 10.0f;
+    if (modelCvar) settings.curve = static_cast<DistanceModel::Curve>(std::clamp(modelCvar.getIntValue(), 0, 4));
+
+    // Custom curve: gains separated by spaces or commas, extra points ignored
+    settings.points.fill(0.0f);
+    settings.pointCount = 0;
+    if (curveCvar) {
+        std::string text = curveCvar.getStringValue();
+        std::replace(text.begin(), text.end(), ',', ' ');
+        std::istringstream in(text);
+        float gain;
+        while (settings.pointCount < DistanceModel::MAX_CURVE_POINTS && in >> gain) {
+            settings.points[settings.pointCount++] = std::clamp(gain, 0.0f, 1.0f);
+        }
+    }
+
+    audioEngine_->setDistanceModel(settings);
+}
+
 void LeoProximityChat::shutdownSubsystems() {
     if (networkManager_) {
         networkManager_->disconnect();
@@ -337,27 +433,30 @@ void LeoProximityChat::onTick(std::string /*eventName*/) {
     if (!enabled_ || !inMatch_) return;
 
     // ── Detect demolition: car is null while in a match ──────────────────
+    // (only in flavors where demolition silences the player, see BuildFlavor)
     bool demolished = false;
-    try {
-        auto car = gameWrapper->GetLocalCar();
-        if (!car) {
+    if constexpr (BuildFlavor::Active::DEMOLITION_SILENCES) {
+        try {
+            auto car = gameWrapper->GetLocalCar();
+            if (!car) {
+                demolished = true;
+            }
+        } catch (...) {
             demolished = true;
         }
-    } catch (...) {
-        demolished = true;
     }
     isDemolished_ = demolished;
 
     // Use CAMERA position/rotation for 3D audio listener (not the car)
     Protocol::Vec3 camPos = getCameraPosition_GameThread();
-    int camYaw = getCameraYaw_GameThread();
+    Protocol::Rot camRot = getCameraRotation_GameThread();
 
     // Use car position for the outgoing audio packet (other players hear you from your car)
     Protocol::Vec3 carPos = getLocalCarPosition_GameThread();
 
     if (audioEngine_) {
         audioEngine_->setDemolished(demolished);
-        audioEngine_->setListenerState(camPos, camYaw);
+        audioEngine_->setListenerState(camPos, camRot);
         audioEngine_->setLocalPosition(carPos);
     }
 
@@ -569,13 +668,21 @@ Protocol::Vec3 LeoProximityChat::getLocalCarPosition_GameThread() const {
 }
 
 int LeoProximityChat::getLocalCarYaw_GameThread() const {
-    if (!gameWrapper) return 0;
+    return getLocalCarRotation_GameThread().yaw;
+}
+
+Protocol::Rot LeoProximityChat::getLocalCarRotation_GameThread() const {
+    if (!gameWrapper) return {};
     try {
         auto car = gameWrapper->GetLocalCar();
-        if (!car) return 0;
+        if (!car) return {};
         Rotator rot = car.GetRotation();
-        return rot.Yaw;
-    } catch (...) { return 0; }
+        Protocol::Rot out;
+        out.pitch = rot.Pitch;
+        out.yaw   = rot.Yaw;
+        out.roll  = rot.Roll;
+        return out;
+    } catch (...) { return {}; }
 }
 
 Protocol::Vec3 LeoProximityChat::getCameraPosition_GameThread() const {
@@ -594,17 +701,22 @@ Protocol::Vec3 LeoProximityChat::getCameraPosition_GameThread() const {
     }
 }
 
-int LeoProximityChat::getCameraYaw_GameThread() const {
-    if (!gameWrapper) return getLocalCarYaw_GameThread();
+Protocol::Rot LeoProximityChat::getCameraRotation_GameThread() const {
+    if (!gameWrapper) return getLocalCarRotation_GameThread();
     try {
         CameraWrapper cam = gameWrapper->GetCamera();
         if (cam.IsNull()) {
-            return getLocalCarYaw_GameThread();
+            return getLocalCarRotation_GameThread();
         }
+        // Full POV rotation: pitch matters for aerial players above/below the camera
         POV pov = cam.GetPOV();
-        return pov.rotation.Yaw;
+        Protocol::Rot out;
+        out.pitch = pov.rotation.Pitch;
+        out.yaw   = pov.rotation.Yaw;
+        out.roll  = pov.rotation.Roll;
+        return out;
     } catch (...) {
-        return getLocalCarYaw_GameThread();
+        return getLocalCarRotation_GameThread();
     }
 }
 
@@ -848,6 +960,67 @@ void LeoProximityChat::renderProximitySettings() {
             ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
                 "Higher = sharper volume dropoff with distance.");
         }
+
+        auto modelCvar = cvarManager->getCvar("leo_proxchat_distance_model");
+        if (modelCvar) {
+            int model = modelCvar.getIntValue();
+            if (ImGui::Combo("Distance Curve", &model, "Soft\0Inverse\0Linear\0Exponential\0Custom\0")) {
+                modelCvar.setValue(model);
+            }
+            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                model == 4 ? "Custom: gains from leo_proxchat_distance_curve, full volume -> max distance."
+                           : "Shape of the volume dropoff between the two distances.");
+        }
+
+        auto occlusionCvar = cvarManager->getCvar("leo_proxchat_occlusion");
+        if (occlusionCvar) {
+            bool occlusion = occlusionCvar.getBoolValue();
+            if (ImGui::Checkbox("Arena Occlusion", &occlusion)) {
+                occlusionCvar.setValue(occlusion);
+            }
+            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                "Voices behind goal walls and posts sound quieter and muffled.");
+        }
+
+        auto rendererCvar = cvarManager->getCvar("leo_proxchat_renderer");
+        if (rendererCvar) {
+            int mode = rendererCvar.getIntValue();
+            if (ImGui::Combo("Renderer", &mode, "Parametric\0Measured HRIR\0Ambisonic\0Speakers (VBAP)\0")) {
+                rendererCvar.setValue(mode);
+            }
+            if (mode == 1 && audioEngine_ && !audioEngine_->isHrirLoaded()) {
+                ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f),
+                    "No HRIR dataset loaded. Set leo_proxchat_hrir_file. Using parametric 3D audio.");
+            } else if (mode == 1) {
+                ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                    "Convolves voices with a measured head response (.lhrir file).");
+            } else if (mode == 2) {
+                ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                    "Mixes all voices into one sound field, decoded once (cheapest in full lobbies).");
+            } else if (mode == 3) {
+                auto layoutCvar = cvarManager->getCvar("leo_proxchat_speaker_layout");
+                if (layoutCvar) {
+                    int layout = layoutCvar.getIntValue();
+                    if (ImGui::Combo("Speaker Layout", &layout, "Quad\0" "5.1\0" "7.1\0")) {
+                        layoutCvar.setValue(layout);
+                    }
+                }
+                if (audioEngine_ && audioEngine_->isStreaming() &&
+                    audioEngine_->getOutputChannels() <= 2) {
+                    ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f),
+                        "Output device has too few channels for this layout. Using parametric 3D audio.");
+                } else {
+                    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                        "Pans voices across your surround speakers instead of simulating headphones.");
+                }
+            }
+        }
+
+        if (audioEngine_) {
+            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                "Audio callback load: %.0f%% (distant voices are simplified above 50%%)",
+                audioEngine_->getCallbackLoad() * 100.0f);
+        }
     }
 }
 
@@ -914,6 +1087,17 @@ void LeoProximityChat::renderStatusPanel() {
         ImGui::Text("Streaming: %s", audioEngine_->isStreaming() ? "Active" : "Stopped");
         ImGui::Text("Speaking: %s", audioEngine_->isSpeaking() ? "Yes" : "No");
 
+        auto buffers = audioEngine_->getJitterStats();
+        if (!buffers.empty()) {
+            ImGui::Spacing();
+            ImGui::Text("Voice Buffers (%zu):", buffers.size());
+            for (const auto& b : buffers) {
+                ImGui::BulletText("%s: %.0f ms (target %.0f, jitter %.0f) | %u sped up, %u slowed, %u concealed, %u recovered | %u lost, %u reordered, %u late",
+                    b.steamId.c_str(), b.depthMs, b.targetMs, b.jitterMs, b.accelerated, b.expanded, b.concealed,
+                    b.recovered, b.lost, b.reordered, b.late);
+            }
+        }
+
         std::string audioErr = audioEngine_->getLastError();
         if (!audioErr.empty()) {
             ImGui::TextColored(ImVec4(1, 0.6f, 0, 1), "Audio: %s", audioErr.c_str());
@@ -926,6 +1110,7 @@ void LeoProximityChat::renderStatusPanel() {
         ImGui::Text("Network: %s", networkManager_->getStateString().c_str());
         ImGui::Text("Sent: %.1f KB", networkManager_->getBytesSent() / 1024.0f);
         ImGui::Text("Received: %.1f KB", networkManager_->getBytesReceived() / 1024.0f);
+        ImGui::Text("Audio packets: v%d", networkManager_->getAudioVersion());
 
         auto peers = networkManager_->getConnectedPeers();
         ImGui::Spacing();
@@ -41,6 +41,10 @@ private:
 
     void registerCVars();
     void applyCVarSettings();
+    void loadHrirDataset();
+    void applyRenderer(int mode);
+    void applySpeakerLayout(int layout);
+    void applyDistanceSettings();
 
     void initSubsystems();
     void shutdownSubsystems();
@@ -54,8 +58,9 @@ private:
     std::string getLocalPlayerName_GameThread() const;
     Protocol::Vec3 getLocalCarPosition_GameThread() const;
     int getLocalCarYaw_GameThread() const;
+    Protocol::Rot getLocalCarRotation_GameThread() const;
     Protocol::Vec3 getCameraPosition_GameThread() const;
-    int getCameraYaw_GameThread() const;
+    Protocol::Rot getCameraRotation_GameThread() const;
     void refreshCachedGameState();
 
     // ── ImGui helpers ────────────────────────────────────────────────────
@@ -0,0 +1,27 @@
+#include "MasterBus.h"
+#include "SpatialKernels.h"
+#include <algorithm>
+
+MasterBus::MasterBus()
+    : sendMix_(MAX_BLOCK, 0.0f), returnL_(MAX_BLOCK, 0.0f), returnR_(MAX_BLOCK, 0.0f) {
+}
+
+void MasterBus::beginBlock() {
+    std::fill(sendMix_.begin(), sendMix_.end(), 0.0f);
+}
+
+void MasterBus::addReverb(float* stereo, int n) {
+    n = std::min(n, MAX_BLOCK);
+    reverb_.processBlock(sendMix_.data(), returnL_.data(), returnR_.data(), n);
+    SpatialKernels::active().accumulateStereo(stereo, returnL_.data(), returnR_.data(), n);
+}
+
+void MasterBus::finish(float* out, int frames, int channels) {
+    limiter_.process(out, frames, channels);
+}
+
+void MasterBus::clear() {
+    reverb_.clear();
+    limiter_.reset();
+    std::fill(sendMix_.begin(), sendMix_.end(), 0.0f);
+}
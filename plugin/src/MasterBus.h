@@ -0,0 +1,56 @@
+#pragma once
+#include "OutputLimiter.h"
+#include "Protocol.h"
+#include "ReverbEngine.h"
+#include <vector>
+
+/**
+ * The end of the playback mix, shared by AudioEngine and the offline
+ * scene renderer (bench/SceneRender.cpp) so both run the same code.
+ *
+ * Per callback block:
+ *
+ *   beginBlock()      : clear the summed reverb send
+ *   sendMix()         : peers add their reverb sends here
+ *   addReverb()       : one late-reverb pass on the summed sends, added to
+ *                       the stereo mix
+ *   finish()          : look-ahead limiter on the interleaved output, in
+ *                       place (OutputLimiter::LATENCY frames of delay)
+ *
+ * Not thread-safe: runs on the audio thread.
+ */
+class MasterBus {
+public:
+    static constexpr int MAX_BLOCK = Protocol::FRAME_SIZE;
+
+    MasterBus();
+
+    MasterBus(const MasterBus&) = delete;
+    MasterBus& operator=(const MasterBus&) = delete;
+
+    /** Start a block: zero the send mix. */
+    void beginBlock();
+
+    /** Mono reverb send summed over all peers, MAX_BLOCK samples. */
+    float* sendMix() { return sendMix_.data(); }
+
+    /**
+     * Run the shared reverb on the first n send samples and add its return
+     * to interleaved stereo. Runs even with no active talkers so the tail
+     * decays naturally.
+     */
+    void addReverb(float* stereo, int n);
+
+    /** Limit frames × channels interleaved samples in place (OutputLimiter). */
+    void finish(float* out, int frames, int channels);
+
+    /** Drop the reverb tail and the limiter's delayed audio. */
+    void clear();
+
+private:
+    ReverbEngine reverb_;
+    OutputLimiter limiter_;
+    std::vector<float> sendMix_;   // Mono, summed sends
+    std::vector<float> returnL_;
+    std::vector<float> returnR_;
+};
@@ -68,12 +68,14 @@ void NetworkManager::joinRoom(const std::string& matchId, const std::string& pla
     currentMatchId_   = matchId;
     localPlayerName_  = playerName;
     localSteamId_     = steamId;
+    audioVersion_     = Protocol::AUDIO_VERSION_BASIC;   // Until the welcome acknowledges more
 
     json msg = {
-        {"type",       "join"},
-        {"matchId",    matchId},
-        {"playerName", playerName},
-        {"steamId",    steamId}
+        {"type",         "join"},
+        {"matchId",      matchId},
+        {"playerName",   playerName},
+        {"steamId",      steamId},
+        {"audioVersion", Protocol::AUDIO_VERSION_SEQUENCED}
     };
 
     webSocket_.send(msg.dump());
@@ -97,6 +99,13 @@ void NetworkManager::leaveRoom() {
 void NetworkManager::sendAudioPacket(const std::vector<uint8_t>& packet) {
     if (state_ != ConnectionState::Connected || currentMatchId_.empty()) return;
 
+    // A relay that did not acknowledge sequenced audio gets version 1
+    if (audioVersion_ < Protocol::AUDIO_VERSION_SEQUENCED &&
+        !packet.empty() && packet[0] == Protocol::MSG_AUDIO_SEQUENCED) {
+        sendAudioPacket(Protocol::unsequencedAudioPacket(packet));
+        return;
+    }
+
     // Send as binary
     std::string binaryData(reinterpret_cast<const char*>(packet.data()), packet.size());
     webSocket_.sendBinary(binaryData);
@@ -164,7 +173,10 @@ void NetworkManager::handleTextMessage(const std::string& text) {
         std::string type = msg.value("type", "");
 
         if (type == "welcome") {
-            // Server acknowledged our join, gives us list of existing peers
+            // Server acknowledged our join, gives us list of existing peers and
+            // the audio version it relays (older servers send none: version 1)
+            audioVersion_ = std::clamp(msg.value("audioVersion", Protocol::AUDIO_VERSION_BASIC),
+                                       Protocol::AUDIO_VERSION_BASIC, Protocol::AUDIO_VERSION_SEQUENCED);
             if (msg.contains("peers") && msg["peers"].is_array()) {
                 std::lock_guard<std::mutex> lock(peersMutex_);
                 for (const auto& peer : msg["peers"]) {
@@ -65,8 +65,11 @@ public:
     const std::string& getCurrentMatchId() const { return currentMatchId_; }
     const std::string& getLocalSteamId() const { return localSteamId_; }
 
+    /** Audio packet version the relay acknowledged for this room (Protocol::AUDIO_VERSION_*). */
+    int getAudioVersion() const { return audioVersion_.load(); }
+
     // ── Send ─────────────────────────────────────────────────────────────
-    /** Send a binary audio packet. Thread-safe. */
+    /** Send a binary audio packet (sequenced ones go out as version 1 if the relay predates them). Thread-safe. */
     void sendAudioPacket(const std::vector<uint8_t>& packet);
 
     /** Send a position update. */
@@ -111,6 +114,7 @@ private:
     std::string currentMatchId_;
     std::string localSteamId_;
     std::string localPlayerName_;
+    std::atomic<int> audioVersion_{Protocol::AUDIO_VERSION_BASIC};
 
     // Peers
     mutable std::mutex peersMutex_;
@@ -0,0 +1,108 @@
+#include "OutputLimiter.h"
+#include "Protocol.h"
+#include "SpatialKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+OutputLimiter::OutputLimiter()
+    : releaseCoeff_(1.0f - std::exp(-static_cast<float>(SUB_BLOCK) /
+                                    (RELEASE_MS * 0.001f * Protocol::SAMPLE_RATE))),
+      line_(static_cast<size_t>(LATENCY) * MAX_CHANNELS, 0.0f) {
+    reset();
+}
+
+void OutputLimiter::reset() {
+    std::fill(line_.begin(), line_.end(), 0.0f);
+    linePos_ = 0;
+    fill_ = 0;
+    peak_ = 0.0f;
+    needs_.fill(1.0f);
+    minimums_.fill(1.0f);
+    gainStart_ = 1.0f;
+    gainEnd_ = 1.0f;
+}
+
+void OutputLimiter::process(float* io, int frames, int channels) {
+    channels = std::clamp(channels, 1, MAX_CHANNELS);
+    if (channels != channels_) {
+        channels_ = channels;
+        reset();
+    }
+
+    while (frames > 0) {
+        // Chunks never cross a sub-block, so they never wrap the delay line
+        const int n = std::min(frames, SUB_BLOCK - fill_);
+        processChunk(io, n);
+        io += static_cast<size_t>(n) * channels_;
+        frames -= n;
+
+        if (fill_ == SUB_BLOCK) {
+            endSubBlock();
+        }
+    }
+}
+
+void OutputLimiter::processChunk(float* io, int frames) {
+    const auto& k = SpatialKernels::active();
+    const int samples = frames * channels_;
+    float* slot = line_.data() + static_cast<size_t>(linePos_) * channels_;
+
+    peak_ = std::max(peak_, k.peak(io, samples));
+
+    std::memcpy(delayed_.data(), slot, samples * sizeof(float));
+    std::memcpy(slot, io, samples * sizeof(float));
+
+    if (gainStart_ == gainEnd_) {
+        if (gainEnd_ == 1.0f) {
+            std::memcpy(io, delayed_.data(), samples * sizeof(float));
+        } else {
+            k.scale(io, delayed_.data(), gainEnd_, samples);
+        }
+    } else {
+        const float step = (gainEnd_ - gainStart_) / SUB_BLOCK;
+        for (int f = 0; f < frames; f++) {
+            const float g = gainStart_ + step * (fill_ + f + 1);
+            const float* src = delayed_.data() + f * channels_;
+            float* dst = io + f * channels_;
+            for (int c = 0; c < channels_; c++) {
+                dst[c] = src[c] * g;
+            }
+        }
+    }
+
+    fill_ += frames;
+    linePos_ += frames;
+    if (linePos_ == LATENCY) {
+        linePos_ = 0;
+    }
+}
+
+void OutputLimiter::endSubBlock() {
+    const float need = peak_ > CEILING ? CEILING / peak_ : 1.0f;
+
+    std::copy(needs_.begin() + 1, needs_.end(), needs_.begin());
+    needs_.back() = need;
+    std::copy(minimums_.begin() + 1, minimums_.end(), minimums_.begin());
+    minimums_.back() = *std::min_element(needs_.begin(), needs_.end());
+
+    float target = 0.0f;
+    for (float m : minimums_) {
+        target += m;
+    }
+    target /= ATTACK_BLOCKS;
+
+    // Attack is already smoothed by the look-ahead average; release slowly
+    float gain = target;
+    if (target > gainEnd_) {
+        gain = gainEnd_ + releaseCoeff_ * (target - gainEnd_);
+        if (target - gain < 1e-4f) {
+            gain = target;   // Settle, so unity takes the copy path again
+        }
+    }
+
+    gainStart_ = gainEnd_;
+    gainEnd_ = gain;
+    peak_ = 0.0f;
+    fill_ = 0;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <array>
+#include <vector>
+
+/**
+ * Look-ahead peak limiter for the interleaved output of the mix bus.
+ *
+ * The signal is delayed by LATENCY frames; meanwhile the gain needed to
+ * keep each SUB_BLOCK of the input under CEILING is known ahead of time,
+ * so the gain can come down before the peak arrives instead of clipping
+ * it:
+ *
+ *   peak    : max |x| of each sub-block over all channels (SIMD kernel,
+ *             SpatialKernels::peak) → need = min(1, CEILING / peak)
+ *   attack  : minimum over the last ATTACK_BLOCKS + 1 sub-blocks, then a
+ *             box average of the last ATTACK_BLOCKS minimums (every
+ *             minimum in the average covers the sub-block about to be
+ *             output, so the ramp is down in time, yet it spreads over
+ *             the whole look-ahead window instead of stepping)
+ *   release : one-pole back towards unity (RELEASE_MS)
+ *
+ * Gains are evaluated at sub-block boundaries and ramp linearly inside a
+ * sub-block. While the gain sits at unity (the mix is below the ceiling)
+ * a sub-block costs one peak scan and a copy through the delay line, and
+ * the output is the input unchanged, only LATENCY frames later.
+ *
+ * Not thread-safe: runs on the audio thread.
+ */
+class OutputLimiter {
+public:
+    static constexpr int   MAX_CHANNELS  = 8;
+    static constexpr float CEILING       = 0.891f;   // -1 dBFS
+    static constexpr int   SUB_BLOCK     = 16;       // Frames per gain evaluation
+    static constexpr int   ATTACK_BLOCKS = 4;        // Look-ahead window: 64 frames (1.3 ms)
+    static constexpr float RELEASE_MS    = 80.0f;
+    /** Output delay: the attack window, one sub-block for the boundary ramp and one being filled */
+    static constexpr int   LATENCY       = (ATTACK_BLOCKS + 1) * SUB_BLOCK;
+
+    OutputLimiter();
+
+    OutputLimiter(const OutputLimiter&) = delete;
+    OutputLimiter& operator=(const OutputLimiter&) = delete;
+
+    /**
+     * Limit frames × channels interleaved samples in place. A different
+     * channel count than the last call resets the limiter.
+     */
+    void process(float* io, int frames, int channels);
+
+    /** Drop the delayed audio and return to unity gain. */
+    void reset();
+
+    /** Gain at the end of the last output sub-block (1 = not limiting). */
+    float gain() const { return gainEnd_; }
+
+private:
+    /** Pass frames of the current sub-block through the delay line at the current gains. */
+    void processChunk(float* io, int frames);
+
+    /** The input sub-block just filled up: derive the next boundary gain. */
+    void endSubBlock();
+
+    int channels_ = 2;
+    float releaseCoeff_;   // Per sub-block
+
+    // Delay line: LATENCY frames, interleaved; in and out share the slot
+    std::vector<float> line_;
+    int linePos_ = 0;      // Frame index, always at a sub-block start + fill_
+    int fill_ = 0;         // Frames of the current input sub-block so far
+    float peak_ = 0.0f;    // Peak of the current input sub-block
+
+    // Needs of the last ATTACK_BLOCKS + 1 input sub-blocks, oldest first
+    std::array<float, ATTACK_BLOCKS + 1> needs_{};
+    // Sliding minimums of the last ATTACK_BLOCKS, oldest first
+    std::array<float, ATTACK_BLOCKS> minimums_{};
+
+    // Boundary gains around the output sub-block
+    float gainStart_ = 1.0f;
+    float gainEnd_   = 1.0f;
+
+    std::array<float, SUB_BLOCK * MAX_CHANNELS> delayed_{};
+};
@@ -0,0 +1,88 @@
+#include "PacketReorder.h"
+#include <utility>
+
+void PacketReorder::push(Protocol::AudioPacket& pkt) {
+    if (!started_) {
+        restart(pkt);
+        return;
+    }
+
+    const int ahead = static_cast<int16_t>(static_cast<uint16_t>(pkt.sequence - nextSeq_));
+    if (ahead < 0) {
+        // Its slot is gone, unless the sender paused before it: then the
+        // slots gone by were concealment of silence and the stream goes on
+        // from here. Far behind the window, only a timestamp from before
+        // the stream started says the sender restarted (its clock origin is
+        // random); one within the stream is a straggler, however late
+        const uint32_t due = nextTimestamp_ + static_cast<uint32_t>(ahead * Protocol::FRAME_SIZE);
+        const bool afterPause = static_cast<int32_t>(pkt.timestamp - due) > 0;
+        const bool beforeStart = static_cast<int32_t>(pkt.timestamp - startTimestamp_) < 0;
+        if (afterPause || (ahead < -SLOTS && beforeStart)) {
+            restart(pkt);
+        } else {
+            late_++;
+        }
+        return;
+    }
+    if (ahead >= SLOTS) {
+        restart(pkt);   // Longer outage than the window, or a restarted sender
+        return;
+    }
+
+    Slot& slot = slots_[pkt.sequence % SLOTS];
+    if (slot.filled) return;   // Duplicate
+    if (static_cast<int16_t>(static_cast<uint16_t>(pkt.sequence - newestSeq_)) < 0) {
+        reordered_++;
+    } else {
+        newestSeq_ = pkt.sequence;
+    }
+    slot.packet = std::move(pkt);
+    slot.filled = true;
+    held_++;
+}
+
+bool PacketReorder::pop(Protocol::AudioPacket& out) {
+    Slot& slot = slots_[nextSeq_ % SLOTS];
+    if (!slot.filled) return false;
+
+    std::swap(out, slot.packet);   // Keeps both buffers allocated for reuse
+    slot.filled = false;
+    held_--;
+    nextSeq_++;
+    nextTimestamp_ = out.timestamp + Protocol::FRAME_SIZE;
+    return true;
+}
+
+const Protocol::AudioPacket* PacketReorder::following() const {
+    const uint16_t seq = static_cast<uint16_t>(nextSeq_ + 1);
+    const Slot& slot = slots_[seq % SLOTS];
+    return slot.filled ? &slot.packet : nullptr;
+}
+
+void PacketReorder::skip() {
+    if (!started_) return;
+    nextSeq_++;
+    nextTimestamp_ += Protocol::FRAME_SIZE;
+    lost_++;
+}
+
+void PacketReorder::reset() {
+    for (auto& slot : slots_) slot.filled = false;
+    held_ = 0;
+    started_ = false;
+}
+
+void PacketReorder::restart(Protocol::AudioPacket& pkt) {
+    late_ += static_cast<uint32_t>(held_);
+    reset();
+    started_ = true;
+    nextSeq_ = pkt.sequence;
+    nextTimestamp_ = pkt.timestamp;
+    startTimestamp_ = pkt.timestamp;
+    newestSeq_ = pkt.sequence;
+
+    Slot& slot = slots_[pkt.sequence % SLOTS];
+    slot.packet = std::move(pkt);
+    slot.filled = true;
+    held_ = 1;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "Protocol.h"
+#include <array>
+#include <cstdint>
+
+/**
+ * Receive-side reorder stage of one sequenced peer: puts its packets back
+ * in sequence order and tells its decode job when a sequence number is
+ * missing, so it is concealed exactly once.
+ *
+ *   in order : pop() releases the next packet as soon as it is here
+ *   held     : packets after a missing one wait in a window of SLOTS; the
+ *              gap is known (missing()) from then on, and the caller skip()s
+ *              the slot when playout cannot wait for it any longer
+ *   recovery : while the next one is missing, following() is the packet
+ *              after it, whose in-band FEC may carry the missing frame
+ *   late     : a packet for a slot already skipped or released is dropped,
+ *              however far behind it is, while its timestamp fits the stream
+ *   pause    : a late-looking packet whose timestamp lies beyond the slots
+ *              gone by (the sender paused, the receiver concealed into the
+ *              silence) starts the stream again from it, as does one too
+ *              far ahead of the window (long outage) or far behind it with
+ *              a timestamp from before the stream started (sender restart)
+ *
+ * Not thread-safe: one instance per peer, used by its decode job.
+ */
+class PacketReorder {
+public:
+    static constexpr int SLOTS = 32;   // Packets held behind a missing one (640 ms)
+
+    /** Take a sequenced packet (moved from if it is kept). */
+    void push(Protocol::AudioPacket& pkt);
+
+    /** Move the next packet in order into out; false if it has not arrived. */
+    bool pop(Protocol::AudioPacket& out);
+
+    /** The next packet is missing while a later one is here (lost, or later than that one). */
+    bool missing() const { return held_ > 0 && !slots_[nextSeq_ % SLOTS].filled; }
+
+    /** The packet right after the next one, if it is here (its FEC data may rebuild a missing next one). */
+    const Protocol::AudioPacket* following() const;
+
+    /** Give up on the next packet: its slot was concealed. */
+    void skip();
+
+    /** Forget the stream; the next packet starts it again. */
+    void reset();
+
+    // Counts since construction
+    uint32_t reordered() const { return reordered_; }   // Arrived after a later one, in time
+    uint32_t late() const { return late_; }             // Dropped: its slot had played
+    uint32_t lost() const { return lost_; }             // Slots skipped
+
+private:
+    struct Slot {
+        Protocol::AudioPacket packet;
+        bool filled = false;
+    };
+
+    /** Start the stream at pkt, dropping anything held. */
+    void restart(Protocol::AudioPacket& pkt);
+
+    std::array<Slot, SLOTS> slots_;   // Indexed by sequence % SLOTS, all within [nextSeq_, nextSeq_ + SLOTS)
+    bool started_ = false;
+    uint16_t nextSeq_ = 0;
+    uint32_t nextTimestamp_ = 0;      // Of nextSeq_ if no pause comes before it
+    uint32_t startTimestamp_ = 0;     // Of the packet the stream started at
+    uint16_t newestSeq_ = 0;          // Highest sequence number pushed
+    int held_ = 0;                    // Filled slots
+
+    uint32_t reordered_ = 0;
+    uint32_t late_ = 0;
+    uint32_t lost_ = 0;
+};
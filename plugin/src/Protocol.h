@@ -1,5 +1,8 @@
 #pragma once
 #include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <chrono>
 #include <vector>
 #include <string>
 
@@ -14,16 +17,37 @@
  *   Incoming (server → plugin):
  *     [0x03] [steam_id:u64le] [pos_x:f32le] [pos_y:f32le] [pos_z:f32le] [opus_data...]
  *     Total header: 1 + 8 + 12 = 21 bytes
+ *
+ * Sequenced audio (version 2, negotiated with "audioVersion" in join/welcome):
+ *   Outgoing: [0x04] [seq:u16le] [timestamp:u32le] [pos:3×f32le] [opus_data...]   (19 bytes)
+ *   Incoming: [0x04] [steam_id:u64le] [seq:u16le] [timestamp:u32le] [pos:3×f32le] [opus_data...]   (27 bytes)
+ *
+ *   seq       : +1 per packet sent, wrapping; a gap is a lost packet
+ *   timestamp : sender sample clock (SAMPLE_RATE) of the frame's first
+ *               sample, +FRAME_SIZE per captured frame whether sent or not;
+ *               a jump larger than the seq gap is a pause in the talk spurt
+ *
+ * The relay forwards version 2 packets as version 1 (the seq and timestamp
+ * dropped) to clients that did not negotiate it, and a client whose relay
+ * did not acknowledge version 2 sends version 1.
  */
 
 namespace Protocol {
 
     // Message type byte in binary packets
     constexpr uint8_t MSG_AUDIO = 0x03;
+    constexpr uint8_t MSG_AUDIO_SEQUENCED = 0x04;
+
+    // Audio packet versions ("audioVersion" of join/welcome)
+    constexpr int AUDIO_VERSION_BASIC     = 1;                 // MSG_AUDIO only
+    constexpr int AUDIO_VERSION_SEQUENCED = 2;                 // MSG_AUDIO_SEQUENCED as well
 
     // Sizes
     constexpr size_t OUTGOING_HEADER_SIZE = 1 + 12;          // type + 3 floats
     constexpr size_t INCOMING_HEADER_SIZE = 1 + 8 + 12;      // type + steamId + 3 floats
+    constexpr size_t SEQUENCE_FIELDS_SIZE = 2 + 4;           // seq + timestamp
+    constexpr size_t OUTGOING_SEQUENCED_HEADER_SIZE = OUTGOING_HEADER_SIZE + SEQUENCE_FIELDS_SIZE;
+    constexpr size_t INCOMING_SEQUENCED_HEADER_SIZE = INCOMING_HEADER_SIZE + SEQUENCE_FIELDS_SIZE;
     constexpr size_t MAX_OPUS_FRAME_BYTES = 1024;             // Max Opus frame size
 
     // Audio constants
@@ -34,6 +58,7 @@ namespace Protocol {
     constexpr int    FRAME_SIZE       = SAMPLE_RATE * FRAME_DURATION_MS / 1000; // 960 samples
     constexpr int    OPUS_BITRATE     = 32000;                // 32 kbps - good for voice
     constexpr int    OPUS_COMPLEXITY  = 5;                    // 0-10, balanced
+    constexpr int    DEFAULT_AUDIO_WORKERS = 2;               // Pool threads for per-peer decode/render
 
     // Distance/spatial defaults (Unreal Units — RL field is ~10240 x 8192)
     constexpr float  DEFAULT_MAX_DISTANCE      = 15000.0f;   // Almost whole map audible
@@ -91,6 +116,9 @@ namespace Protocol {
         std::string senderSteamId;
         Vec3 senderPosition;
         std::vector<uint8_t> opusData;
+        bool sequenced = false;      // sequence and timestamp are valid (version 2 sender)
+        uint16_t sequence = 0;
+        uint32_t timestamp = 0;      // Sender sample clock of the first sample
     };
 
     // ─── Packet building helpers ────────────────────────────────────────
@@ -108,27 +136,66 @@ namespace Protocol {
         return packet;
     }
 
-    /** Parse an incoming binary audio packet (server → client) */
+    /** Build an outgoing sequenced audio packet (client → server, version 2) */
+    inline std::vector<uint8_t> buildOutgoingSequencedAudioPacket(
+        uint16_t sequence, uint32_t timestamp,
+        const Vec3& pos, const uint8_t* opusData, size_t opusLen)
+    {
+        std::vector<uint8_t> packet(OUTGOING_SEQUENCED_HEADER_SIZE + opusLen);
+        packet[0] = MSG_AUDIO_SEQUENCED;
+        std::memcpy(packet.data() + 1,  &sequence, 2);
+        std::memcpy(packet.data() + 3,  &timestamp, 4);
+        std::memcpy(packet.data() + 7,  &pos.x, 4);
+        std::memcpy(packet.data() + 11, &pos.y, 4);
+        std::memcpy(packet.data() + 15, &pos.z, 4);
+        std::memcpy(packet.data() + 19, opusData, opusLen);
+        return packet;
+    }
+
+    /** The version 1 form of an outgoing sequenced packet (for a relay without version 2) */
+    inline std::vector<uint8_t> unsequencedAudioPacket(const std::vector<uint8_t>& packet) {
+        if (packet.size() < OUTGOING_SEQUENCED_HEADER_SIZE || packet[0] != MSG_AUDIO_SEQUENCED) return packet;
+        std::vector<uint8_t> basic(packet.size() - SEQUENCE_FIELDS_SIZE);
+        basic[0] = MSG_AUDIO;
+        std::memcpy(basic.data() + 1, packet.data() + 1 + SEQUENCE_FIELDS_SIZE, basic.size() - 1);
+        return basic;
+    }
+
+    /** Parse an incoming binary audio packet (server → client), either version */
     inline bool parseIncomingAudioPacket(
         const uint8_t* data, size_t len, AudioPacket& out)
     {
-        if (len < INCOMING_HEADER_SIZE) return false;
-        if (data[0] != MSG_AUDIO) return false;
+        if (len < 1) return false;
+        out.sequenced = (data[0] == MSG_AUDIO_SEQUENCED);
+        if (data[0] != MSG_AUDIO && !out.sequenced) return false;
+        const size_t headerSize = out.sequenced ? INCOMING_SEQUENCED_HEADER_SIZE : INCOMING_HEADER_SIZE;
+        if (len < headerSize) return false;
 
         // Read steamId (uint64 LE)
         uint64_t steamIdNum = 0;
         std::memcpy(&steamIdNum, data + 1, 8);
         out.senderSteamId = std::to_string(steamIdNum);
 
+        // Sequence and timestamp
+        size_t offset = 9;
+        if (out.sequenced) {
+            std::memcpy(&out.sequence,  data + 9,  2);
+            std::memcpy(&out.timestamp, data + 11, 4);
+            offset += SEQUENCE_FIELDS_SIZE;
+        } else {
+            out.sequence = 0;
+            out.timestamp = 0;
+        }
+
         // Read position
-        std::memcpy(&out.senderPosition.x, data + 9,  4);
-        std::memcpy(&out.senderPosition.y, data + 13, 4);
-        std::memcpy(&out.senderPosition.z, data + 17, 4);
+        std::memcpy(&out.senderPosition.x, data + offset,     4);
+        std::memcpy(&out.senderPosition.y, data + offset + 4, 4);
+        std::memcpy(&out.senderPosition.z, data + offset + 8, 4);
 
         // Opus data
-        size_t opusLen = len - INCOMING_HEADER_SIZE;
+        size_t opusLen = len - headerSize;
         if (opusLen > 0) {
-            out.opusData.assign(data + INCOMING_HEADER_SIZE, data + len);
+            out.opusData.assign(data + headerSize, data + len);
         }
         return true;
     }
@@ -0,0 +1,92 @@
+#include "RealFft.h"
+#include <cmath>
+#include <cassert>
+#include <utility>
+
+void RealFft::init(int size) {
+    assert(size >= 4 && (size & (size - 1)) == 0);
+    size_ = size;
+    half_ = size / 2;
+
+    int bits = 0;
+    while ((1 << bits) < half_) bits++;
+    bitReverse_.resize(half_);
+    for (int i = 0; i < half_; i++) {
+        int r = 0;
+        for (int b = 0; b < bits; b++) {
+            if (i & (1 << b)) r |= 1 << (bits - 1 - b);
+        }
+        bitReverse_[i] = r;
+    }
+
+    const double pi = 3.14159265358979323846;
+    twiddles_.resize(half_ / 2);
+    for (int k = 0; k < half_ / 2; k++) {
+        double a = -2.0 * pi * k / half_;
+        twiddles_[k] = Complex(static_cast<float>(std::cos(a)), static_cast<float>(std::sin(a)));
+    }
+    splitTwiddles_.resize(half_);
+    for (int k = 0; k < half_; k++) {
+        double a = -2.0 * pi * k / size_;
+        splitTwiddles_[k] = Complex(static_cast<float>(std::cos(a)), static_cast<float>(std::sin(a)));
+    }
+    work_.assign(half_, Complex(0.0f, 0.0f));
+}
+
+void RealFft::complexFft(Complex* data, bool inverse) const {
+    const int n = half_;
+    for (int i = 0; i < n; i++) {
+        int j = bitReverse_[i];
+        if (j > i) std::swap(data[i], data[j]);
+    }
+    for (int len = 2; len <= n; len <<= 1) {
+        const int halfLen = len >> 1;
+        const int stride = n / len;
+        for (int start = 0; start < n; start += len) {
+            for (int k = 0; k < halfLen; k++) {
+                Complex w = twiddles_[k * stride];
+                if (inverse) w = std::conj(w);
+                Complex a = data[start + k];
+                Complex b = data[start + k + halfLen] * w;
+                data[start + k]           = a + b;
+                data[start + k + halfLen] = a - b;
+            }
+        }
+    }
+}
+
+void RealFft::forward(const float* in, Complex* out) {
+    // Pack even/odd samples as one half-size complex signal
+    for (int i = 0; i < half_; i++) work_[i] = Complex(in[2 * i], in[2 * i + 1]);
+    complexFft(work_.data(), false);
+
+    // Split: X[k] = E[k] + W^k O[k], with E/O recovered from Z[k], Z[N/2-k]*
+    const Complex z0 = work_[0];
+    out[0]     = Complex(z0.real() + z0.imag(), 0.0f);
+    out[half_] = Complex(z0.real() - z0.imag(), 0.0f);
+    for (int k = 1; k < half_; k++) {
+        Complex zk = work_[k];
+        Complex zc = std::conj(work_[half_ - k]);
+        Complex e = (zk + zc) * 0.5f;
+        Complex o = (zk - zc) * Complex(0.0f, -0.5f);
+        out[k] = e + splitTwiddles_[k] * o;
+    }
+}
+
+void RealFft::inverse(const Complex* in, float* out) {
+    // Undo the split: E[k] = (X[k] + X[N/2-k]*) / 2, O[k] = (X[k] - X[N/2-k]*) W^-k / 2
+    for (int k = 0; k < half_; k++) {
+        Complex xk = in[k];
+        Complex xc = std::conj(in[half_ - k]);
+        Complex e = (xk + xc) * 0.5f;
+        Complex o = (xk - xc) * 0.5f * std::conj(splitTwiddles_[k]);
+        work_[k] = e + Complex(0.0f, 1.0f) * o;
+    }
+    complexFft(work_.data(), true);
+
+    const float scale = 1.0f / static_cast<float>(half_);
+    for (int i = 0; i < half_; i++) {
+        out[2 * i]     = work_[i].real() * scale;
+        out[2 * i + 1] = work_[i].imag() * scale;
+    }
+}
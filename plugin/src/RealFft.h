@@ -0,0 +1,42 @@
+#pragma once
+#include <complex>
+#include <vector>
+
+/**
+ * Radix-2 FFT for real signals (size N, power of two).
+ *
+ * forward() takes N real samples and produces N/2 + 1 complex bins;
+ * inverse() takes N/2 + 1 bins and produces N real samples, scaled by 1/N
+ * so inverse(forward(x)) == x. Internally runs one N/2-point complex FFT
+ * plus a split step, with twiddles and bit-reverse order precomputed in
+ * init() — no allocation after init().
+ */
+class RealFft {
+public:
+    using Complex = std::complex<float>;
+
+    RealFft() = default;
+    explicit RealFft(int size) { init(size); }
+
+    /** Prepare tables for an N-point transform. N must be a power of two ≥ 4. */
+    void init(int size);
+
+    int size() const { return size_; }
+    int bins() const { return size_ / 2 + 1; }
+
+    /** N real samples → N/2 + 1 bins. */
+    void forward(const float* in, Complex* out);
+
+    /** N/2 + 1 bins → N real samples (scaled by 1/N). */
+    void inverse(const Complex* in, float* out);
+
+private:
+    void complexFft(Complex* data, bool inverse) const;
+
+    int size_ = 0;
+    int half_ = 0;
+    std::vector<int> bitReverse_;        // half_ entries
+    std::vector<Complex> twiddles_;      // half_ / 2 entries: e^{-2πik/half}
+    std::vector<Complex> splitTwiddles_; // half_ entries: e^{-2πik/N}
+    std::vector<Complex> work_;          // half_ entries
+};
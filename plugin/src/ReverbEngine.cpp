@@ -0,0 +1,129 @@
+#include "ReverbEngine.h"
+#include "SpatialTables.h"
+#include <cstdint>
+
+// =============================================================================
+//  Processing
+//  Stadium-like environment: large room, reflective surfaces
+// =============================================================================
+
+void ReverbEngine::process(float monoIn, float& outL, float& outR) {
+    // ── Late Reverb (parallel combs → series allpass) ──
+    float lateL = 0.0f, lateR = 0.0f;
+    for (int c = 0; c < ReverbLayout::COMBS; c++) lateL += comb(ReverbLayout::COMB_L + c, monoIn);
+    for (int c = 0; c < ReverbLayout::COMBS; c++) lateR += comb(ReverbLayout::COMB_R + c, monoIn);
+
+    // Normalize comb mix
+    lateL *= 0.25f;
+    lateR *= 0.25f;
+
+    // Diffuse through allpass filters
+    for (int a = 0; a < ReverbLayout::ALLPASSES; a++) lateL = allpass(ReverbLayout::ALLPASS_L + a, lateL);
+    for (int a = 0; a < ReverbLayout::ALLPASSES; a++) lateR = allpass(ReverbLayout::ALLPASS_R + a, lateR);
+
+    // Late share of the return (early reflections are per source, see EarlyReflections)
+    outL = lateL * 0.4f;
+    outR = lateR * 0.4f;
+}
+
+void ReverbEngine::processBlock(const float* monoIn, float* outL, float* outR, int n) {
+    for (int i = 0; i < n; i++) {
+        process(monoIn[i], outL[i], outR[i]);
+    }
+}
+
+void ReverbEngine::clear() {
+    delay_.fill(0.0f);
+    lines_.fill(Line{});
+}
+
+// =============================================================================
+//  Early Reflections (per source)
+// =============================================================================
+
+void EarlyReflections::finishFade() {
+    for (Tap& t : current_) {
+        t.startL = t.endL;
+        t.startR = t.endR;
+    }
+    crossfading_ = false;
+    fadePos_ = FADE_SAMPLES;
+}
+
+void EarlyReflections::update(const Protocol::Vec3& listenerPos, int listenerYaw,
+                              const Protocol::Vec3& sourcePos) {
+    // A frame is longer than a fade, so the previous one is normally done
+    finishFade();
+
+    const int sourceCell = ArenaReflections::cellOf(sourcePos);
+    const int listenerCell = ArenaReflections::cellOf(listenerPos);
+    const bool moved = sourceCell != sourceCell_ || listenerCell != listenerCell_;
+    sourceCell_ = sourceCell;
+    listenerCell_ = listenerCell;
+
+    if (moved) {
+        // New delays: fade the old set out instead of jumping its read taps
+        fadingOut_ = current_;
+        for (Tap& t : fadingOut_) { t.endL = 0.0f; t.endR = 0.0f; }
+        crossfading_ = true;
+    }
+
+    const ArenaReflections::Tap* baked = ArenaReflections::lookup(sourceCell, listenerCell);
+    for (int i = 0; i < TAPS; i++) {
+        Tap& t = current_[i];
+        if (moved) t = Tap{};
+        t.delay = baked[i].delaySamples;
+        if (t.delay == 0) {
+            t.endL = t.endR = 0.0f;
+            continue;
+        }
+        // Arrival direction relative to the listener, same convention as SpatialAudio::place()
+        int16_t relative = static_cast<int16_t>(static_cast<uint16_t>(listenerYaw) - baked[i].arrivalYaw);
+        float azimuth = static_cast<float>(relative) * (SpatialTables::PI / 32768.0f);
+        SpatialTables::AzimuthEntry pan = SpatialTables::lookupAzimuth(azimuth);
+
+        float gain = static_cast<float>(baked[i].gain) * (LEVEL / 65535.0f);
+        t.endL = gain * pan.gainL;
+        t.endR = gain * pan.gainR;
+    }
+    fadePos_ = 0;
+}
+
+void EarlyReflections::render(const float* send, int n, float* stereoOut) {
+    const float invFade = 1.0f / static_cast<float>(FADE_SAMPLES);
+    for (int i = 0; i < n; i++) {
+        delayLine_[writePos_] = send[i];
+
+        float f = fadePos_ < FADE_SAMPLES ? static_cast<float>(fadePos_ + 1) * invFade : 1.0f;
+        float l = 0.0f, r = 0.0f;
+        for (const Tap& t : current_) {
+            if (t.delay == 0) continue;
+            float x = delayLine_[(writePos_ - t.delay) & DELAY_MASK];
+            l += (t.startL + f * (t.endL - t.startL)) * x;
+            r += (t.startR + f * (t.endR - t.startR)) * x;
+        }
+        if (crossfading_) {
+            for (const Tap& t : fadingOut_) {
+                if (t.delay == 0) continue;
+                float x = delayLine_[(writePos_ - t.delay) & DELAY_MASK];
+                l += (t.startL + f * (t.endL - t.startL)) * x;
+                r += (t.startR + f * (t.endR - t.startR)) * x;
+            }
+        }
+        stereoOut[i * 2]     += l;
+        stereoOut[i * 2 + 1] += r;
+
+        writePos_ = (writePos_ + 1) & DELAY_MASK;
+        if (fadePos_ < FADE_SAMPLES && ++fadePos_ == FADE_SAMPLES) finishFade();
+    }
+}
+
+void EarlyReflections::clear() {
+    delayLine_.fill(0.0f);
+    writePos_ = 0;
+    current_ = {};
+    fadingOut_ = {};
+    crossfading_ = false;
+    fadePos_ = FADE_SAMPLES;
+    sourceCell_ = listenerCell_ = -1;
+}
@@ -0,0 +1,173 @@
+#pragma once
+#include "Protocol.h"
+#include "ArenaReflections.h"
+#include <array>
+#include <algorithm>
+
+/**
+ * Delay-line layout of ReverbEngine, fixed at compile time for
+ * Protocol::SAMPLE_RATE. Delays were tuned at 44.1 kHz (primes, to avoid
+ * metallic resonance; a ~30-50 m space) and are scaled to the engine
+ * rate; the right ear is slightly longer for stereo width.
+ */
+namespace ReverbLayout {
+
+    constexpr int COMBS     = 4;
+    constexpr int ALLPASSES = 2;
+    constexpr int LINES     = 2 * (COMBS + ALLPASSES);
+
+    // Line indices: combs L, combs R, allpasses L, allpasses R
+    constexpr int COMB_L    = 0;
+    constexpr int COMB_R    = COMBS;
+    constexpr int ALLPASS_L = 2 * COMBS;
+    constexpr int ALLPASS_R = 2 * COMBS + ALLPASSES;
+
+    constexpr float COMB_FEEDBACK    = 0.84f;  // RT60 ~1.8s (stadium-like)
+    constexpr float COMB_DAMP        = 0.3f;   // Some high-freq damping
+    constexpr float ALLPASS_FEEDBACK = 0.5f;
+
+    constexpr int scaled(int samples44k, int extra) {
+        return static_cast<int>(static_cast<float>(samples44k) *
+                                (static_cast<float>(Protocol::SAMPLE_RATE) / 44100.0f)) + extra;
+    }
+
+    constexpr std::array<int, LINES> LENGTHS = {
+        scaled(1557, 0),  scaled(1617, 0),  scaled(1491, 0),  scaled(1422, 0),
+        scaled(1557, 23), scaled(1617, 17), scaled(1491, 31), scaled(1422, 13),
+        scaled(556, 0),   scaled(441, 0),
+        scaled(556, 11),  scaled(441, 7)
+    };
+
+    constexpr std::array<int, LINES + 1> offsets() {
+        std::array<int, LINES + 1> o{};
+        for (int i = 0; i < LINES; i++) o[i + 1] = o[i] + LENGTHS[i];
+        return o;
+    }
+
+    constexpr std::array<int, LINES + 1> OFFSETS = offsets();   // Start of each line in the storage
+    constexpr int STORAGE = OFFSETS[LINES];
+
+} // namespace ReverbLayout
+
+/**
+ * Stereo Schroeder reverb used as the shared send bus (late tail only).
+ *
+ * AudioEngine owns a single instance. Each peer's SpatialAudio only
+ * produces a mono send signal (source × distance volume × send level);
+ * the sends are summed per playback callback and run through this
+ * engine once, so reverb cost no longer grows with peer count. The send
+ * level is applied before the reverb, so a tail decays from the level it
+ * was sent at instead of following the source's current level
+ * (bench/ReverbBusBench.cpp measures the difference).
+ *
+ * Early reflections depend on where each source and the listener are in
+ * the arena, so they cannot live on the shared bus: every source renders
+ * its own through EarlyReflections below, from the same send signal.
+ *
+ * Structure:
+ *   - 4 parallel damped comb filters per ear (late tail)
+ *   - 2 series allpass filters per ear (diffusion)
+ *
+ * Delay lengths come from ReverbLayout and all lines share one
+ * std::array, so constructing the engine never allocates.
+ */
+class ReverbEngine {
+public:
+    ReverbEngine() { clear(); }
+
+    /** Process one mono sample into a stereo reverb return. */
+    void process(float monoIn, float& outL, float& outR);
+
+    /** Process a block of mono send into separate L/R returns. */
+    void processBlock(const float* monoIn, float* outL, float* outR, int n);
+
+    /** Zero all delay lines and filter state. */
+    void clear();
+
+private:
+    /**
+     * Position in one delay line. The index counts down and wraps to
+     * length - 1, so no modulo runs per sample; the slot being read is
+     * the one written length samples ago.
+     */
+    struct Line {
+        int pos = 0;
+        float dampState = 0.0f;   // Combs only: one-pole lowpass in the feedback path
+    };
+
+    float comb(int line, float in) {
+        float* buf = delay_.data() + ReverbLayout::OFFSETS[line];
+        Line& l = lines_[line];
+        float out = buf[l.pos];
+        // Damped feedback
+        l.dampState = out * (1.0f - ReverbLayout::COMB_DAMP) + l.dampState * ReverbLayout::COMB_DAMP;
+        buf[l.pos] = in + l.dampState * ReverbLayout::COMB_FEEDBACK;
+        if (--l.pos < 0) l.pos = ReverbLayout::LENGTHS[line] - 1;
+        return out;
+    }
+
+    float allpass(int line, float in) {
+        float* buf = delay_.data() + ReverbLayout::OFFSETS[line];
+        Line& l = lines_[line];
+        float delayed = buf[l.pos];
+        float out = -in + delayed;
+        buf[l.pos] = in + delayed * ReverbLayout::ALLPASS_FEEDBACK;
+        if (--l.pos < 0) l.pos = ReverbLayout::LENGTHS[line] - 1;
+        return out;
+    }
+
+    std::array<float, ReverbLayout::STORAGE> delay_;   // Every delay line back to back, no heap
+    std::array<Line, ReverbLayout::LINES> lines_;
+};
+
+/**
+ * Per-source early reflections from the baked arena grid.
+ *
+ * update() runs once per frame: it looks up the (source cell, listener
+ * cell) taps in ArenaReflections and pans each by its arrival direction
+ * relative to the listener yaw (SpatialTables azimuth gains). No image or
+ * ray math at runtime.
+ *
+ * When the cell pair changes the tap delays change, so the old set fades
+ * out while the new one fades in over FADE_SAMPLES; when only the pans
+ * change the gains ramp over the same length.
+ */
+class EarlyReflections {
+public:
+    static constexpr int   TAPS         = ArenaReflections::TAPS;
+    static constexpr int   DELAY_SIZE   = 8192;   // Power of 2, > MAX_DELAY_SAMPLES
+    static constexpr int   DELAY_MASK   = DELAY_SIZE - 1;
+    static constexpr int   FADE_SAMPLES = 480;    // 10ms
+    static constexpr float LEVEL        = 0.6f;   // Early share of the reverb return
+
+    EarlyReflections() = default;
+
+    /** Look up taps for the current geometry. */
+    void update(const Protocol::Vec3& listenerPos, int listenerYaw, const Protocol::Vec3& sourcePos);
+
+    /** Add the reflections of n send samples into interleaved stereoOut. */
+    void render(const float* send, int n, float* stereoOut);
+
+    /** Zero the delay line and forget the current taps. */
+    void clear();
+
+private:
+    struct Tap {
+        int   delay = 0;                       // 0 = inactive
+        float startL = 0.0f, startR = 0.0f;    // Gains at the start of the fade
+        float endL = 0.0f, endR = 0.0f;        // Gains once the fade completes
+    };
+
+    void finishFade();
+
+    std::array<float, DELAY_SIZE> delayLine_{};
+    int writePos_ = 0;
+
+    std::array<Tap, TAPS> current_{};    // Indexed by surface
+    std::array<Tap, TAPS> fadingOut_{};  // Previous cell pair while crossfading
+    bool crossfading_ = false;
+    int  fadePos_ = FADE_SAMPLES;
+
+    int sourceCell_   = -1;
+    int listenerCell_ = -1;
+};
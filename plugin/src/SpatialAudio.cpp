@@ -1,95 +1,118 @@
 #include "SpatialAudio.h"
+#include "SpatialKernels.h"
+#include "SpatialTables.h"
+#include "ArenaReflections.h"
 #include <cmath>
 #include <cstring>
 #include <algorithm>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 // =============================================================================
 //  Constructor / Reset
 // =============================================================================
 
-SpatialAudio::SpatialAudio() {
-    reverb_.init(static_cast<float>(Protocol::SAMPLE_RATE));
+template <class Flavor>
+BasicSpatialAudio<Flavor>::BasicSpatialAudio() {
+    SpatialTables::warmUp();      // Build the lookup tables off the audio thread
+    ArenaReflections::warmUp();
+    smoothGainL_.setCoeff(PARAM_SMOOTH);
+    smoothGainR_.setCoeff(PARAM_SMOOTH);
+    smoothDelayL_.setCoeff(PARAM_SMOOTH);
+    smoothDelayR_.setCoeff(PARAM_SMOOTH);
+    smoothReverbSend_.setCoeff(PARAM_SMOOTH);
+    smoothCueHf_.setCoeff(PARAM_SMOOTH);
+    smoothDopplerPitch_.setCoeff(Flavor::DOPPLER_SMOOTH);
     reset();
 }
 
-void SpatialAudio::reset() {
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::reset() {
+    resetFullChain();
+    liteGainL_ = liteGainR_ = liteSend_ = 0.0f;
+    litePrimed_ = false;
+    renderedTier_ = tier_;
+}
+
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::resetFullChain() {
     delayL_ = {};
     delayR_ = {};
-    dopplerL_.reset();
-    dopplerR_.reset();
+    doppler_.reset();
     prevDistUU_ = -1.0f;
     headFilterL_.reset();
     headFilterR_.reset();
     airAbsL_.reset();
     airAbsR_.reset();
     airAbsMono_.reset();
+    elevationCue_.reset();
     distHpL_.reset();
     distHpR_.reset();
-    reverb_.clear();
+    early_.clear();
     smoothGainL_.snap(0.5f);
     smoothGainR_.snap(0.5f);
     smoothDelayL_.snap(0.0f);
     smoothDelayR_.snap(0.0f);
-    smoothVolume_.snap(0.0f);
     smoothReverbSend_.snap(0.0f);
+    smoothCueHf_.snap(1.0f);
     smoothDopplerPitch_.snap(1.0f);
     firstFrame_ = true;
 }
 
-void SpatialAudio::setDistanceParams(float inner, float outer, float rolloff) {
-    innerRadius_ = inner;
-    outerRadius_ = outer;
-    rolloff_ = std::max(rolloff, 0.1f);
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::setTier(Tier tier) {
+    if (tier == tier_) return;
+    // The full chain stood still while another tier played: start it clean
+    if (tier == Tier::Full && renderedTier_ != Tier::Full) resetFullChain();
+    if (renderedTier_ == Tier::Full) litePrimed_ = false;
+    tier_ = tier;
 }
 
-// =============================================================================
-//  Utility
-// =============================================================================
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::setDistanceParams(float inner, float outer, float rolloff) {
+    DistanceModel::Settings settings = distance_.settings();
+    settings.inner = inner;
+    settings.outer = outer;
+    settings.rolloff = std::max(rolloff, 0.1f);
+    distance_.configure(settings);
+}
 
-float SpatialAudio::smoothstep(float edge0, float edge1, float x) {
-    float t = std::clamp((x - edge0) / (edge1 - edge0 + 1e-9f), 0.0f, 1.0f);
-    return t * t * (3.0f - 2.0f * t);
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::setDistanceModel(const DistanceModel::Settings& settings) {
+    DistanceModel::Settings clamped = settings;
+    clamped.rolloff = std::max(settings.rolloff, 0.1f);
+    distance_.configure(clamped);
 }
 
-float SpatialAudio::yawToRadians(int yaw) {
-    // UE4 rotator: 0-65535 → 0-2PI
-    return static_cast<float>(yaw) * (2.0f * static_cast<float>(M_PI) / 65536.0f);
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::setOcclusion(float openness) {
+    openness_ += OCCLUSION_SMOOTH * (std::clamp(openness, 0.0f, 1.0f) - openness_);
 }
 
 // =============================================================================
-//  Head Shadow Filter (frequency-dependent ILD)
-//  Models the shadowing effect of the head for the far ear.
-//  Uses a simple 2nd-order low-shelf design controlled by angle.
+//  Parameter Ramps
 // =============================================================================
 
-void SpatialAudio::HeadShadowFilter::setCoeffs(float angle, float sampleRate) {
-    // angle: 0 = front, PI = directly behind, PI/2 = side
-    // Shadow increases as source moves to the opposite ear
-    // Alpha controls how much high frequency is removed (0=none, 1=full)
-    float shadow = std::clamp(std::sin(angle) * 0.5f + 0.5f, 0.0f, 1.0f);
-
-    // Design a simple one-pole low-pass whose cutoff depends on shadow
-    // More shadow → lower cutoff — stronger filtering = more stereo perception
-    // Wider range (2kHz–16kHz) for very dramatic head shadow
-    float fc = 16000.0f - shadow * 14000.0f; // Range: 2kHz to 16kHz
-    fc = std::clamp(fc, 2000.0f, 18000.0f);
-
-    float wc = 2.0f * static_cast<float>(M_PI) * fc / sampleRate;
-    float g = std::tan(wc * 0.5f);
-
-    // Bilinear transform one-pole LP
-    b0 = g / (1.0f + g);
-    b1 = b0;
-    b2 = 0.0f;
-    a1 = (g - 1.0f) / (1.0f + g);
-    a2 = 0.0f;
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::LinearRamp::fill(const SpatialKernels::KernelTable& k, float* dst, int n) {
+    for (int offset = 0; offset < n; offset += RAMP_STEP) {
+        int len = std::min(RAMP_STEP, n - offset);
+        float decay = (len == RAMP_STEP)
+            ? stepDecay
+            : std::pow(1.0f - coeff, static_cast<float>(len));
+        // Exact one-pole value after len samples, reached by a linear ramp
+        float end = target + (current - target) * decay;
+        k.ramp(dst + offset, current, (end - current) / static_cast<float>(len), len);
+        current = end;
+    }
 }
 
-float SpatialAudio::HeadShadowFilter::process(float in) {
+// =============================================================================
+//  Head Shadow Filter (frequency-dependent ILD)
+//  Models the shadowing effect of the head for the far ear. Coefficients
+//  come from SpatialTables (one-pole LP, cutoff 2kHz–16kHz by ear angle).
+// =============================================================================
+
+template <class Flavor>
+float BasicSpatialAudio<Flavor>::HeadShadowFilter::process(float in) {
     float out = b0 * in + b1 * z1 + b2 * z2 - a1 * z1 - a2 * z2;
     // Simplified: since b2=a2=0, this is effectively a one-pole
     // but we keep the interface for future upgrade to biquad
@@ -99,116 +122,77 @@ float SpatialAudio::HeadShadowFilter::process(float in) {
 }
 
 // =============================================================================
-//  Reverb Engine Initialization
-//  Stadium-like environment: large room, reflective surfaces
+//  Placement: listener-relative direction, distance gain and reverb send.
+//  Shared by the parametric pipeline below and the mix-time renderers.
 // =============================================================================
 
-void SpatialAudio::ReverbEngine::init(float sampleRate) {
-    float srFactor = sampleRate / 44100.0f; // Scale delays for sample rate
-
-    // Comb filter delay times (in samples) — carefully chosen primes to
-    // avoid metallic resonance. These simulate a ~30-50m space.
-    const int combDelays[4] = {
-        static_cast<int>(1557 * srFactor),
-        static_cast<int>(1617 * srFactor),
-        static_cast<int>(1491 * srFactor),
-        static_cast<int>(1422 * srFactor)
-    };
-    // Slightly different delays for right channel (stereo width)
-    const int combDelaysR[4] = {
-        static_cast<int>(1557 * srFactor + 23),
-        static_cast<int>(1617 * srFactor + 17),
-        static_cast<int>(1491 * srFactor + 31),
-        static_cast<int>(1422 * srFactor + 13)
-    };
-
-    float feedback = 0.84f;  // RT60 ~1.8s (stadium-like)
-    float damp = 0.3f;       // Some high-freq damping
-
-    for (int i = 0; i < 4; i++) {
-        combsL[i].init(combDelays[i], feedback, damp);
-        combsR[i].init(combDelaysR[i], feedback, damp);
-    }
-
-    // Allpass delays (smaller, for diffusion)
-    const int apDelays[2] = {
-        static_cast<int>(556 * srFactor),
-        static_cast<int>(441 * srFactor)
-    };
-    const int apDelaysR[2] = {
-        static_cast<int>(556 * srFactor + 11),
-        static_cast<int>(441 * srFactor + 7)
-    };
-
-    for (int i = 0; i < 2; i++) {
-        allpassL[i].init(apDelays[i], 0.5f);
-        allpassR[i].init(apDelaysR[i], 0.5f);
-    }
-
-    // Early reflections delay line
-    earlyDelayLine.resize(EARLY_DELAY_SIZE, 0.0f);
-    earlyWritePos = 0;
-
-    // 6 early reflection taps simulating a stadium environment:
-    //   Floor, ceiling, left wall, right wall, far wall, near wall
-    // Delays in samples, gains simulate distance attenuation & absorption
-    earlyTaps[0] = { static_cast<int>(171 * srFactor), 0.45f, 0.45f };  // Floor (centered)
-    earlyTaps[1] = { static_cast<int>(353 * srFactor), 0.38f, 0.38f };  // Ceiling (centered)
-    earlyTaps[2] = { static_cast<int>(557 * srFactor), 0.55f, 0.22f };  // Left wall
-    earlyTaps[3] = { static_cast<int>(619 * srFactor), 0.22f, 0.55f };  // Right wall
-    earlyTaps[4] = { static_cast<int>(857 * srFactor), 0.30f, 0.28f };  // Far wall
-    earlyTaps[5] = { static_cast<int>(1187 * srFactor), 0.18f, 0.20f }; // Back wall (subtle)
-}
-
-void SpatialAudio::ReverbEngine::process(float monoIn, float& outL, float& outR) {
-    // ── Early Reflections ──
-    earlyDelayLine[earlyWritePos] = monoIn;
-    earlyWritePos = (earlyWritePos + 1) % EARLY_DELAY_SIZE;
-
-    float earlyL = 0.0f, earlyR = 0.0f;
-    for (auto& tap : earlyTaps) {
-        int readPos = (earlyWritePos - tap.delaySamples + EARLY_DELAY_SIZE) % EARLY_DELAY_SIZE;
-        float sample = earlyDelayLine[readPos];
-        earlyL += sample * tap.gainL;
-        earlyR += sample * tap.gainR;
-    }
-
-    // ── Late Reverb (parallel combs → series allpass) ──
-    float lateL = 0.0f, lateR = 0.0f;
-    for (auto& c : combsL) lateL += c.process(monoIn);
-    for (auto& c : combsR) lateR += c.process(monoIn);
-
-    // Normalize comb mix
-    lateL *= 0.25f;
-    lateR *= 0.25f;
-
-    // Diffuse through allpass filters
-    for (auto& ap : allpassL) lateL = ap.process(lateL);
-    for (auto& ap : allpassR) lateR = ap.process(lateR);
+template <class Flavor>
+typename BasicSpatialAudio<Flavor>::Placement
+BasicSpatialAudio<Flavor>::place(const Protocol::Vec3& listenerPos,
+                                 const Protocol::Rot& listenerRot,
+                                 const Protocol::Vec3& sourcePos) const {
+    Protocol::Vec3 delta = sourcePos - listenerPos;
+    float distUU = delta.length();
 
-    // Combine early + late
-    outL = earlyL * 0.6f + lateL * 0.4f;
-    outR = earlyR * 0.6f + lateR * 0.4f;
-}
+    // Listener basis from the full rotator (UE4 FRotationMatrix axes)
+    // UE4: yaw=0 → +X, yaw=16384(90°) → +Y, pitch>0 looks up
+    float sy, cy, sp, cp, sr, cr;
+    SpatialTables::rotatorSinCos(listenerRot.yaw,   sy, cy);
+    SpatialTables::rotatorSinCos(listenerRot.pitch, sp, cp);
+    SpatialTables::rotatorSinCos(listenerRot.roll,  sr, cr);
 
-void SpatialAudio::ReverbEngine::clear() {
-    for (auto& c : combsL)  c.clear();
-    for (auto& c : combsR)  c.clear();
-    for (auto& ap : allpassL) ap.clear();
-    for (auto& ap : allpassR) ap.clear();
-    std::fill(earlyDelayLine.begin(), earlyDelayLine.end(), 0.0f);
-    earlyWritePos = 0;
+    // Project delta into listener-local frame:
+    //   forward = ( cp·cy, cp·sy, sp)
+    //   right   = -(UE right axis); the renderer's "right" is mirrored, see INVERTED in SpatialTables
+    //   up      = UE up axis
+    // With pitch = roll = 0 these reduce to the old yaw-only XY projection.
+    float localForward = delta.x * (cp * cy) + delta.y * (cp * sy) + delta.z * sp;
+    float localRight   = delta.x * (cr * sy - sr * sp * cy)
+                       - delta.y * (sr * sp * sy + cr * cy)
+                       + delta.z * (sr * cp);
+    float localUp      = delta.x * -(cr * sp * cy + sr * sy)
+                       + delta.y * (cy * sr - cr * sp * sy)
+                       + delta.z * (cr * cp);
+
+    // Azimuth angle: 0 = front, ±PI = behind; +PI/2 is rendered to the left ear and
+    // -PI/2 to the right (the mirrored convention of Placement::azimuth, see INVERTED in
+    // SpatialTables), which the HRIR and VBAP buses rely on as well
+    float azimuth = SpatialTables::azimuthOf(localRight, localForward + 1e-9f); // -PI to PI
+
+    // Elevation: angle above the listener's ear plane, -PI/2 to PI/2
+    float horizontal = std::sqrt(localForward * localForward + localRight * localRight);
+    float elevation = SpatialTables::azimuthOf(localUp, horizontal);
+
+    // Lateral angle for ITD/ILD: a source overhead reaches both ears at once,
+    // so fold the vertical component into the front/back axis (keeps its sign)
+    float frontBack = std::sqrt(localForward * localForward + localUp * localUp);
+    frontBack = localForward < 0.0f ? -frontBack : frontBack;
+    float lateral = SpatialTables::azimuthOf(localRight, frontBack + 1e-9f);
+
+    // Attenuation, air absorption, high-pass and reverb send: one table lookup
+    const DistanceModel::Entry dist = distanceModel().lookup(distUU);
+    const float reverbSend = reverbEnabled_ ? dist.reverbSend * reverbMix_ : 0.0f;
+
+    // Occlusion darkens and lowers the direct sound (the send follows the gain)
+    const float occluded = 1.0f - openness_;
+    const float gain = dist.gain * (1.0f - (1.0f - OCCLUDED_GAIN) * occluded);
+    const float airAlpha = dist.airAlpha * (1.0f - (1.0f - OCCLUDED_AIR_ALPHA) * occluded);
+
+    return { distUU, azimuth, elevation, lateral, gain, reverbSend, airAlpha, dist.hpAlpha };
 }
 
 // =============================================================================
 //  MAIN PROCESSING: Full 3D Spatialization Pipeline
 // =============================================================================
 
-float SpatialAudio::process(const float* monoIn, int frameSize, float* stereoOut,
-                            const Protocol::Vec3& listenerPos, int listenerYaw,
-                            const Protocol::Vec3& sourcePos) {
+template <class Flavor>
+float BasicSpatialAudio<Flavor>::process(const float* monoIn, int frameSize, float* stereoOut,
+                                         const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                                         const Protocol::Vec3& sourcePos,
+                                         float* reverbSendOut) {
     // Default: silence
     std::memset(stereoOut, 0, sizeof(float) * frameSize * 2);
+    if (reverbSendOut) std::memset(reverbSendOut, 0, sizeof(float) * frameSize);
 
     if (!enabled_) {
         // Pass-through center-panned
@@ -219,128 +203,108 @@ float SpatialAudio::process(const float* monoIn, int frameSize, float* stereoOut
         return masterVolume_;
     }
 
-    // ─── 1. Geometry: relative position in listener-centric frame ────────
+    // ─── 1–2. Geometry + distance attenuation ────────────────────────────
 
-    Protocol::Vec3 delta = sourcePos - listenerPos;
-    float distUU = delta.length();
-    float distMeters = unitsToMeters(distUU);
+    const Placement pl = place(listenerPos, listenerRot, sourcePos);
+    const float distVolume = pl.distVolume;
 
-    // Listener forward direction (yaw only, in XY plane)
-    // UE4: yaw=0 → +X, yaw=16384(90°) → +Y
-    float yawRad = yawToRadians(listenerYaw);
-    float cosYaw = std::cos(yawRad);
-    float sinYaw = std::sin(yawRad);
+    if (distVolume <= 0.0f) return 0.0f;
 
-    // Project delta into listener-local frame:
-    //   forward = (cosYaw, sinYaw)  → dot gives forward component
-    //   right   = (sinYaw, -cosYaw) → dot gives right component (perpendicular CW)
-    float localForward = delta.x * cosYaw + delta.y * sinYaw;
-    float localRight   = delta.x * sinYaw - delta.y * cosYaw;
-
-    // Azimuth angle: 0 = front, +PI/2 = right, -PI/2 = left, ±PI = behind
-    float azimuth = std::atan2(localRight, localForward + 1e-9f); // -PI to PI
-    float absAzimuth = std::abs(azimuth);
-
-    // ─── 2. Distance Attenuation ─────────────────────────────────────────
-
-    float distVolume;
-    if (distUU <= innerRadius_) {
-        distVolume = 1.0f;
-    } else if (distUU >= outerRadius_) {
-        distVolume = 0.0f;
-    } else {
-        // Gentle logarithmic rolloff instead of aggressive smoothstep+pow
-        // This keeps voices audible much further away
-        float ratio = (distUU - innerRadius_) / (outerRadius_ - innerRadius_ + 1e-9f);
-        ratio = std::clamp(ratio, 0.0f, 1.0f);
-        // Log rolloff: stays loud longer, fades slowly
-        distVolume = 1.0f - std::pow(ratio, 0.6f);
-        // Minimum floor — always slightly audible within outer radius
-        distVolume = std::max(distVolume, 0.04f);
-    }
+    // ─── LOD: render the current tier, crossfading out of the previous one ──
 
-    if (distVolume <= 0.0f) return 0.0f;
+    if (renderedTier_ != tier_ && frameSize <= Protocol::FRAME_SIZE) {
+        float* oldSend = reverbSendOut ? fadeSend_.data() : nullptr;
+        std::memset(fadeStereo_.data(), 0, sizeof(float) * frameSize * 2);
+        if (oldSend) std::memset(oldSend, 0, sizeof(float) * frameSize);
 
-    // ─── 3. HRTF Binaural Rendering ─────────────────────────────────────
+        renderTier(renderedTier_, monoIn, frameSize, fadeStereo_.data(), oldSend,
+                   listenerPos, listenerRot, sourcePos, pl);
+        renderTier(tier_, monoIn, frameSize, stereoOut, reverbSendOut,
+                   listenerPos, listenerRot, sourcePos, pl);
 
-    // Interaural Time Delay (ITD):
-    // Woodworth formula: ITD = (r/c) * (sin(θ) + θ)  for |θ| ≤ π/2
-    // Simplified: ITD ≈ HEAD_RADIUS/c * sin(azimuth) for the near ear
-    float sinAz = std::sin(azimuth);
-    float itdSeconds = HEAD_RADIUS_M / SPEED_OF_SOUND * sinAz;
-    // Convert to samples
-    float itdSamples = std::abs(itdSeconds) * static_cast<float>(Protocol::SAMPLE_RATE);
-    itdSamples = std::min(itdSamples, static_cast<float>(MAX_ITD_SAMPLES));
-
-    // Assign delay to each ear — INVERTED: source on right → RIGHT ear delayed
-    float targetDelayL, targetDelayR;
-    if (azimuth >= 0.0f) {
-        // Source on right: invert → right ear delayed
-        targetDelayL = 0.0f;
-        targetDelayR = itdSamples;
+        // Linear crossfade across the frame
+        const float step = 1.0f / static_cast<float>(frameSize);
+        for (int i = 0; i < frameSize; i++) {
+            float f = step * static_cast<float>(i + 1);
+            stereoOut[i * 2]     = fadeStereo_[i * 2]     + f * (stereoOut[i * 2]     - fadeStereo_[i * 2]);
+            stereoOut[i * 2 + 1] = fadeStereo_[i * 2 + 1] + f * (stereoOut[i * 2 + 1] - fadeStereo_[i * 2 + 1]);
+            if (oldSend) reverbSendOut[i] = oldSend[i] + f * (reverbSendOut[i] - oldSend[i]);
+        }
     } else {
-        targetDelayL = itdSamples;
-        targetDelayR = 0.0f;
+        renderTier(tier_, monoIn, frameSize, stereoOut, reverbSendOut,
+                   listenerPos, listenerRot, sourcePos, pl);
     }
+    renderedTier_ = tier_;
 
-    // Interaural Level Difference (ILD):
-    // Very strong stereo separation — 60% max attenuation for dramatic L/R
-    float ildFactor = 1.0f - 0.60f * std::abs(sinAz);  // Max 60% ILD attenuation
-    float targetGainL, targetGainR;
+    return distVolume;
+}
 
-    if (azimuth >= 0.0f) {
-        // Source on right → INVERTED: left ear louder
-        targetGainL = 1.0f;
-        targetGainR = ildFactor;
-    } else {
-        targetGainR = 1.0f;
-        targetGainL = ildFactor;
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::renderTier(Tier tier, const float* monoIn, int frameSize, float* stereoOut,
+                                           float* reverbSendOut,
+                                           const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                                           const Protocol::Vec3& sourcePos, const Placement& pl) {
+    switch (tier) {
+    case Tier::Full:
+        renderFull(monoIn, frameSize, stereoOut, reverbSendOut, listenerPos, listenerRot, sourcePos, pl);
+        break;
+    case Tier::Reduced:
+        renderLite(monoIn, frameSize, stereoOut, reverbSendOut, pl);
+        break;
+    case Tier::Minimal:
+        renderLite(monoIn, frameSize, stereoOut, nullptr, pl);
+        break;
     }
+}
 
-    // Rear attenuation: gentle — sounds behind are slightly softer
-    float rearFactor = 1.0f;
-    if (absAzimuth > static_cast<float>(M_PI) * 0.5f) {
-        float rearness = (absAzimuth - static_cast<float>(M_PI) * 0.5f) /
-                         (static_cast<float>(M_PI) * 0.5f);
-        rearFactor = 1.0f - rearness * 0.30f; // Up to 30% rear attenuation (more spatial)
+// =============================================================================
+//  Full tier: binaural + elevation + Doppler + early reflections + send
+// =============================================================================
+
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::renderFull(const float* monoIn, int frameSize, float* stereoOut,
+                                           float* reverbSendOut,
+                                           const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                                           const Protocol::Vec3& sourcePos, const Placement& pl) {
+    const FrameParams fp = beginFull(reverbSendOut != nullptr, listenerPos, listenerRot, sourcePos, pl);
+    for (int offset = 0; offset < frameSize; offset += BLOCK_SIZE) {
+        int n = std::min(BLOCK_SIZE, frameSize - offset);
+        processBlock(monoIn + offset, n, stereoOut + offset * 2,
+                     reverbSendOut ? reverbSendOut + offset : nullptr, fp);
     }
-    targetGainL *= rearFactor;
-    targetGainR *= rearFactor;
+}
+
+template <class Flavor>
+typename BasicSpatialAudio<Flavor>::FrameParams
+BasicSpatialAudio<Flavor>::beginFull(bool withSend,
+                                     const Protocol::Vec3& listenerPos,
+                                     const Protocol::Rot& listenerRot,
+                                     const Protocol::Vec3& sourcePos,
+                                     const Placement& pl) {
+    const float distUU = pl.distUU;
+    const float distVolume = pl.distVolume;
+
+    // ─── 3. HRTF Binaural Rendering ─────────────────────────────────────
+
+    // ITD, ILD × rear attenuation and head-shadow coefficients depend on the
+    // lateral angle only; the elevation cue on elevation only. Both come from
+    // the precomputed tables (see SpatialTables).
+    const SpatialTables::AzimuthEntry hrtf = SpatialTables::lookupAzimuth(pl.lateral);
+    const SpatialTables::ElevationEntry cue = SpatialTables::lookupElevation(pl.elevation);
+    float targetDelayL = hrtf.delayL;
+    float targetDelayR = hrtf.delayR;
 
     // Apply distance volume + master volume + output gain boost
-    constexpr float OUTPUT_GAIN_BOOST = 1.8f;
-    targetGainL *= distVolume * masterVolume_ * OUTPUT_GAIN_BOOST;
-    targetGainR *= distVolume * masterVolume_ * OUTPUT_GAIN_BOOST;
-
-    // Configure head shadow filters for each ear — INVERTED to match L/R swap
-    float angleToLeftEar  = static_cast<float>(M_PI) * 0.5f + azimuth;  // Swapped
-    float angleToRightEar = static_cast<float>(M_PI) * 0.5f - azimuth;  // Swapped
-    headFilterL_.setCoeffs(std::clamp(angleToLeftEar, 0.0f, static_cast<float>(M_PI)),
-                           static_cast<float>(Protocol::SAMPLE_RATE));
-    headFilterR_.setCoeffs(std::clamp(angleToRightEar, 0.0f, static_cast<float>(M_PI)),
-                           static_cast<float>(Protocol::SAMPLE_RATE));
-
-    // Air absorption: gentle high-frequency rolloff over distance
-    // alpha → 1 means no filtering, lower = more low-pass
-    float airAlpha;
-    if (distMeters < 5.0f) {
-        airAlpha = 1.0f;  // No absorption at close range
-    } else {
-        // Very gentle absorption — just slight muffling at distance
-        airAlpha = 1.0f / (1.0f + 0.008f * distMeters); // was 0.04 — 5x gentler
-        airAlpha = std::clamp(airAlpha, 0.15f, 1.0f);   // never go below 0.15
-    }
+    float targetGainL = hrtf.gainL * cue.gain * distVolume * masterVolume_ * OUTPUT_GAIN_BOOST;
+    float targetGainR = hrtf.gainR * cue.gain * distVolume * masterVolume_ * OUTPUT_GAIN_BOOST;
 
-    // Reverb send amount increases with distance
-    float targetReverbSend = 0.0f;
-    if (reverbEnabled_) {
-        if (distUU <= innerRadius_) {
-            targetReverbSend = 0.15f; // Noticeable room ambience even up close
-        } else {
-            float t = smoothstep(innerRadius_, outerRadius_, distUU);
-            targetReverbSend = 0.15f + t * 0.85f; // Scale up to 100%
-        }
-        targetReverbSend *= reverbMix_;
+    headFilterL_.setCoeffs(hrtf.shadowB0L, hrtf.shadowA1L);
+    headFilterR_.setCoeffs(hrtf.shadowB0R, hrtf.shadowA1R);
+
+    // Reverb send amount increases with distance (see place())
+    float targetReverbSend = pl.reverbSend;
+    if (reverbEnabled_ && withSend) {
+        early_.update(listenerPos, listenerRot.yaw, sourcePos);
     }
 
     // ─── Doppler Effect ──────────────────────────────────────────────────
@@ -355,12 +319,14 @@ float SpatialAudio::process(const float* monoIn, int frameSize, float* stereoOut
 
         // Doppler formula: f' = f * c / (c + v_s)
         // With exaggeration factor for dramatic effect
-        float exaggeratedV = radialVelocityMS * DOPPLER_EXAGGERATION;
+        float exaggeratedV = radialVelocityMS * Flavor::DOPPLER_EXAGGERATION;
         // Clamp to avoid extreme values (max ±0.8c)
         exaggeratedV = std::clamp(exaggeratedV, -SPEED_OF_SOUND * 0.8f, SPEED_OF_SOUND * 0.8f);
         targetDopplerPitch = SPEED_OF_SOUND / (SPEED_OF_SOUND + exaggeratedV);
         // Clamp pitch ratio to sane range
-        targetDopplerPitch = std::clamp(targetDopplerPitch, 0.70f, 1.40f); // Wide, clearly audible range
+        targetDopplerPitch = std::clamp(targetDopplerPitch, Flavor::DOPPLER_MIN_PITCH, Flavor::DOPPLER_MAX_PITCH);
+        // Slow relative motion: let the Doppler stage drop to its bypass
+        if (std::abs(targetDopplerPitch - 1.0f) < DOPPLER_DEADZONE) targetDopplerPitch = 1.0f;
     }
     prevDistUU_ = distUU;
 
@@ -369,8 +335,8 @@ float SpatialAudio::process(const float* monoIn, int frameSize, float* stereoOut
     smoothGainR_.set(targetGainR);
     smoothDelayL_.set(targetDelayL);
     smoothDelayR_.set(targetDelayR);
-    smoothVolume_.set(distVolume);
     smoothReverbSend_.set(targetReverbSend);
+    smoothCueHf_.set(cue.hfGain);
     smoothDopplerPitch_.set(targetDopplerPitch);
 
     // On first frame, snap to avoid initial sweep
@@ -379,113 +345,164 @@ float SpatialAudio::process(const float* monoIn, int frameSize, float* stereoOut
         smoothGainR_.snap(targetGainR);
         smoothDelayL_.snap(targetDelayL);
         smoothDelayR_.snap(targetDelayR);
-        smoothVolume_.snap(distVolume);
         smoothReverbSend_.snap(targetReverbSend);
+        smoothCueHf_.snap(cue.hfGain);
         smoothDopplerPitch_.snap(targetDopplerPitch);
         firstFrame_ = false;
     }
 
-    // ─── 4. Per-sample Processing (with Doppler pitch shifting) ─────────
+    // Air absorption and distance high-pass come with the placement (DistanceModel)
+    return { pl.airAlpha, pl.hpAlpha, cue.cueAlpha, distVolume };
+}
 
-    // Distance-based high-pass: further away = less bass
-    // Cutoff goes from ~20 Hz (close) to ~600 Hz (max distance)
-    // alpha for one-pole HP: alpha = 1 / (1 + 2*pi*fc/sr)
-    float hpCutoff;
-    if (distUU <= innerRadius_) {
-        hpCutoff = 20.0f;  // Full bass at close range
-    } else {
-        float t = smoothstep(innerRadius_, outerRadius_, distUU);
-        hpCutoff = 20.0f + t * 580.0f;  // Ramp up to 600 Hz at max distance
+// =============================================================================
+//  Reduced / Minimal tiers: ILD pan + distance gain (+ send), no filters,
+//  delay lines or per-source reflections. Gains ramp linearly per frame.
+// =============================================================================
+
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::renderLite(const float* monoIn, int frameSize, float* stereoOut,
+                                           float* reverbSendOut, const Placement& pl) {
+    const SpatialKernels::KernelTable& k = SpatialKernels::active();
+    BlockScratch& s = scratch_;
+
+    const SpatialTables::AzimuthEntry pan = SpatialTables::lookupAzimuth(pl.lateral);
+    const float level = SpatialTables::lookupElevation(pl.elevation).gain
+                      * pl.distVolume * masterVolume_ * OUTPUT_GAIN_BOOST;
+    const float gainL = pan.gainL * level;
+    const float gainR = pan.gainR * level;
+    const float send  = reverbEnabled_ ? pl.reverbSend * pl.distVolume : 0.0f;
+
+    if (!litePrimed_) {
+        liteGainL_ = gainL;
+        liteGainR_ = gainR;
+        liteSend_  = send;
+        litePrimed_ = true;
     }
-    float hpAlpha = 1.0f / (1.0f + (2.0f * static_cast<float>(M_PI) * hpCutoff)
-                    / static_cast<float>(Protocol::SAMPLE_RATE));
-    // Clamp: alpha=1 means no filtering, lower means more bass cut
-    hpAlpha = std::clamp(hpAlpha, 0.90f, 1.0f);
-
-    // Smoothing coefficient: smooth but responsive enough to feel the stereo
-    // 0.0004 at 48kHz ≈ ~55ms time constant
-    const float kSmooth = 0.0004f;
-    const float kDopplerSmooth = DOPPLER_SMOOTH;
-
-    for (int i = 0; i < frameSize; i++) {
-        float mono = monoIn[i];
-
-        // Smoothly interpolate parameters
-        float gL = smoothGainL_.smooth(kSmooth);
-        float gR = smoothGainR_.smooth(kSmooth);
-        float dL = smoothDelayL_.smooth(kSmooth);
-        float dR = smoothDelayR_.smooth(kSmooth);
-        float reverbSend = smoothReverbSend_.smooth(kSmooth);
-        float pitchRatio = smoothDopplerPitch_.smooth(kDopplerSmooth);
-
-        // ── Gentle air absorption on mono signal ──
-        float absorbed = airAbsMono_.process(mono, airAlpha);
-
-        // ── Write into Doppler delay lines ──
-        dopplerL_.write(absorbed);
-        dopplerR_.write(absorbed);
-
-        // ── Doppler pitch shifting: advance read position at variable rate ──
-        // pitchRatio > 1 = higher pitch (approaching), < 1 = lower pitch (receding)
-        dopplerL_.readPos += static_cast<double>(pitchRatio);
-        dopplerR_.readPos += static_cast<double>(pitchRatio);
-
-        // Keep read position from falling too far behind write position
-        double maxLag = DOPPLER_BUF_SIZE - 64;
-        double writeD = static_cast<double>(dopplerL_.writePos);
-        if (writeD - dopplerL_.readPos > maxLag) dopplerL_.readPos = writeD - maxLag;
-        if (writeD - dopplerR_.readPos > maxLag) dopplerR_.readPos = writeD - maxLag;
-        if (dopplerL_.readPos > writeD - 1.0) dopplerL_.readPos = writeD - 1.0;
-        if (dopplerR_.readPos > writeD - 1.0) dopplerR_.readPos = writeD - 1.0;
-
-        // Read Doppler-shifted samples
-        float dopplerSampleL = dopplerL_.readAt(dopplerL_.readPos);
-        float dopplerSampleR = dopplerR_.readAt(dopplerR_.readPos);
-
-        // ── Write into ITD delay lines ──
-        delayL_.write(dopplerSampleL);
-        delayR_.write(dopplerSampleR);
-
-        // ── Read with fractional delay (ITD) ──
-        float sampleL = delayL_.read(dL);
-        float sampleR = delayR_.read(dR);
-
-        // Head shadow: blend filtered vs dry — 95% filtered for strong stereo
-        float filteredL = headFilterL_.process(sampleL);
-        float filteredR = headFilterR_.process(sampleR);
-        sampleL = sampleL * 0.05f + filteredL * 0.95f;
-        sampleR = sampleR * 0.05f + filteredR * 0.95f;
-
-        // ── Apply ILD gains ──
-        float dryL = sampleL * gL;
-        float dryR = sampleR * gR;
-
-        // ── Distance high-pass: cut bass at long range ──
-        dryL = distHpL_.process(dryL, hpAlpha);
-        dryR = distHpR_.process(dryR, hpAlpha);
-
-        // ── Reverb processing ──
-        float wetL = 0.0f, wetR = 0.0f;
-        if (reverbEnabled_ && reverbSend > 0.001f) {
-            reverb_.process(absorbed * distVolume, wetL, wetR);
-            wetL *= reverbSend;
-            wetR *= reverbSend;
+
+    const float inv = 1.0f / static_cast<float>(frameSize);
+    const float stepL = (gainL - liteGainL_) * inv;
+    const float stepR = (gainR - liteGainR_) * inv;
+    const float stepS = (send - liteSend_) * inv;
+
+    for (int offset = 0; offset < frameSize; offset += BLOCK_SIZE) {
+        int n = std::min(BLOCK_SIZE, frameSize - offset);
+        const float at = static_cast<float>(offset);
+        k.ramp(s.gainL.data(), liteGainL_ + stepL * at, stepL, n);
+        k.ramp(s.gainR.data(), liteGainR_ + stepR * at, stepR, n);
+        k.multiply(s.left.data(),  monoIn + offset, s.gainL.data(), n);
+        k.multiply(s.right.data(), monoIn + offset, s.gainR.data(), n);
+        k.interleave(stereoOut + offset * 2, s.left.data(), s.right.data(), n);
+
+        if (reverbSendOut) {
+            k.ramp(s.reverbSend.data(), liteSend_ + stepS * at, stepS, n);
+            k.multiply(reverbSendOut + offset, monoIn + offset, s.reverbSend.data(), n);
         }
+    }
+
+    liteGainL_ = gainL;
+    liteGainR_ = gainR;
+    liteSend_  = send;
+}
 
-        // ── Mix dry + wet ──
-        stereoOut[i * 2]     = dryL + wetL;
-        stereoOut[i * 2 + 1] = dryR + wetR;
+// =============================================================================
+//  Block Stages
+//  Each stage runs over the whole block before the next one starts, so the
+//  element-wise stages can go through the SIMD kernels. Operation order per
+//  sample is unchanged from the original single-loop implementation.
+// =============================================================================
+
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::processBlock(const float* monoIn, int n, float* stereoOut,
+                                             float* reverbSendOut, const FrameParams& fp) {
+    const SpatialKernels::KernelTable& k = SpatialKernels::active();
+    BlockScratch& s = scratch_;
+
+    // ── Parameter ramps: piecewise-linear, one segment per RAMP_STEP ──
+    smoothGainL_.fill(k, s.gainL.data(), n);
+    smoothGainR_.fill(k, s.gainR.data(), n);
+    smoothDelayL_.fill(k, s.delayL.data(), n);
+    smoothDelayR_.fill(k, s.delayR.data(), n);
+    smoothReverbSend_.fill(k, s.reverbSend.data(), n);
+    smoothCueHf_.fill(k, s.cueHf.data(), n);
+
+    // ── Absorb: gentle air absorption on the mono signal ──
+    for (int i = 0; i < n; i++) {
+        s.absorbed[i] = airAbsMono_.process(monoIn[i], fp.airAlpha);
     }
 
-    return distVolume;
+    // ── Elevation: monaural spectral cue (pinna above, torso shadow below) ──
+    for (int i = 0; i < n; i++) {
+        s.cued[i] = elevationCue_.process(s.absorbed[i], fp.cueAlpha, s.cueHf[i]);
+    }
+
+    // ── Doppler: one mono line for both ears, plain delay at unity pitch ──
+    // pitchRatio > 1 = higher pitch (approaching), < 1 = lower pitch (receding)
+    LinearRamp& pitch = smoothDopplerPitch_;
+    if (pitch.target == 1.0f && std::abs(pitch.current - 1.0f) < DOPPLER_UNITY_EPSILON) {
+        pitch.snap(1.0f);
+        doppler_.processUnity(s.cued.data(), s.shifted.data(), n);
+    } else {
+        pitch.fill(k, s.pitch.data(), n);
+        doppler_.process(s.cued.data(), s.pitch.data(), s.shifted.data(), n);
+    }
+
+    // ── ITD: fractional delay per ear ──
+    delayL_.process(s.shifted.data(), s.delayL.data(), s.left.data(), n);
+    delayR_.process(s.shifted.data(), s.delayR.data(), s.right.data(), n);
+
+    // ── Shadow: blend filtered vs dry — 95% filtered for strong stereo ──
+    for (int i = 0; i < n; i++) s.filteredL[i] = headFilterL_.process(s.left[i]);
+    for (int i = 0; i < n; i++) s.filteredR[i] = headFilterR_.process(s.right[i]);
+    k.blend(s.left.data(),  s.left.data(),  s.filteredL.data(), 0.05f, 0.95f, n);
+    k.blend(s.right.data(), s.right.data(), s.filteredR.data(), 0.05f, 0.95f, n);
+
+    // ── Gain: ILD + distance + master ──
+    k.multiply(s.left.data(),  s.left.data(),  s.gainL.data(), n);
+    k.multiply(s.right.data(), s.right.data(), s.gainR.data(), n);
+
+    // ── HP: distance high-pass, cut bass at long range ──
+    if constexpr (Flavor::DISTANCE_HIGH_PASS) {
+        for (int i = 0; i < n; i++) s.left[i]  = distHpL_.process(s.left[i],  fp.hpAlpha);
+        for (int i = 0; i < n; i++) s.right[i] = distHpR_.process(s.right[i], fp.hpAlpha);
+    }
+
+    k.interleave(stereoOut, s.left.data(), s.right.data(), n);
+
+    // ── Reverb send: the shared bus in AudioEngine runs the actual reverb ──
+    if (reverbEnabled_ && reverbSendOut) {
+        k.scale(s.reverbIn.data(), s.absorbed.data(), fp.distVolume, n);
+        k.multiply(reverbSendOut, s.reverbIn.data(), s.reverbSend.data(), n);
+        early_.render(reverbSendOut, n, stereoOut);
+    }
+}
+
+// =============================================================================
+//  Early Reflections (mix-time renderers)
+// =============================================================================
+
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::renderEarlyReflections(const float* send, int n, float* stereoOut,
+                                                       const Protocol::Vec3& listenerPos,
+                                                       const Protocol::Rot& listenerRot,
+                                                       const Protocol::Vec3& sourcePos) {
+    if (!reverbEnabled_) return;
+    early_.update(listenerPos, listenerRot.yaw, sourcePos);
+    early_.render(send, n, stereoOut);
 }
 
 // =============================================================================
 //  Additive Mix
 // =============================================================================
 
-void SpatialAudio::mixInto(float* mixBuffer, const float* source, int stereoSamples) {
-    for (int i = 0; i < stereoSamples * 2; i++) {
-        mixBuffer[i] += source[i];
-    }
+template <class Flavor>
+void BasicSpatialAudio<Flavor>::mixInto(float* mixBuffer, const float* source, int stereoSamples) {
+    SpatialKernels::active().accumulate(mixBuffer, source, stereoSamples * 2);
 }
+
+// =============================================================================
+//  Build flavors (see BuildFlavor.h)
+// =============================================================================
+
+template class BasicSpatialAudio<BuildFlavor::Plugin>;
+template class BasicSpatialAudio<BuildFlavor::Upload>;
@@ -1,5 +1,12 @@
 #pragma once
 #include "Protocol.h"
+#include "BuildFlavor.h"
+#include "SpatialTables.h"
+#include "SpatialKernels.h"
+#include "DopplerEngine.h"
+#include "ReverbEngine.h"
+#include "DistanceModel.h"
+#include "FractionalDelay.h"
 #include <vector>
 #include <array>
 #include <cmath>
@@ -11,23 +18,44 @@
  * Full binaural 3D simulation with:
  *   - HRTF-based binaural rendering (head-related transfer function)
  *     · Frequency-dependent ILD (interaural level difference)
- *     · ITD simulation (interaural time delay up to ~0.7ms)
+ *     · ITD simulation (interaural time delay up to ~0.7ms, band-limited
+ *       fractional delay, see FractionalDelay)
  *     · Pinna/head shadow frequency shaping per ear
- *   - Distance-based processing:
- *     · Inverse-square / smoothstep rolloff
+ *     · Elevation cues from the full listener orientation (yaw/pitch/roll)
+ *   - Distance-based processing (DistanceModel, one table lookup per packet):
+ *     · Selectable attenuation curve that honors the rolloff factor
  *     · Air absorption (high-frequency attenuation over distance)
- *     · Distance-dependent reverb (wet/dry mix)
+ *     · Distance high-pass and reverb send level
  *   - Environment simulation:
- *     · Schroeder reverb (4 comb filters + 2 allpass filters)
- *     · Early reflections (6 taps simulating stadium walls/floor/ceiling)
- *     · Late diffuse reverb tail
- *   - Smooth parameter interpolation to avoid clicks/pops
+ *     · Distance-dependent reverb send into the shared ReverbEngine bus
+ *       owned by AudioEngine (one late reverb for all peers)
+ *     · Per-source early reflections from the baked arena grid
+ *   - Block-rate linear parameter ramps to avoid clicks/pops
  *   - Per-source independent processing state
+ *   - Level-of-detail tiers (see Tier), crossfaded over one frame on change
+ *
+ * Processing runs in blocks of up to BLOCK_SIZE samples, one stage at a
+ * time (ramp → absorb → elevation → doppler → ITD → shadow → gain → HP → reverb
+ * send). Doppler runs once on the mono signal (DopplerEngine) and is
+ * bypassed while the pitch sits at unity. Recursive stages stay scalar;
+ * element-wise stages use the SIMD kernels picked at runtime by
+ * SpatialKernels::active(). Per-packet geometry (listener basis,
+ * azimuth/elevation, ITD/ILD, head-shadow and elevation cue coefficients)
+ * is read from SpatialTables.
+ *
+ * SpatialBatch renders the Full tier of many sources together, with their
+ * filter recursions vectorized across sources; the state stays here.
+ *
+ * Templated on a BuildFlavor policy (Doppler strength and range, whether
+ * the distance high-pass exists); SpatialAudio is the flavor of this build.
  */
-class SpatialAudio {
+template <class Flavor>
+class BasicSpatialAudio {
+    template <class> friend class BasicSpatialBatch;   // Runs the Full tier of many sources at once
+
 public:
-    SpatialAudio();
-    ~SpatialAudio() = default;
+    BasicSpatialAudio();
+    ~BasicSpatialAudio() = default;
 
     void setDistanceParams(float innerRadius, float outerRadius, float rolloff = 1.0f);
     void setEnabled(bool enabled) { enabled_ = enabled; }
@@ -36,18 +64,83 @@ public:
     void setReverbMix(float mix) { reverbMix_ = std::clamp(mix, 0.0f, 1.0f); }
     void setReverbEnabled(bool e) { reverbEnabled_ = e; }
 
-    float getInnerRadius() const { return innerRadius_; }
-    float getOuterRadius() const { return outerRadius_; }
-    float getRolloff() const { return rolloff_; }
+    /** Curve, rolloff and custom points; the table rebuilds only when they change. */
+    void setDistanceModel(const DistanceModel::Settings& settings);
+    const DistanceModel::Settings& getDistanceModel() const { return distanceModel().settings(); }
+
+    /**
+     * Read distances from a model built elsewhere (AudioEngine shares one
+     * table between all peers) instead of this instance's own; nullptr goes
+     * back to the own one. The caller keeps it alive and unchanged while
+     * this instance renders.
+     */
+    void shareDistanceModel(const DistanceModel* model) { sharedDistance_ = model; }
+
+    float getInnerRadius() const { return getDistanceModel().inner; }
+    float getOuterRadius() const { return getDistanceModel().outer; }
+    float getRolloff() const { return getDistanceModel().rolloff; }
     float getReverbMix() const { return reverbMix_; }
+    float getMasterVolume() const { return masterVolume_; }
+
+    /**
+     * Arena occlusion from ArenaOcclusion::openness() (1 = clear line of
+     * sight, 0 = fully blocked). Call once per position update; the value
+     * is smoothed across updates and applied by place() as a gain and an
+     * extra low-pass on the air-absorption filter.
+     */
+    void setOcclusion(float openness);
+    float getOcclusion() const { return openness_; }
+
+    /** Output level boost applied on top of distance × master gain (shared with mix-time renderers) */
+    static constexpr float OUTPUT_GAIN_BOOST = 1.8f;
+
+    /**
+     * Rendering level of detail, picked per peer by AudioEngine:
+     *   Full    — binaural (ITD + head shadow + elevation cue) + air absorption
+     *             + Doppler + early reflections + reverb send
+     *   Reduced — ILD pan + distance gain + reverb send (shared late tail only)
+     *   Minimal — ILD pan + distance gain
+     * The next process() call crossfades from the old tier to the new one.
+     */
+    enum class Tier { Full, Reduced, Minimal };
+    void setTier(Tier tier);
+    Tier getTier() const { return tier_; }
 
     /**
      * Process mono input into stereo output with full 3D spatialization.
+     * If reverbSendOut is given (frameSize mono samples), it receives this
+     * source's reverb send for the shared bus; otherwise no reverb is produced.
      * Returns volume multiplier applied (0 = silent / out of range).
      */
     float process(const float* monoIn, int frameSize, float* stereoOut,
-                  const Protocol::Vec3& listenerPos, int listenerYaw,
-                  const Protocol::Vec3& sourcePos);
+                  const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                  const Protocol::Vec3& sourcePos,
+                  float* reverbSendOut = nullptr);
+
+    /** Listener-relative placement of one source, shared by every renderer. */
+    struct Placement {
+        float distUU;       // Distance in Unreal units
+        float azimuth;      // Radians; 0 = front, positive = rendered to the left ear, ±PI = behind
+        float elevation;    // Radians; 0 = ear level, positive = above the listener
+        float lateral;      // Azimuth with the vertical component folded in (ITD/ILD angle)
+        float distVolume;   // Distance attenuation (0 = out of range)
+        float reverbSend;   // Send level into the shared reverb bus
+        float airAlpha;     // Air absorption one-pole LP (1 = none)
+        float hpAlpha;      // Distance high-pass (1 = none)
+    };
+
+    /** Compute direction and the distance-model parameters without rendering. */
+    Placement place(const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                    const Protocol::Vec3& sourcePos) const;
+
+    /**
+     * Add geometry-aware early reflections of a reverb send into stereoOut.
+     * process() does this itself; mix-time renderers call it with their own
+     * send once per block.
+     */
+    void renderEarlyReflections(const float* send, int n, float* stereoOut,
+                                const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                                const Protocol::Vec3& sourcePos);
 
     /** Additive mix source into mixBuffer. */
     static void mixInto(float* mixBuffer, const float* source, int stereoSamples);
@@ -58,56 +151,15 @@ public:
 private:
     // ── HRTF / Binaural ──────────────────────────────────────────────────
 
-    /** Head model constants */
-    static constexpr float HEAD_RADIUS_M   = 0.0875f;   // ~8.75cm
-    static constexpr float SPEED_OF_SOUND  = 343.0f;    // m/s at ~20°C
-    static constexpr float MAX_ITD_SECONDS = HEAD_RADIUS_M / SPEED_OF_SOUND; // ~0.255ms
-    static constexpr int   MAX_ITD_SAMPLES = static_cast<int>(MAX_ITD_SECONDS * 48000.0f + 2); // ~13 samples
-
-    /** Delay line for ITD simulation */
-    struct DelayLine {
-        std::array<float, 64> buffer{};  // Ring buffer (power of 2 for efficiency)
-        int writePos = 0;
+    /** Head model constants (ITD/ILD/shadow live in SpatialTables) */
+    static constexpr float SPEED_OF_SOUND = SpatialTables::SPEED_OF_SOUND;
 
-        void write(float sample) {
-            buffer[writePos & 63] = sample;
-            writePos++;
-        }
-        float read(float delaySamples) const {
-            // Linear interpolation for fractional delay
-            int pos = writePos - 1;
-            int d0 = static_cast<int>(delaySamples);
-            float frac = delaySamples - d0;
-            float s0 = buffer[(pos - d0) & 63];
-            float s1 = buffer[(pos - d0 - 1) & 63];
-            return s0 + frac * (s1 - s0);
-        }
-    };
-
-    /** Large delay line for Doppler pitch-shifting via variable-rate read */
-    static constexpr int DOPPLER_BUF_SIZE = 4096;  // Must be power of 2
-    static constexpr int DOPPLER_BUF_MASK = DOPPLER_BUF_SIZE - 1;
-    struct DopplerLine {
-        std::array<float, DOPPLER_BUF_SIZE> buffer{};
-        int writePos = 0;
-        double readPos = 0.0;  // fractional read position
-
-        void write(float sample) {
-            buffer[writePos & DOPPLER_BUF_MASK] = sample;
-            writePos++;
-        }
-        float readAt(double pos) const {
-            int i0 = static_cast<int>(pos) & DOPPLER_BUF_MASK;
-            int i1 = (i0 + 1) & DOPPLER_BUF_MASK;
-            double frac = pos - std::floor(pos);
-            return static_cast<float>(buffer[i0] * (1.0 - frac) + buffer[i1] * frac);
-        }
-        void reset() {
-            buffer.fill(0.0f);
-            writePos = 0;
-            readPos = 0.0;
-        }
-    };
+    /**
+     * ITD interpolator: the Full tier's delays sweep with the source, so
+     * Lagrange3 (Farrow, no per-sample design) rather than an allpass.
+     */
+    using ItdInterpolator = FractionalDelay::Lagrange3;
+    using ItdDelayLine = FractionalDelay::DelayLine<ItdInterpolator>;
 
     /** Two-pole head shadow filter (models high-freq attenuation around head) */
     struct HeadShadowFilter {
@@ -115,7 +167,11 @@ private:
         float a1 = 0.0f, a2 = 0.0f;
         float z1 = 0.0f, z2 = 0.0f;
 
-        void setCoeffs(float angle, float sampleRate);
+        /** One-pole LP from precomputed coefficients (b1 == b0). */
+        void setCoeffs(float b0_, float a1_) {
+            b0 = b0_; b1 = b0_; b2 = 0.0f;
+            a1 = a1_; a2 = 0.0f;
+        }
         float process(float in);
         void reset() { z1 = z2 = 0.0f; }
     };
@@ -130,9 +186,21 @@ private:
         void reset() { prev = 0.0f; }
     };
 
+    /** Elevation spectral cue: one-pole split, highs scaled by hfGain.
+     *  Same for both ears, so it runs once on the mono signal. */
+    struct ElevationCueFilter {
+        float lp = 0.0f;
+        float process(float in, float alpha, float hfGain) {
+            lp += alpha * (in - lp);
+            return lp + hfGain * (in - lp);
+        }
+        void reset() { lp = 0.0f; }
+    };
+
     /** Distance-dependent high-pass filter (removes bass at distance).
      *  Simulates the real-world phenomenon where low frequencies
-     *  lose energy over long distances. One-pole HP design. */
+     *  lose energy over long distances. One-pole HP design.
+     *  Compiled out unless Flavor::DISTANCE_HIGH_PASS. */
     struct DistanceHighPassFilter {
         float prevIn  = 0.0f;
         float prevOut = 0.0f;
@@ -146,132 +214,138 @@ private:
         void reset() { prevIn = prevOut = 0.0f; }
     };
 
-    // ── Reverb Engine (Schroeder-style) ──────────────────────────────────
-
-    /** Comb filter for reverb tail */
-    struct CombFilter {
-        std::vector<float> buffer;
-        int writePos = 0;
-        float feedback = 0.0f;
-        float damp = 0.0f;
-        float dampState = 0.0f;
-
-        void init(int delaySamples, float fb, float dmp) {
-            buffer.resize(delaySamples, 0.0f);
-            writePos = 0;
-            feedback = fb;
-            damp = dmp;
-            dampState = 0.0f;
+    // ── Block-rate parameter ramps ───────────────────────────────────────
+
+    /** Ramp segment length: parameters are evaluated every RAMP_STEP samples */
+    static constexpr int RAMP_STEP = 64;
+
+    /** One-pole smoothing coefficients (per sample) */
+    static constexpr float PARAM_SMOOTH   = 0.0004f;   // ≈ 55ms time constant at 48kHz
+
+    /** Pitch ratios closer to 1 than this (~1.7 cents) are inaudible and snap to unity */
+    static constexpr float DOPPLER_DEADZONE = 0.001f;
+    /** Ramp residue below which the pitch counts as settled at unity */
+    static constexpr float DOPPLER_UNITY_EPSILON = 1e-5f;
+
+    /** Smoothed parameter rendered as piecewise-linear ramps.
+     *  The old per-sample one-pole (current += coeff * (target - current)) is
+     *  solved in closed form at every RAMP_STEP boundary, and the samples in
+     *  between are a straight line to that value. Same envelope and time
+     *  constant, but no serial dependency, so the fill vectorizes. */
+    struct LinearRamp {
+        float current   = 0.0f;
+        float target    = 0.0f;
+        float coeff     = 0.0f;
+        float stepDecay = 1.0f;   // (1 - coeff)^RAMP_STEP
+
+        void setCoeff(float c) {
+            coeff = c;
+            stepDecay = std::pow(1.0f - c, static_cast<float>(RAMP_STEP));
         }
-        float process(float in) {
-            float out = buffer[writePos];
-            // Damped feedback
-            dampState = out * (1.0f - damp) + dampState * damp;
-            buffer[writePos] = in + dampState * feedback;
-            writePos = (writePos + 1) % static_cast<int>(buffer.size());
-            return out;
-        }
-        void clear() {
-            std::fill(buffer.begin(), buffer.end(), 0.0f);
-            dampState = 0.0f;
-        }
-    };
-
-    /** Allpass filter for reverb diffusion */
-    struct AllpassFilter {
-        std::vector<float> buffer;
-        int writePos = 0;
-        float feedback = 0.5f;
+        void set(float val) { target = val; }
+        void snap(float val) { current = target = val; }
 
-        void init(int delaySamples, float fb = 0.5f) {
-            buffer.resize(delaySamples, 0.0f);
-            writePos = 0;
-            feedback = fb;
-        }
-        float process(float in) {
-            float delayed = buffer[writePos];
-            float out = -in + delayed;
-            buffer[writePos] = in + delayed * feedback;
-            writePos = (writePos + 1) % static_cast<int>(buffer.size());
-            return out;
-        }
-        void clear() { std::fill(buffer.begin(), buffer.end(), 0.0f); }
+        /** Write the next n samples of the ramp into dst and advance. */
+        void fill(const SpatialKernels::KernelTable& k, float* dst, int n);
     };
 
-    /** Early reflection tap */
-    struct EarlyReflection {
-        int delaySamples;
-        float gainL, gainR;   // per-ear gain (simulates reflection direction)
-    };
+    // ── Block processing ─────────────────────────────────────────────────
 
-    /** Full reverb unit */
-    struct ReverbEngine {
-        // 4 parallel comb filters (Schroeder design)
-        std::array<CombFilter, 4> combsL;
-        std::array<CombFilter, 4> combsR;
-        // 2 series allpass filters
-        std::array<AllpassFilter, 2> allpassL;
-        std::array<AllpassFilter, 2> allpassR;
-        // Early reflections delay line
-        std::vector<float> earlyDelayLine;
-        int earlyWritePos = 0;
-        static constexpr int EARLY_DELAY_SIZE = 4096;
-
-        // 6 early reflection taps (stadium-like environment)
-        std::array<EarlyReflection, 6> earlyTaps;
-
-        void init(float sampleRate);
-        void process(float monoIn, float& outL, float& outR);
-        void clear();
+    /** Max samples per block stage (960-sample frames run as 256+256+256+192) */
+    static constexpr int BLOCK_SIZE = 256;
+
+    /** Per-frame constants shared by all blocks of one process() call */
+    struct FrameParams {
+        float airAlpha;
+        float hpAlpha;
+        float cueAlpha;
+        float distVolume;
     };
 
-    // ── Smooth parameter interpolation ───────────────────────────────────
-    struct SmoothParam {
-        float current = 0.0f;
-        float target  = 0.0f;
-        float smooth(float coeff = 0.005f) {
-            current += coeff * (target - current);
-            return current;
-        }
-        void set(float val) { target = val; }
-        void snap(float val) { current = target = val; }
+    /** Scratch buffers for one block (per instance, so no heap or sharing) */
+    struct BlockScratch {
+        alignas(32) std::array<float, BLOCK_SIZE> gainL, gainR;
+        alignas(32) std::array<float, BLOCK_SIZE> delayL, delayR;
+        alignas(32) std::array<float, BLOCK_SIZE> reverbSend, pitch, cueHf;
+        alignas(32) std::array<float, BLOCK_SIZE> absorbed, cued, shifted;
+        alignas(32) std::array<float, BLOCK_SIZE> left, right;
+        alignas(32) std::array<float, BLOCK_SIZE> filteredL, filteredR;
+        alignas(32) std::array<float, BLOCK_SIZE> reverbIn;
     };
 
-    // ── Utility ──────────────────────────────────────────────────────────
-    static float smoothstep(float edge0, float edge1, float x);
-    static float yawToRadians(int yaw);
-    static float unitsToMeters(float uu) { return uu / 100.0f; }  // UE4: 1uu ≈ 1cm
+    void processBlock(const float* monoIn, int n, float* stereoOut,
+                      float* reverbSendOut, const FrameParams& fp);
+
+    // ── Tiers ────────────────────────────────────────────────────────────
+
+    void renderTier(Tier tier, const float* monoIn, int frameSize, float* stereoOut,
+                    float* reverbSendOut,
+                    const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                    const Protocol::Vec3& sourcePos, const Placement& pl);
+    void renderFull(const float* monoIn, int frameSize, float* stereoOut,
+                    float* reverbSendOut,
+                    const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                    const Protocol::Vec3& sourcePos, const Placement& pl);
+    /** Full-tier frame setup (ramp targets, filter coefficients, Doppler pitch,
+     *  reflection taps); the blocks then run here or in SpatialBatch. */
+    FrameParams beginFull(bool withSend,
+                          const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                          const Protocol::Vec3& sourcePos, const Placement& pl);
+    /** Reduced (with send) and Minimal (reverbSendOut == nullptr) */
+    void renderLite(const float* monoIn, int frameSize, float* stereoOut,
+                    float* reverbSendOut, const Placement& pl);
+    void resetFullChain();
+
+    const DistanceModel& distanceModel() const { return sharedDistance_ ? *sharedDistance_ : distance_; }
 
     // ── State ────────────────────────────────────────────────────────────
     bool  enabled_        = true;
-    float innerRadius_    = Protocol::DEFAULT_FULL_VOL_DISTANCE;
-    float outerRadius_    = Protocol::DEFAULT_MAX_DISTANCE;
-    float rolloff_        = 1.0f;
+    DistanceModel distance_;   // Radii, curve, rolloff and the baked table
+    const DistanceModel* sharedDistance_ = nullptr;   // Used instead of distance_ if set
+    float openness_       = 1.0f;   // Smoothed arena occlusion (1 = clear)
     float masterVolume_   = 1.0f;
     bool  reverbEnabled_  = true;
     float reverbMix_      = 0.90f;   // 0 = dry only, 1 = full wet (heavy reverb)
 
     // Per-source processing state
-    DelayLine delayL_, delayR_;
+    ItdDelayLine delayL_, delayR_;
     HeadShadowFilter headFilterL_, headFilterR_;
     AirAbsorptionFilter airAbsL_, airAbsR_;
     AirAbsorptionFilter airAbsMono_;   // Pre-reverb absorption
+    ElevationCueFilter elevationCue_;  // After the reverb tap (the room has no elevation)
     DistanceHighPassFilter distHpL_, distHpR_;  // Distance bass rolloff
-    ReverbEngine reverb_;
+    EarlyReflections early_;           // Fed by the reverb send
 
     // Doppler effect state
-    DopplerLine dopplerL_, dopplerR_;
+    DopplerEngine doppler_;            // Shared by both ears
     float prevDistUU_ = -1.0f;         // Previous frame distance (for velocity)
-    float dopplerPitchRatio_ = 1.0f;   // Current pitch multiplier
-    static constexpr float DOPPLER_EXAGGERATION = 4.0f;   // Strong audible Doppler
-    static constexpr float DOPPLER_SMOOTH = 0.002f;       // Responsive smoothing
+
+    // Occlusion: fully blocked ≈ -9 dB with a ~1 kHz low-pass on top of air absorption
+    static constexpr float OCCLUDED_GAIN      = 0.35f;
+    static constexpr float OCCLUDED_AIR_ALPHA = 0.12f;
+    static constexpr float OCCLUSION_SMOOTH   = 0.3f;   // Per update (~60ms at 50 packets/s)
 
     // Smooth interpolation for gains and panning
-    SmoothParam smoothGainL_, smoothGainR_;
-    SmoothParam smoothDelayL_, smoothDelayR_;
-    SmoothParam smoothVolume_;
-    SmoothParam smoothReverbSend_;
-    SmoothParam smoothDopplerPitch_;
+    LinearRamp smoothGainL_, smoothGainR_;
+    LinearRamp smoothDelayL_, smoothDelayR_;
+    LinearRamp smoothReverbSend_;
+    LinearRamp smoothCueHf_;
+    LinearRamp smoothDopplerPitch_;
 
     bool firstFrame_ = true;   // Snap parameters on first frame
+
+    BlockScratch scratch_;
+
+    // Level of detail
+    Tier tier_         = Tier::Full;
+    Tier renderedTier_ = Tier::Full;   // Tier of the last rendered frame
+    float liteGainL_ = 0.0f, liteGainR_ = 0.0f, liteSend_ = 0.0f;   // End of the last lite frame
+    bool  litePrimed_ = false;
+    alignas(32) std::array<float, Protocol::FRAME_SIZE * 2> fadeStereo_{};   // Outgoing tier
+    alignas(32) std::array<float, Protocol::FRAME_SIZE> fadeSend_{};
 };
+
+extern template class BasicSpatialAudio<BuildFlavor::Plugin>;
+extern template class BasicSpatialAudio<BuildFlavor::Upload>;
+
+using SpatialAudio = BasicSpatialAudio<BuildFlavor::Active>;
@@ -0,0 +1,378 @@
+#include "SpatialBatch.h"
+#include "SpatialKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+constexpr int LANES = SpatialBatch::MAX_SOURCES;   // Row stride of the sample-major buffers
+constexpr int TILE  = 8;                           // Transpose tile: TILE lanes × TILE samples
+
+/** Lane-major runs (one pointer per lane) → sample-major rows, in tiles. */
+void lanesToRows(float* rows, const float* const* lanes, int m, int n) {
+    for (int s0 = 0; s0 < m; s0 += TILE) {
+        const int s1 = std::min(m, s0 + TILE);
+        for (int i0 = 0; i0 < n; i0 += TILE) {
+            const int i1 = std::min(n, i0 + TILE);
+            for (int s = s0; s < s1; s++)
+                for (int i = i0; i < i1; i++) rows[static_cast<size_t>(i) * LANES + s] = lanes[s][i];
+        }
+    }
+}
+
+/** Sample-major rows → lane-major runs, in tiles; dstStep spaces the samples (2 = interleaved). */
+void rowsToLanes(float* const* lanes, int dstStep, const float* rows, int m, int n) {
+    for (int s0 = 0; s0 < m; s0 += TILE) {
+        const int s1 = std::min(m, s0 + TILE);
+        for (int i0 = 0; i0 < n; i0 += TILE) {
+            const int i1 = std::min(n, i0 + TILE);
+            for (int s = s0; s < s1; s++)
+                for (int i = i0; i < i1; i++) lanes[s][i * dstStep] = rows[static_cast<size_t>(i) * LANES + s];
+        }
+    }
+}
+}
+
+// =============================================================================
+//  Constructor
+// =============================================================================
+
+template <class Flavor>
+BasicSpatialBatch<Flavor>::BasicSpatialBatch()
+    : rampDecay_(std::pow(1.0f - Spatial::PARAM_SMOOTH,
+                          static_cast<float>(Spatial::RAMP_STEP))),
+      itdRows_(static_cast<size_t>(ITD_PAD + BLOCK) * LANES, 0.0f),
+      rowsA_(static_cast<size_t>(BLOCK) * LANES, 0.0f),
+      rowsB_(static_cast<size_t>(BLOCK) * LANES, 0.0f),
+      absorbed_(static_cast<size_t>(LANES) * BLOCK, 0.0f),
+      shifted_(static_cast<size_t>(LANES) * BLOCK, 0.0f) {}
+
+// =============================================================================
+//  Queue
+// =============================================================================
+
+template <class Flavor>
+float BasicSpatialBatch<Flavor>::submit(Spatial& src, const float* monoIn, int frameSize, float* stereoOut,
+                                        const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                                        const Protocol::Vec3& sourcePos,
+                                        float* reverbSendOut) {
+    // The queued frame must finish before this source's state moves on
+    for (int s = 0; s < count_; s++) {
+        if (jobs_[s].src == &src) { flush(); break; }
+    }
+
+    const bool steady = src.enabled_ &&
+        src.tier_ == Spatial::Tier::Full && src.renderedTier_ == Spatial::Tier::Full;
+    if (!steady || frameSize <= 0 || frameSize > MAX_FRAME) {
+        return src.process(monoIn, frameSize, stereoOut, listenerPos, listenerRot, sourcePos,
+                           reverbSendOut);
+    }
+
+    // Same prologue as SpatialAudio::process()
+    std::memset(stereoOut, 0, sizeof(float) * frameSize * 2);
+    if (reverbSendOut) std::memset(reverbSendOut, 0, sizeof(float) * frameSize);
+
+    const typename Spatial::Placement pl = src.place(listenerPos, listenerRot, sourcePos);
+    if (pl.distVolume <= 0.0f) return 0.0f;
+
+    if (count_ == MAX_SOURCES || (count_ > 0 && frameSize != frameSize_)) flush();
+
+    frameSize_ = frameSize;
+    jobs_[count_++] = { &src, monoIn, stereoOut, reverbSendOut,
+                        src.beginFull(reverbSendOut != nullptr, listenerPos, listenerRot, sourcePos, pl) };
+    return pl.distVolume;
+}
+
+template <class Flavor>
+void BasicSpatialBatch<Flavor>::flush() {
+    if (count_ == 0) return;
+
+    // One source has nothing to vectorize across: run its own blocks
+    if (count_ == 1) {
+        const Job& job = jobs_[0];
+        for (int offset = 0; offset < frameSize_; offset += BLOCK) {
+            job.src->processBlock(job.monoIn + offset, std::min(BLOCK, frameSize_ - offset),
+                                  job.stereoOut + offset * 2,
+                                  job.sendOut ? job.sendOut + offset : nullptr, job.fp);
+        }
+        count_ = 0;
+        return;
+    }
+
+    loadLanes();
+    for (int offset = 0; offset < frameSize_; offset += BLOCK) {
+        renderBlock(offset, std::min(BLOCK, frameSize_ - offset));
+    }
+    storeLanes();
+
+    count_ = 0;
+}
+
+// =============================================================================
+//  Lane state in / out
+// =============================================================================
+
+template <class Flavor>
+void BasicSpatialBatch<Flavor>::loadLanes() {
+    for (int s = 0; s < count_; s++) {
+        const Spatial& src = *jobs_[s].src;
+        const typename Spatial::FrameParams& fp = jobs_[s].fp;
+
+        airPrev_[s]   = src.airAbsMono_.prev;
+        cueLp_[s]     = src.elevationCue_.lp;
+        shadowZL_[s]  = src.headFilterL_.z1;
+        shadowZR_[s]  = src.headFilterR_.z1;
+        if constexpr (Flavor::DISTANCE_HIGH_PASS) {
+            hpInL_[s]  = src.distHpL_.prevIn;
+            hpOutL_[s] = src.distHpL_.prevOut;
+            hpInR_[s]  = src.distHpR_.prevIn;
+            hpOutR_[s] = src.distHpR_.prevOut;
+            hpAlpha_[s] = fp.hpAlpha;
+        }
+        shadowB0L_[s] = src.headFilterL_.b0;
+        shadowA1L_[s] = src.headFilterL_.a1;
+        shadowB0R_[s] = src.headFilterR_.b0;
+        shadowA1R_[s] = src.headFilterR_.a1;
+        airAlpha_[s]  = fp.airAlpha;
+        cueAlpha_[s]  = fp.cueAlpha;
+
+        const typename Spatial::LinearRamp* ramps[RAMPS] = {
+            &src.smoothGainL_, &src.smoothGainR_, &src.smoothDelayL_, &src.smoothDelayR_, &src.smoothCueHf_
+        };
+        for (int r = 0; r < RAMPS; r++) {
+            rampCurrent_[r][s] = ramps[r]->current;
+            rampTarget_[r][s]  = ramps[r]->target;
+        }
+
+        // Both ITD lines hold the same samples; only the newest ITD_PAD are ever read
+        const auto& line = src.delayL_;
+        for (int row = 0; row < ITD_PAD; row++) {
+            itdRows_[static_cast<size_t>(row) * LANES + s] = line.buffer[(line.writePos - ITD_PAD + row) & ItdLine::MASK];
+        }
+        itdStateL_[s] = src.delayL_.state;
+        itdStateR_[s] = src.delayR_.state;
+    }
+}
+
+template <class Flavor>
+void BasicSpatialBatch<Flavor>::storeLanes() {
+    for (int s = 0; s < count_; s++) {
+        Spatial& src = *jobs_[s].src;
+
+        src.airAbsMono_.prev    = airPrev_[s];
+        src.elevationCue_.lp    = cueLp_[s];
+        src.headFilterL_.z1     = shadowZL_[s];
+        src.headFilterR_.z1     = shadowZR_[s];
+        if constexpr (Flavor::DISTANCE_HIGH_PASS) {
+            src.distHpL_.prevIn  = hpInL_[s];
+            src.distHpL_.prevOut = hpOutL_[s];
+            src.distHpR_.prevIn  = hpInR_[s];
+            src.distHpR_.prevOut = hpOutR_[s];
+        }
+
+        typename Spatial::LinearRamp* ramps[RAMPS] = {
+            &src.smoothGainL_, &src.smoothGainR_, &src.smoothDelayL_, &src.smoothDelayR_, &src.smoothCueHf_
+        };
+        for (int r = 0; r < RAMPS; r++) ramps[r]->current = rampCurrent_[r][s];
+
+        for (auto* line : { &src.delayL_, &src.delayR_ }) {
+            line->writePos += frameSize_;
+            for (int row = 0; row < ITD_PAD; row++) {
+                line->buffer[(line->writePos - ITD_PAD + row) & ItdLine::MASK] = itdRows_[static_cast<size_t>(row) * LANES + s];
+            }
+        }
+        src.delayL_.state = itdStateL_[s];
+        src.delayR_.state = itdStateR_[s];
+    }
+}
+
+// =============================================================================
+//  Block Stages
+//  Same stages and per-sample arithmetic as SpatialAudio::processBlock. The
+//  recursive stages run sample by sample with an inner loop over the lanes;
+//  state and coefficients are copied to locals first so the compiler can
+//  see they do not alias the row buffers, and the lane loops vectorize.
+// =============================================================================
+
+template <class Flavor>
+void BasicSpatialBatch<Flavor>::renderBlock(int offset, int n) {
+    const SpatialKernels::KernelTable& k = SpatialKernels::active();
+    constexpr int STEP = Spatial::RAMP_STEP;
+    constexpr int MAX_SEGMENTS = (BLOCK + STEP - 1) / STEP;
+    const int m = count_;
+
+    // ── Parameter ramps: the LinearRamp segments, one start/step pair per lane ──
+    std::array<std::array<LaneRow, RAMPS>, MAX_SEGMENTS> segStart, segStep;
+    const int segments = (n + STEP - 1) / STEP;
+    for (int seg = 0; seg < segments; seg++) {
+        const int len = std::min(STEP, n - seg * STEP);
+        const float decay = (len == STEP)
+            ? rampDecay_
+            : std::pow(1.0f - Spatial::PARAM_SMOOTH, static_cast<float>(len));
+        for (int r = 0; r < RAMPS; r++) {
+            for (int s = 0; s < m; s++) {
+                const float current = rampCurrent_[r][s];
+                const float end = rampTarget_[r][s] + (current - rampTarget_[r][s]) * decay;
+                segStart[seg][r][s] = current;
+                segStep[seg][r][s]  = (end - current) / static_cast<float>(len);
+                rampCurrent_[r][s]  = end;
+            }
+        }
+    }
+
+    // ── Lanes in: mono input to sample-major rows ──
+    std::array<const float*, MAX_SOURCES> in{};
+    for (int s = 0; s < m; s++) in[s] = jobs_[s].monoIn + offset;
+    lanesToRows(rowsA_.data(), in.data(), m, n);
+
+    // ── Absorb + elevation: air absorption, then the monaural spectral cue ──
+    {
+        LaneRow air = airPrev_, lp = cueLp_;
+        const LaneRow airAlpha = airAlpha_, cueAlpha = cueAlpha_;
+        for (int seg = 0; seg < segments; seg++) {
+            const LaneRow hfStart = segStart[seg][CUE_HF], hfStep = segStep[seg][CUE_HF];
+            const int end = std::min(n, (seg + 1) * STEP);
+            for (int i = seg * STEP; i < end; i++) {
+                float* absorbed = &rowsA_[static_cast<size_t>(i) * LANES];
+                float* cued = &rowsB_[static_cast<size_t>(i) * LANES];
+                const float t = static_cast<float>(i - seg * STEP + 1);
+                for (int s = 0; s < m; s++) {
+                    air[s] = air[s] + airAlpha[s] * (absorbed[s] - air[s]);
+                    lp[s] += cueAlpha[s] * (air[s] - lp[s]);
+                    absorbed[s] = air[s];
+                    cued[s] = lp[s] + (hfStart[s] + hfStep[s] * t) * (air[s] - lp[s]);
+                }
+            }
+        }
+        airPrev_ = air;
+        cueLp_ = lp;
+    }
+
+    // ── Lanes out: absorbed (send tap) and cued to one contiguous run per source ──
+    std::array<float*, MAX_SOURCES> absorbed{}, shifted{};
+    for (int s = 0; s < m; s++) {
+        absorbed[s] = &absorbed_[static_cast<size_t>(s) * BLOCK];
+        shifted[s]  = &shifted_[static_cast<size_t>(s) * BLOCK];
+    }
+    rowsToLanes(absorbed.data(), 1, rowsA_.data(), m, n);
+    rowsToLanes(shifted.data(), 1, rowsB_.data(), m, n);
+
+    // ── Doppler (per source): one mono line, plain delay at unity pitch ──
+    for (int s = 0; s < m; s++) {
+        Spatial& src = *jobs_[s].src;
+        float* signal = shifted[s];
+        typename Spatial::LinearRamp& pitch = src.smoothDopplerPitch_;
+        if (pitch.target == 1.0f && std::abs(pitch.current - 1.0f) < Spatial::DOPPLER_UNITY_EPSILON) {
+            pitch.snap(1.0f);
+            src.doppler_.processUnity(signal, signal, n);
+        } else {
+            pitch.fill(k, pitch_.data(), n);
+            src.doppler_.process(signal, pitch_.data(), signal, n);
+        }
+    }
+    lanesToRows(&itdRows_[static_cast<size_t>(ITD_PAD) * LANES], shifted.data(), m, n);
+
+    // ── ITD → shadow → gain → HP, per ear ──
+    {
+        LaneRow zL = shadowZL_, zR = shadowZR_;
+        LaneRow inL = hpInL_, outL = hpOutL_, inR = hpInR_, outR = hpOutR_;
+        const LaneRow b0L = shadowB0L_, a1L = shadowA1L_, b0R = shadowB0R_, a1R = shadowA1R_;
+        const LaneRow hpAlpha = hpAlpha_;
+        LaneRow left, right;
+
+        // Interpolator design from the mid-block delay, as ItdLine::process() does
+        {
+            const int mid = n / 2, seg = mid / STEP;
+            const float t = static_cast<float>(mid - seg * STEP + 1);
+            for (int s = 0; s < m; s++) {
+                Itd::design(itdStateL_[s], segStart[seg][DELAY_L][s] + segStep[seg][DELAY_L][s] * t);
+                Itd::design(itdStateR_[s], segStart[seg][DELAY_R][s] + segStep[seg][DELAY_R][s] * t);
+            }
+        }
+
+        for (int seg = 0; seg < segments; seg++) {
+            const std::array<LaneRow, RAMPS>& start = segStart[seg];
+            const std::array<LaneRow, RAMPS>& step = segStep[seg];
+            const int end = std::min(n, (seg + 1) * STEP);
+            for (int i = seg * STEP; i < end; i++) {
+                const float* row = &itdRows_[static_cast<size_t>(ITD_PAD + i) * LANES];
+                const float t = static_cast<float>(i - seg * STEP + 1);
+
+                // Fractional delay read from the history rows (a gather: stays scalar)
+                for (int s = 0; s < m; s++) {
+                    const float dL = start[DELAY_L][s] + step[DELAY_L][s] * t;
+                    const float dR = start[DELAY_R][s] + step[DELAY_R][s] * t;
+                    const FractionalDelay::Strided history{ row + s, LANES };
+                    left[s]  = Itd::read(history, dL, itdStateL_[s]);
+                    right[s] = Itd::read(history, dR, itdStateR_[s]);
+                }
+
+                float* outRowL = &rowsA_[static_cast<size_t>(i) * LANES];
+                float* outRowR = &rowsB_[static_cast<size_t>(i) * LANES];
+                for (int s = 0; s < m; s++) {
+                    // Head shadow (b1 == b0, b2 == a2 == 0), 95% filtered
+                    const float fL = b0L[s] * left[s] + b0L[s] * zL[s] - a1L[s] * zL[s];
+                    const float fR = b0R[s] * right[s] + b0R[s] * zR[s] - a1R[s] * zR[s];
+                    zL[s] = fL;
+                    zR[s] = fR;
+                    float l = left[s] * 0.05f + fL * 0.95f;
+                    float r = right[s] * 0.05f + fR * 0.95f;
+
+                    // ILD + distance + master
+                    l = l * (start[GAIN_L][s] + step[GAIN_L][s] * t);
+                    r = r * (start[GAIN_R][s] + step[GAIN_R][s] * t);
+
+                    // Distance high-pass
+                    if constexpr (Flavor::DISTANCE_HIGH_PASS) {
+                        outL[s] = hpAlpha[s] * (outL[s] + l - inL[s]);
+                        inL[s] = l;
+                        outR[s] = hpAlpha[s] * (outR[s] + r - inR[s]);
+                        inR[s] = r;
+                        l = outL[s];
+                        r = outR[s];
+                    }
+                    outRowL[s] = l;
+                    outRowR[s] = r;
+                }
+            }
+        }
+        shadowZL_ = zL;
+        shadowZR_ = zR;
+        hpInL_ = inL;
+        hpOutL_ = outL;
+        hpInR_ = inR;
+        hpOutR_ = outR;
+    }
+
+    // Keep the newest rows as history for the next block
+    std::memmove(itdRows_.data(), &itdRows_[static_cast<size_t>(n) * LANES],
+                 sizeof(float) * ITD_PAD * LANES);
+
+    // ── Lanes out (interleaved) + reverb send and early reflections (per source) ──
+    std::array<float*, MAX_SOURCES> stereoL{}, stereoR{};
+    for (int s = 0; s < m; s++) {
+        stereoL[s] = jobs_[s].stereoOut + offset * 2;
+        stereoR[s] = stereoL[s] + 1;
+    }
+    rowsToLanes(stereoL.data(), 2, rowsA_.data(), m, n);
+    rowsToLanes(stereoR.data(), 2, rowsB_.data(), m, n);
+
+    for (int s = 0; s < m; s++) {
+        const Job& job = jobs_[s];
+        Spatial& src = *job.src;
+        src.smoothReverbSend_.fill(k, sendRamp_.data(), n);
+        if (src.reverbEnabled_ && job.sendOut) {
+            float* send = job.sendOut + offset;
+            k.scale(reverbIn_.data(), absorbed[s], job.fp.distVolume, n);
+            k.multiply(send, reverbIn_.data(), sendRamp_.data(), n);
+            src.early_.render(send, n, stereoL[s]);
+        }
+    }
+}
+
+// =============================================================================
+//  Build flavors (see BuildFlavor.h)
+// =============================================================================
+
+template class BasicSpatialBatch<BuildFlavor::Plugin>;
+template class BasicSpatialBatch<BuildFlavor::Upload>;
@@ -0,0 +1,124 @@
+#pragma once
+#include "Protocol.h"
+#include "SpatialAudio.h"
+#include <array>
+#include <vector>
+
+/**
+ * Structure-of-arrays Full-tier renderer for many SpatialAudio sources.
+ *
+ * SpatialAudio renders one source at a time, so each of its filter
+ * recursions (air absorption, elevation cue, head shadow, distance
+ * high-pass) is a serial chain over time that no SIMD unit can speed up.
+ * Across sources those chains are independent. The batch lines them up as
+ * lanes: every sample of the frame is one row holding all queued sources,
+ * and each recursion runs as a plain loop over the lanes, which vectorizes.
+ *
+ *   submit() (per source) : frame setup on the source (same as process())
+ *   flush()  (once)       : load the queued sources' filter state, delay
+ *                           lines and smoothed parameters into lane arrays,
+ *                           render all of them in lockstep, store it back
+ *
+ * State stays owned by each SpatialAudio and only visits the lane arrays
+ * for the length of a flush (a few dozen floats per source, per frame), so
+ * tier crossfades, packet-loss concealment and the single-source path keep
+ * working on the same state. Doppler and early reflections stay per source
+ * (they run on the source's own engines between the vectorized stages).
+ *
+ * Output is bit-identical to SpatialAudio::process() for the same frames,
+ * including the flavor's stages (the distance high-pass lanes exist only
+ * where BasicSpatialAudio has the stage).
+ *
+ * Not thread-safe: submit()/flush() run on the audio thread.
+ */
+template <class Flavor>
+class BasicSpatialBatch {
+public:
+    using Spatial = BasicSpatialAudio<Flavor>;
+
+    static constexpr int MAX_SOURCES = 64;
+    static constexpr int MAX_FRAME   = Protocol::FRAME_SIZE;
+
+    BasicSpatialBatch();
+
+    BasicSpatialBatch(const BasicSpatialBatch&) = delete;
+    BasicSpatialBatch& operator=(const BasicSpatialBatch&) = delete;
+
+    /**
+     * Queue one frame of src; arguments and return value as in
+     * SpatialAudio::process(). Sources that are not in a steady Full tier
+     * (tier change pending, Reduced/Minimal, disabled) are rendered right
+     * away by process(). monoIn must stay valid and the outputs must not be
+     * read until the next flush(). A source queued twice, a different frame
+     * length or a full batch flushes first.
+     */
+    float submit(Spatial& src, const float* monoIn, int frameSize, float* stereoOut,
+                 const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                 const Protocol::Vec3& sourcePos,
+                 float* reverbSendOut = nullptr);
+
+    /** Render every queued frame. */
+    void flush();
+
+    /** Number of frames waiting for flush(). */
+    int queued() const { return count_; }
+
+private:
+    static constexpr int BLOCK   = Spatial::BLOCK_SIZE;   // Same blocks as processBlock
+    static constexpr int ITD_PAD = 24;                    // History rows ahead of each block
+
+    using Itd = typename Spatial::ItdInterpolator;
+    using ItdLine = typename Spatial::ItdDelayLine;
+    static_assert(SpatialTables::MAX_ITD_SAMPLES + Itd::REACH < ITD_PAD, "ITD history too short");
+    static_assert(ITD_PAD <= ItdLine::SIZE, "ITD history longer than the source's delay line");
+
+    using LaneRow = std::array<float, MAX_SOURCES>;
+
+    struct Job {
+        Spatial* src;
+        const float* monoIn;
+        float* stereoOut;
+        float* sendOut;        // nullptr: no send, no early reflections
+        typename Spatial::FrameParams fp;
+    };
+
+    void loadLanes();
+    void storeLanes();
+    void renderBlock(int offset, int n);
+
+    std::array<Job, MAX_SOURCES> jobs_{};
+    int count_ = 0;
+    int frameSize_ = 0;
+
+    // Lane state, loaded from / stored to the sources around each flush
+    LaneRow airPrev_{}, cueLp_{};
+    LaneRow shadowZL_{}, shadowZR_{};
+    LaneRow hpInL_{}, hpOutL_{}, hpInR_{}, hpOutR_{};
+    LaneRow shadowB0L_{}, shadowA1L_{}, shadowB0R_{}, shadowA1R_{};
+    LaneRow airAlpha_{}, cueAlpha_{}, hpAlpha_{};
+    std::array<typename Itd::State, MAX_SOURCES> itdStateL_{}, itdStateR_{};   // Interpolator state (empty unless recursive)
+
+    // Smoothed parameters ramped per sample: current value and target per lane
+    enum Ramp { GAIN_L, GAIN_R, DELAY_L, DELAY_R, CUE_HF, RAMPS };
+    std::array<LaneRow, RAMPS> rampCurrent_{}, rampTarget_{};
+    float rampDecay_ = 1.0f;   // (1 - PARAM_SMOOTH)^RAMP_STEP, as in LinearRamp
+
+    // Sample-major ITD history: row i holds sample i of every lane
+    std::vector<float> itdRows_;   // (ITD_PAD + BLOCK) × MAX_SOURCES
+
+    // Sample-major working rows (input / absorbed / left, cued / right)
+    std::vector<float> rowsA_;     // BLOCK × MAX_SOURCES
+    std::vector<float> rowsB_;
+
+    // Lane-major signal: absorbed (send tap) and cued → Doppler → shifted
+    std::vector<float> absorbed_;  // MAX_SOURCES × BLOCK
+    std::vector<float> shifted_;   // MAX_SOURCES × BLOCK
+
+    // Per-source scratch for the stages that stay per source
+    alignas(32) std::array<float, BLOCK> pitch_{}, sendRamp_{}, reverbIn_{};
+};
+
+extern template class BasicSpatialBatch<BuildFlavor::Plugin>;
+extern template class BasicSpatialBatch<BuildFlavor::Upload>;
+
+using SpatialBatch = BasicSpatialBatch<BuildFlavor::Active>;
@@ -0,0 +1,92 @@
+#include "SpatialFanout.h"
+#include <algorithm>
+
+template <class Flavor>
+BasicSpatialFanout<Flavor>::BasicSpatialFanout(WorkStealingPool& pool)
+    : pool_(pool) {
+    for (Set& set : sets_) set.owner = this;
+    reserveWorkers(pool.workerCount());
+}
+
+template <class Flavor>
+void BasicSpatialFanout<Flavor>::reserveWorkers(int workers) {
+    const int slots = std::clamp(workers + 1, 1, WorkStealingPool::MAX_SLOTS);
+    for (int s = 0; s < slots; s++) {
+        if (!batches_[s]) batches_[s] = std::make_unique<Batch>();
+    }
+}
+
+template <class Flavor>
+bool BasicSpatialFanout<Flavor>::submit(Spatial& src, const float* monoIn, int frameSize, float* stereoOut,
+                                        const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                                        const Protocol::Vec3& sourcePos,
+                                        float* reverbSendOut, float* distVolumeOut,
+                                        std::atomic<bool>* inFlight) {
+    if (sets_[current_].count == MAX_SOURCES && !sets_[current_].late) render();
+
+    // A set left to late jobs is queued again once they all ended
+    Set& set = sets_[current_];
+    if (set.late) {
+        if (set.running.load(std::memory_order_acquire) > 0) return false;
+        set.late = false;
+        set.count = 0;
+    }
+
+    if (inFlight) inFlight->store(true, std::memory_order_relaxed);
+    set.frames[set.count++] = { &src, monoIn, frameSize, stereoOut, reverbSendOut, distVolumeOut, inFlight,
+                                listenerPos, listenerRot, sourcePos };
+    return true;
+}
+
+template <class Flavor>
+bool BasicSpatialFanout<Flavor>::render(WorkStealingPool::Clock::time_point deadline) {
+    Set& set = sets_[current_];
+    if (set.late) return true;   // Nothing was queued since
+
+    const int jobs = (set.count + JOB_SOURCES - 1) / JOB_SOURCES;
+    set.running.store(jobs, std::memory_order_relaxed);
+    if (pool_.run(jobs, &BasicSpatialFanout::renderJob, &set, deadline)) {
+        set.count = 0;
+        return true;
+    }
+    set.late = true;
+    current_ = (current_ + 1) % SETS;
+    return false;
+}
+
+template <class Flavor>
+bool BasicSpatialFanout<Flavor>::idle() const {
+    for (const Set& set : sets_) {
+        if (set.running.load(std::memory_order_acquire) > 0) return false;
+    }
+    return true;
+}
+
+template <class Flavor>
+void BasicSpatialFanout<Flavor>::renderJob(void* ctx, int job, int slot) {
+    auto* set = static_cast<Set*>(ctx);
+    Batch& batch = *set->owner->batches_[slot];
+
+    const int begin = job * JOB_SOURCES;
+    const int end = std::min(begin + JOB_SOURCES, set->count);
+    for (int i = begin; i < end; i++) {
+        const Frame& f = set->frames[i];
+        const float distVolume = batch.submit(*f.src, f.monoIn, f.frameSize, f.stereoOut,
+                                              f.listenerPos, f.listenerRot, f.sourcePos, f.sendOut);
+        if (f.distVolumeOut) *f.distVolumeOut = distVolume;
+    }
+    batch.flush();
+
+    // Outputs written: the sources are the caller's again, then the set
+    for (int i = begin; i < end; i++) {
+        if (set->frames[i].inFlight) set->frames[i].inFlight->store(false, std::memory_order_release);
+    }
+    set->running.fetch_sub(1, std::memory_order_release);
+}
+
+// =============================================================================
+//  Build flavors (see BuildFlavor.h)
+// =============================================================================
+
+template class BasicSpatialFanout<BuildFlavor::Plugin>;
+template class BasicSpatialFanout<BuildFlavor::Upload>;
@@ -0,0 +1,117 @@
+#pragma once
+#include "Protocol.h"
+#include "SpatialAudio.h"
+#include "SpatialBatch.h"
+#include "WorkStealingPool.h"
+#include <array>
+#include <atomic>
+#include <memory>
+
+/**
+ * Spatializes one period of many SpatialAudio sources across a
+ * WorkStealingPool.
+ *
+ *   submit() (per source) : queue the frame (nothing is rendered yet)
+ *   render() (once)       : cut the queue into jobs of JOB_SOURCES sources;
+ *                           each job runs on whichever pool thread claims
+ *                           it, through that thread's own SpatialBatch
+ *
+ * A job keeps enough sources together for SpatialBatch to fill its SIMD
+ * lanes, and small enough that a lobby full of talkers spreads over all
+ * workers. Up to JOB_SOURCES sources are one job, which run() renders on
+ * the calling thread without waking anyone.
+ *
+ * Output is bit-identical to one SpatialBatch over the same frames (each
+ * source's output only depends on its own state).
+ *
+ * render() may stop waiting at a deadline (see WorkStealingPool::run()).
+ * A job still running on a worker then is late: until it ends, its frames'
+ * inFlight flags stay set (the caller leaves those sources, inputs and
+ * outputs alone meanwhile), and its frame set stays with it while the
+ * queue moves on to the other of SETS. If that one is still late as well,
+ * submit() refuses frames until it is done.
+ *
+ * Not thread-safe: submit()/render() run on one thread (the audio thread);
+ * idle() may be asked from any.
+ */
+template <class Flavor>
+class BasicSpatialFanout {
+public:
+    using Spatial = BasicSpatialAudio<Flavor>;
+    using Batch   = BasicSpatialBatch<Flavor>;
+
+    static constexpr int JOB_SOURCES = 8;
+    static constexpr int MAX_SOURCES = 256;
+    static constexpr int SETS        = 2;   // Frame sets: the one queuing, and one a late job may hold
+
+    explicit BasicSpatialFanout(WorkStealingPool& pool);
+
+    BasicSpatialFanout(const BasicSpatialFanout&) = delete;
+    BasicSpatialFanout& operator=(const BasicSpatialFanout&) = delete;
+
+    /**
+     * Give every slot of a pool with this many workers its SpatialBatch
+     * (allocates; call before the pool grows, off the audio thread).
+     */
+    void reserveWorkers(int workers);
+
+    /**
+     * Queue one frame; arguments as in SpatialBatch::submit(), whose return
+     * (the distance volume) lands in distVolumeOut if given. Buffers must
+     * stay valid and outputs unread until render(), and until inFlight (if
+     * given; set here) is clear again. A full queue renders first. False,
+     * and nothing queued, while every frame set is held by a late job.
+     */
+    bool submit(Spatial& src, const float* monoIn, int frameSize, float* stereoOut,
+                const Protocol::Vec3& listenerPos, const Protocol::Rot& listenerRot,
+                const Protocol::Vec3& sourcePos,
+                float* reverbSendOut = nullptr, float* distVolumeOut = nullptr,
+                std::atomic<bool>* inFlight = nullptr);
+
+    /**
+     * Render every queued frame; returns once all outputs are written, or
+     * false once deadline passed with some jobs late.
+     */
+    bool render(WorkStealingPool::Clock::time_point deadline = WorkStealingPool::Clock::time_point::max());
+
+    /** Number of frames waiting for render(). */
+    int queued() const { return sets_[current_].late ? 0 : sets_[current_].count; }
+
+    /** No late job is running. Any thread. */
+    bool idle() const;
+
+private:
+    struct Frame {
+        Spatial* src;
+        const float* monoIn;
+        int frameSize;
+        float* stereoOut;
+        float* sendOut;
+        float* distVolumeOut;
+        std::atomic<bool>* inFlight;
+        Protocol::Vec3 listenerPos;
+        Protocol::Rot listenerRot;
+        Protocol::Vec3 sourcePos;
+    };
+
+    /** The frames of one render(); a late job keeps reading them after it returned. */
+    struct Set {
+        BasicSpatialFanout* owner = nullptr;
+        std::array<Frame, MAX_SOURCES> frames{};
+        int count = 0;
+        bool late = false;                // Left to late jobs by the last render()
+        std::atomic<int> running{0};      // Jobs of the last render() not yet ended
+    };
+
+    static void renderJob(void* ctx, int job, int slot);
+
+    WorkStealingPool& pool_;
+    std::array<std::unique_ptr<Batch>, WorkStealingPool::MAX_SLOTS> batches_;   // Per pool slot
+    std::array<Set, SETS> sets_;
+    int current_ = 0;                     // The set being queued
+};
+
+extern template class BasicSpatialFanout<BuildFlavor::Plugin>;
+extern template class BasicSpatialFanout<BuildFlavor::Upload>;
+
+using SpatialFanout = BasicSpatialFanout<BuildFlavor::Active>;
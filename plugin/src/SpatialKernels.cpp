@@ -0,0 +1,323 @@
+#include "SpatialKernels.h"
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <array>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define LEO_KERNELS_X86 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace SpatialKernels {
+
+// =============================================================================
+//  Scalar reference kernels
+// =============================================================================
+
+namespace {
+
+void multiplyScalar(float* dst, const float* a, const float* b, int n) {
+    for (int i = 0; i < n; i++) dst[i] = a[i] * b[i];
+}
+
+void scaleScalar(float* dst, const float* src, float gain, int n) {
+    for (int i = 0; i < n; i++) dst[i] = src[i] * gain;
+}
+
+void blendScalar(float* dst, const float* dry, const float* wet,
+                 float dryGain, float wetGain, int n) {
+    for (int i = 0; i < n; i++) dst[i] = dry[i] * dryGain + wet[i] * wetGain;
+}
+
+void accumulateScalar(float* dst, const float* src, int n) {
+    for (int i = 0; i < n; i++) dst[i] += src[i];
+}
+
+void interleaveScalar(float* stereo, const float* l, const float* r, int n) {
+    for (int i = 0; i < n; i++) {
+        stereo[i * 2]     = l[i];
+        stereo[i * 2 + 1] = r[i];
+    }
+}
+
+void accumulateStereoScalar(float* stereo, const float* l, const float* r, int n) {
+    for (int i = 0; i < n; i++) {
+        stereo[i * 2]     += l[i];
+        stereo[i * 2 + 1] += r[i];
+    }
+}
+
+void rampScalar(float* dst, float start, float step, int n) {
+    for (int i = 0; i < n; i++) dst[i] = start + step * static_cast<float>(i + 1);
+}
+
+float peakScalar(const float* src, int n) {
+    float peak = 0.0f;
+    for (int i = 0; i < n; i++) peak = std::max(peak, std::fabs(src[i]));
+    return peak;
+}
+
+} // namespace
+
+const KernelTable& scalarTable() {
+    static const KernelTable t = {
+        Isa::Scalar,
+        multiplyScalar, scaleScalar, blendScalar,
+        accumulateScalar, interleaveScalar, accumulateStereoScalar,
+        rampScalar, peakScalar
+    };
+    return t;
+}
+
+// =============================================================================
+//  SSE2 kernels (4-wide, unaligned loads — scratch buffers may be offset)
+// =============================================================================
+
+#ifdef LEO_KERNELS_X86
+
+namespace {
+
+void multiplySSE2(float* dst, const float* a, const float* b, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    multiplyScalar(dst + i, a + i, b + i, n - i);
+}
+
+void scaleSSE2(float* dst, const float* src, float gain, int n) {
+    const __m128 g = _mm_set1_ps(gain);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), g));
+    }
+    scaleScalar(dst + i, src + i, gain, n - i);
+}
+
+void blendSSE2(float* dst, const float* dry, const float* wet,
+               float dryGain, float wetGain, int n) {
+    const __m128 gd = _mm_set1_ps(dryGain);
+    const __m128 gw = _mm_set1_ps(wetGain);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 d = _mm_mul_ps(_mm_loadu_ps(dry + i), gd);
+        __m128 w = _mm_mul_ps(_mm_loadu_ps(wet + i), gw);
+        _mm_storeu_ps(dst + i, _mm_add_ps(d, w));
+    }
+    blendScalar(dst + i, dry + i, wet + i, dryGain, wetGain, n - i);
+}
+
+void accumulateSSE2(float* dst, const float* src, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    }
+    accumulateScalar(dst + i, src + i, n - i);
+}
+
+void interleaveSSE2(float* stereo, const float* l, const float* r, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 vl = _mm_loadu_ps(l + i);
+        __m128 vr = _mm_loadu_ps(r + i);
+        _mm_storeu_ps(stereo + i * 2,     _mm_unpacklo_ps(vl, vr));
+        _mm_storeu_ps(stereo + i * 2 + 4, _mm_unpackhi_ps(vl, vr));
+    }
+    interleaveScalar(stereo + i * 2, l + i, r + i, n - i);
+}
+
+void accumulateStereoSSE2(float* stereo, const float* l, const float* r, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 vl = _mm_loadu_ps(l + i);
+        __m128 vr = _mm_loadu_ps(r + i);
+        float* out = stereo + i * 2;
+        _mm_storeu_ps(out,     _mm_add_ps(_mm_loadu_ps(out),     _mm_unpacklo_ps(vl, vr)));
+        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_unpackhi_ps(vl, vr)));
+    }
+    accumulateStereoScalar(stereo + i * 2, l + i, r + i, n - i);
+}
+
+void rampSSE2(float* dst, float start, float step, int n) {
+    // Index vector stays an exact integer in float, so every lane computes
+    // the same start + step * (i + 1) as the scalar loop.
+    const __m128 s0 = _mm_set1_ps(start);
+    const __m128 st = _mm_set1_ps(step);
+    const __m128 four = _mm_set1_ps(4.0f);
+    __m128 idx = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(s0, _mm_mul_ps(st, idx)));
+        idx = _mm_add_ps(idx, four);
+    }
+    for (; i < n; i++) dst[i] = start + step * static_cast<float>(i + 1);
+}
+
+float peakSSE2(const float* src, int n) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 m = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        m = _mm_max_ps(m, _mm_and_ps(_mm_loadu_ps(src + i), absMask));
+    }
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    return std::max(_mm_cvtss_f32(m), peakScalar(src + i, n - i));
+}
+
+} // namespace
+
+const KernelTable& sse2Table() {
+    static const KernelTable t = {
+        Isa::SSE2,
+        multiplySSE2, scaleSSE2, blendSSE2,
+        accumulateSSE2, interleaveSSE2, accumulateStereoSSE2,
+        rampSSE2, peakSSE2
+    };
+    return t;
+}
+
+#else
+
+const KernelTable& sse2Table() { return scalarTable(); }
+
+#endif // LEO_KERNELS_X86
+
+// =============================================================================
+//  CPU detection
+// =============================================================================
+
+namespace {
+
+#ifdef LEO_KERNELS_X86
+void cpuid(int leaf, int sub, int regs[4]) {
+#if defined(_MSC_VER)
+    __cpuidex(regs, leaf, sub);
+#else
+    unsigned a, b, c, d;
+    __cpuid_count(leaf, sub, a, b, c, d);
+    regs[0] = static_cast<int>(a); regs[1] = static_cast<int>(b);
+    regs[2] = static_cast<int>(c); regs[3] = static_cast<int>(d);
+#endif
+}
+
+unsigned long long xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+}
+#endif
+
+Isa queryIsa() {
+#ifdef LEO_KERNELS_X86
+    int regs[4] = {};
+    cpuid(0, 0, regs);
+    const int maxLeaf = regs[0];
+
+    cpuid(1, 0, regs);
+    const bool sse2    = (regs[3] & (1 << 26)) != 0;
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx     = (regs[2] & (1 << 28)) != 0;
+
+    // AVX2 needs CPU support AND the OS saving YMM state on context switch
+    if (maxLeaf >= 7 && osxsave && avx && (xgetbv0() & 0x6) == 0x6) {
+        cpuid(7, 0, regs);
+        if (regs[1] & (1 << 5)) return Isa::AVX2;
+    }
+    if (sse2) return Isa::SSE2;
+#endif
+    return Isa::Scalar;
+}
+
+#ifndef NDEBUG
+/** Run every kernel of `t` against the scalar reference on a fixed signal. */
+void verifyAgainstScalar(const KernelTable& t) {
+    constexpr int N = 67;   // Odd length exercises the scalar tails
+    std::array<float, N> a{}, b{}, c{}, d{};
+    for (int i = 0; i < N; i++) {
+        a[i] = std::sin(0.37f * i);
+        b[i] = std::cos(0.11f * i) * 0.8f;
+        c[i] = 0.5f - 0.01f * i;
+        d[i] = std::sin(1.7f * i) * 0.3f;
+    }
+    const KernelTable& ref = scalarTable();
+    std::array<float, N * 2> outRef{}, outSimd{};
+
+    auto check = [&](int count) {
+        for (int i = 0; i < count; i++) {
+            assert(std::fabs(outRef[i] - outSimd[i]) <= TOLERANCE);
+        }
+    };
+
+    ref.multiply(outRef.data(), a.data(), b.data(), N);
+    t.multiply(outSimd.data(), a.data(), b.data(), N);
+    check(N);
+    ref.scale(outRef.data(), a.data(), 0.7f, N);
+    t.scale(outSimd.data(), a.data(), 0.7f, N);
+    check(N);
+    ref.blend(outRef.data(), a.data(), b.data(), 0.05f, 0.95f, N);
+    t.blend(outSimd.data(), a.data(), b.data(), 0.05f, 0.95f, N);
+    check(N);
+    outRef.fill(0.25f); outSimd.fill(0.25f);
+    ref.accumulate(outRef.data(), c.data(), N);
+    t.accumulate(outSimd.data(), c.data(), N);
+    check(N);
+    ref.interleave(outRef.data(), a.data(), b.data(), N);
+    t.interleave(outSimd.data(), a.data(), b.data(), N);
+    check(N * 2);
+    ref.accumulateStereo(outRef.data(), c.data(), d.data(), N);
+    t.accumulateStereo(outSimd.data(), c.data(), d.data(), N);
+    check(N * 2);
+    ref.ramp(outRef.data(), 0.3f, -0.0041f, N);
+    t.ramp(outSimd.data(), 0.3f, -0.0041f, N);
+    check(N);
+    assert(ref.peak(b.data(), N) == t.peak(b.data(), N));
+    assert(ref.peak(d.data(), 3) == t.peak(d.data(), 3));
+}
+#endif
+
+} // namespace
+
+Isa detectIsa() {
+    static const Isa isa = queryIsa();
+    return isa;
+}
+
+const KernelTable& table(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2: return avx2Table();
+        case Isa::SSE2: return sse2Table();
+        default:        return scalarTable();
+    }
+}
+
+const KernelTable& active() {
+    static const KernelTable& selected = [] () -> const KernelTable& {
+        const KernelTable& t = table(detectIsa());
+#ifndef NDEBUG
+        verifyAgainstScalar(t);
+#endif
+        return t;
+    }();
+    return selected;
+}
+
+const char* isaName(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2: return "AVX2";
+        case Isa::SSE2: return "SSE2";
+        default:        return "Scalar";
+    }
+}
+
+} // namespace SpatialKernels
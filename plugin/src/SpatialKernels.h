@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * Vectorized block kernels for the spatial audio pipeline.
+ *
+ * SpatialAudio::process runs its pipeline as a series of block stages
+ * (ramp → absorb → doppler → ITD → shadow → gain → HP → reverb send). The recursive
+ * stages (IIR filters, delay-line reads) stay scalar; the element-wise
+ * stages (and the output limiter's peak detection) go through the function
+ * table below, which is filled once with
+ * the widest implementation the CPU supports:
+ *
+ *   - Scalar : reference implementation, identical to the old per-sample loop
+ *   - SSE2   : 4 floats per op (baseline on every x64 CPU)
+ *   - AVX2   : 8 floats per op (compiled in its own translation unit)
+ *
+ * Every kernel uses the same operation order as the scalar path (no FMA
+ * contraction), so all tiers must match the scalar output within
+ * SpatialKernels::TOLERANCE. Debug builds verify this when the table is
+ * first selected; the kernel_check bench verifies every tier the CPU runs
+ * in any build.
+ */
+namespace SpatialKernels {
+
+    /** Instruction set tiers, ordered from narrowest to widest. */
+    enum class Isa {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /** Max absolute per-sample difference allowed between a SIMD tier and Scalar. */
+    constexpr float TOLERANCE = 1e-6f;
+
+    /** Function table for one instruction set tier. All pointers are non-null. */
+    struct KernelTable {
+        Isa isa;
+
+        /** dst[i] = a[i] * b[i]  (per-sample gain) */
+        void (*multiply)(float* dst, const float* a, const float* b, int n);
+
+        /** dst[i] = src[i] * gain */
+        void (*scale)(float* dst, const float* src, float gain, int n);
+
+        /** dst[i] = dry[i] * dryGain + wet[i] * wetGain  (dst may alias dry) */
+        void (*blend)(float* dst, const float* dry, const float* wet,
+                      float dryGain, float wetGain, int n);
+
+        /** dst[i] += src[i] */
+        void (*accumulate)(float* dst, const float* src, int n);
+
+        /** stereo[2i] = l[i], stereo[2i+1] = r[i] */
+        void (*interleave)(float* stereo, const float* l, const float* r, int n);
+
+        /** stereo[2i] += l[i], stereo[2i+1] += r[i]  (reverb bus return) */
+        void (*accumulateStereo)(float* stereo, const float* l, const float* r, int n);
+
+        /** dst[i] = start + step * (i + 1)  (linear parameter ramp) */
+        void (*ramp)(float* dst, float start, float step, int n);
+
+        /** max |src[i]|, 0 for n == 0  (output limiter peak detection) */
+        float (*peak)(const float* src, int n);
+    };
+
+    /** Widest tier supported by the running CPU (cached after first call). */
+    Isa detectIsa();
+
+    /** Kernel table for the detected tier. Selected once, thread-safe. */
+    const KernelTable& active();
+
+    /** Kernel table for a specific tier (falls back to Scalar if not compiled in). */
+    const KernelTable& table(Isa isa);
+
+    const char* isaName(Isa isa);
+
+    // Per-tier tables (defined in SpatialKernels.cpp / SpatialKernels_AVX2.cpp)
+    const KernelTable& scalarTable();
+    const KernelTable& sse2Table();
+    const KernelTable& avx2Table();
+
+} // namespace SpatialKernels
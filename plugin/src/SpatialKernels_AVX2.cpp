@@ -0,0 +1,142 @@
+// Compiled with AVX2 enabled (/arch:AVX2 or -mavx2, see CMakeLists.txt).
+// Only reached through SpatialKernels::active() after CPUID confirms support,
+// so nothing in here may be called unconditionally.
+#include "SpatialKernels.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+
+namespace SpatialKernels {
+
+namespace {
+
+// Scalar tails are duplicated here (instead of calling into the SSE2/scalar
+// TU) so the whole kernel stays in one AVX2 function without a VZEROUPPER
+// transition in the middle.
+
+void multiplyAVX2(float* dst, const float* a, const float* b, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    for (; i < n; i++) dst[i] = a[i] * b[i];
+}
+
+void scaleAVX2(float* dst, const float* src, float gain, int n) {
+    const __m256 g = _mm256_set1_ps(gain);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), g));
+    }
+    for (; i < n; i++) dst[i] = src[i] * gain;
+}
+
+void blendAVX2(float* dst, const float* dry, const float* wet,
+               float dryGain, float wetGain, int n) {
+    const __m256 gd = _mm256_set1_ps(dryGain);
+    const __m256 gw = _mm256_set1_ps(wetGain);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 d = _mm256_mul_ps(_mm256_loadu_ps(dry + i), gd);
+        __m256 w = _mm256_mul_ps(_mm256_loadu_ps(wet + i), gw);
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(d, w));
+    }
+    for (; i < n; i++) dst[i] = dry[i] * dryGain + wet[i] * wetGain;
+}
+
+void accumulateAVX2(float* dst, const float* src, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+    }
+    for (; i < n; i++) dst[i] += src[i];
+}
+
+/** Interleave 8 L + 8 R samples into 16 stereo samples. */
+inline void storeInterleaved(float* stereo, __m256 vl, __m256 vr) {
+    // unpack works per 128-bit lane: lo = {l0 r0 l1 r1 | l4 r4 l5 r5}
+    //                                hi = {l2 r2 l3 r3 | l6 r6 l7 r7}
+    __m256 lo = _mm256_unpacklo_ps(vl, vr);
+    __m256 hi = _mm256_unpackhi_ps(vl, vr);
+    _mm256_storeu_ps(stereo,     _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps(stereo + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+}
+
+void interleaveAVX2(float* stereo, const float* l, const float* r, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        storeInterleaved(stereo + i * 2, _mm256_loadu_ps(l + i), _mm256_loadu_ps(r + i));
+    }
+    for (; i < n; i++) {
+        stereo[i * 2]     = l[i];
+        stereo[i * 2 + 1] = r[i];
+    }
+}
+
+void accumulateStereoAVX2(float* stereo, const float* l, const float* r, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 lo = _mm256_unpacklo_ps(_mm256_loadu_ps(l + i), _mm256_loadu_ps(r + i));
+        __m256 hi = _mm256_unpackhi_ps(_mm256_loadu_ps(l + i), _mm256_loadu_ps(r + i));
+        float* out = stereo + i * 2;
+        _mm256_storeu_ps(out,     _mm256_add_ps(_mm256_loadu_ps(out),     _mm256_permute2f128_ps(lo, hi, 0x20)));
+        _mm256_storeu_ps(out + 8, _mm256_add_ps(_mm256_loadu_ps(out + 8), _mm256_permute2f128_ps(lo, hi, 0x31)));
+    }
+    for (; i < n; i++) {
+        stereo[i * 2]     += l[i];
+        stereo[i * 2 + 1] += r[i];
+    }
+}
+
+void rampAVX2(float* dst, float start, float step, int n) {
+    const __m256 s0 = _mm256_set1_ps(start);
+    const __m256 st = _mm256_set1_ps(step);
+    const __m256 eight = _mm256_set1_ps(8.0f);
+    __m256 idx = _mm256_setr_ps(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(s0, _mm256_mul_ps(st, idx)));
+        idx = _mm256_add_ps(idx, eight);
+    }
+    for (; i < n; i++) dst[i] = start + step * static_cast<float>(i + 1);
+}
+
+float peakAVX2(const float* src, int n) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 m = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        m = _mm256_max_ps(m, _mm256_and_ps(_mm256_loadu_ps(src + i), absMask));
+    }
+    __m128 h = _mm_max_ps(_mm256_castps256_ps128(m), _mm256_extractf128_ps(m, 1));
+    h = _mm_max_ps(h, _mm_movehl_ps(h, h));
+    h = _mm_max_ss(h, _mm_shuffle_ps(h, h, 1));
+    float peak = _mm_cvtss_f32(h);
+    for (; i < n; i++) {
+        const float a = src[i] < 0.0f ? -src[i] : src[i];
+        peak = a > peak ? a : peak;
+    }
+    return peak;
+}
+
+} // namespace
+
+const KernelTable& avx2Table() {
+    static const KernelTable t = {
+        Isa::AVX2,
+        multiplyAVX2, scaleAVX2, blendAVX2,
+        accumulateAVX2, interleaveAVX2, accumulateStereoAVX2,
+        rampAVX2, peakAVX2
+    };
+    return t;
+}
+
+} // namespace SpatialKernels
+
+#else
+
+namespace SpatialKernels {
+const KernelTable& avx2Table() { return sse2Table(); }
+}
+
+#endif
@@ -0,0 +1,206 @@
+#include "SpatialTables.h"
+#include "Protocol.h"
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+namespace SpatialTables {
+
+// =============================================================================
+//  Reference math
+//  These are the original per-packet formulas from SpatialAudio::process and
+//  HeadShadowFilter::setCoeffs. The tables below are sampled from them.
+// =============================================================================
+
+namespace {
+
+/** One-pole bilinear LP coefficients for the head shadow at a given ear angle. */
+void headShadowCoeffs(float angle, float sampleRate, float& b0, float& a1) {
+    // angle: 0 = front, PI = directly behind, PI/2 = side
+    // Shadow increases as source moves to the opposite ear
+    float shadow = std::clamp(std::sin(angle) * 0.5f + 0.5f, 0.0f, 1.0f);
+
+    // More shadow → lower cutoff — stronger filtering = more stereo perception
+    // Wider range (2kHz–16kHz) for very dramatic head shadow
+    float fc = 16000.0f - shadow * 14000.0f;
+    fc = std::clamp(fc, 2000.0f, 18000.0f);
+
+    float wc = 2.0f * PI * fc / sampleRate;
+    float g = std::tan(wc * 0.5f);
+
+    // Bilinear transform one-pole LP (b1 == b0)
+    b0 = g / (1.0f + g);
+    a1 = (g - 1.0f) / (1.0f + g);
+}
+
+} // namespace
+
+AzimuthEntry computeAzimuthEntry(float azimuth, float sampleRate) {
+    AzimuthEntry e{};
+    float absAzimuth = std::abs(azimuth);
+
+    // Interaural Time Delay (ITD):
+    // Simplified Woodworth: ITD ≈ HEAD_RADIUS/c * sin(azimuth) for the near ear
+    float sinAz = std::sin(azimuth);
+    float itdSamples = std::abs(MAX_ITD_SECONDS * sinAz) * sampleRate;
+    itdSamples = std::min(itdSamples, static_cast<float>(MAX_ITD_SAMPLES));
+
+    // Interaural Level Difference (ILD): 60% max attenuation for dramatic L/R
+    float ildFactor = 1.0f - 0.60f * std::abs(sinAz);
+
+    // INVERTED: source on right → right ear delayed, left ear louder
+    if (azimuth >= 0.0f) {
+        e.delayL = 0.0f;
+        e.delayR = itdSamples;
+        e.gainL  = 1.0f;
+        e.gainR  = ildFactor;
+    } else {
+        e.delayL = itdSamples;
+        e.delayR = 0.0f;
+        e.gainL  = ildFactor;
+        e.gainR  = 1.0f;
+    }
+
+    // Rear attenuation: gentle — sounds behind are slightly softer (up to 30%)
+    float rearFactor = 1.0f;
+    if (absAzimuth > PI * 0.5f) {
+        float rearness = (absAzimuth - PI * 0.5f) / (PI * 0.5f);
+        rearFactor = 1.0f - rearness * 0.30f;
+    }
+    e.gainL *= rearFactor;
+    e.gainR *= rearFactor;
+
+    // Head shadow per ear — INVERTED to match L/R swap
+    float angleToLeftEar  = std::clamp(PI * 0.5f + azimuth, 0.0f, PI);
+    float angleToRightEar = std::clamp(PI * 0.5f - azimuth, 0.0f, PI);
+    headShadowCoeffs(angleToLeftEar,  sampleRate, e.shadowB0L, e.shadowA1L);
+    headShadowCoeffs(angleToRightEar, sampleRate, e.shadowB0R, e.shadowA1R);
+    return e;
+}
+
+ElevationEntry computeElevationEntry(float elevation, float sampleRate) {
+    // elevation: 0 = ear level, +PI/2 = straight up, -PI/2 = straight down
+    float sinEl = std::sin(std::clamp(elevation, -PI * 0.5f, PI * 0.5f));
+
+    ElevationEntry e{};
+    // Crossover tracks the pinna notch, which rises with elevation (4–8kHz)
+    float fc = 6000.0f + 2000.0f * sinEl;
+    e.cueAlpha = 1.0f - std::exp(-2.0f * PI * fc / sampleRate);
+
+    if (sinEl >= 0.0f) {
+        // Above: pinna reflections brighten the top octaves
+        e.hfGain = 1.0f + 0.5f * sinEl;
+        e.gain   = 1.0f;
+    } else {
+        // Below: the torso and car body shadow the highs and some level
+        e.hfGain = 1.0f + 0.6f * sinEl;
+        e.gain   = 1.0f + 0.15f * sinEl;
+    }
+    return e;
+}
+
+// =============================================================================
+//  Tables
+// =============================================================================
+
+namespace {
+
+struct Tables {
+    std::array<AzimuthEntry, AZIMUTH_STEPS + 1> azimuth;
+    std::array<float, ATAN_STEPS + 1> atan;
+    std::array<ElevationEntry, ELEVATION_STEPS + 1> elevation;
+    std::array<float, YAW_STEPS + 1> sin;   // cos is read a quarter turn ahead
+
+    Tables() {
+        const float sr = static_cast<float>(Protocol::SAMPLE_RATE);
+        for (int i = 0; i <= AZIMUTH_STEPS; i++) {
+            float az = -PI + 2.0f * PI * static_cast<float>(i) / AZIMUTH_STEPS;
+            azimuth[i] = computeAzimuthEntry(az, sr);
+        }
+        for (int i = 0; i <= ELEVATION_STEPS; i++) {
+            float el = -0.5f * PI + PI * static_cast<float>(i) / ELEVATION_STEPS;
+            elevation[i] = computeElevationEntry(el, sr);
+        }
+        for (int i = 0; i <= ATAN_STEPS; i++) {
+            atan[i] = std::atan(static_cast<float>(i) / ATAN_STEPS);
+        }
+        for (int i = 0; i <= YAW_STEPS; i++) {
+            sin[i] = std::sin(2.0f * PI * static_cast<float>(i) / YAW_STEPS);
+        }
+    }
+};
+
+const Tables& tables() {
+    static const Tables t;
+    return t;
+}
+
+inline float lerp(float a, float b, float t) { return a + t * (b - a); }
+
+} // namespace
+
+void warmUp() {
+    (void)tables();
+}
+
+AzimuthEntry lookupAzimuth(float azimuth) {
+    const auto& t = tables().azimuth;
+    float pos = (azimuth + PI) * (AZIMUTH_STEPS / (2.0f * PI));
+    pos = std::clamp(pos, 0.0f, static_cast<float>(AZIMUTH_STEPS));
+    int i = std::min(static_cast<int>(pos), AZIMUTH_STEPS - 1);
+    float f = pos - static_cast<float>(i);
+
+    const AzimuthEntry& a = t[i];
+    const AzimuthEntry& b = t[i + 1];
+    return {
+        lerp(a.delayL, b.delayL, f),       lerp(a.delayR, b.delayR, f),
+        lerp(a.gainL, b.gainL, f),         lerp(a.gainR, b.gainR, f),
+        lerp(a.shadowB0L, b.shadowB0L, f), lerp(a.shadowA1L, b.shadowA1L, f),
+        lerp(a.shadowB0R, b.shadowB0R, f), lerp(a.shadowA1R, b.shadowA1R, f)
+    };
+}
+
+ElevationEntry lookupElevation(float elevation) {
+    const auto& t = tables().elevation;
+    float pos = (elevation + PI * 0.5f) * (ELEVATION_STEPS / PI);
+    pos = std::clamp(pos, 0.0f, static_cast<float>(ELEVATION_STEPS));
+    int i = std::min(static_cast<int>(pos), ELEVATION_STEPS - 1);
+    float f = pos - static_cast<float>(i);
+
+    const ElevationEntry& a = t[i];
+    const ElevationEntry& b = t[i + 1];
+    return { lerp(a.gain, b.gain, f), lerp(a.cueAlpha, b.cueAlpha, f), lerp(a.hfGain, b.hfGain, f) };
+}
+
+float azimuthOf(float y, float x) {
+    float ax = std::abs(x), ay = std::abs(y);
+    if (ax == 0.0f && ay == 0.0f) return 0.0f;
+
+    // Reduce to the first octant: atan(t) with t in [0, 1]
+    bool swapped = ay > ax;
+    float ratio = swapped ? ax / ay : ay / ax;
+    float pos = ratio * ATAN_STEPS;
+    int i = std::min(static_cast<int>(pos), ATAN_STEPS - 1);
+    const auto& t = tables().atan;
+    float a = lerp(t[i], t[i + 1], pos - static_cast<float>(i));
+
+    if (swapped) a = PI * 0.5f - a;
+    if (x < 0.0f) a = PI - a;
+    return y < 0.0f ? -a : a;
+}
+
+void rotatorSinCos(int angle, float& sinOut, float& cosOut) {
+    constexpr float UNITS_PER_STEP = 65536.0f / YAW_STEPS;
+    constexpr int   QUARTER = YAW_STEPS / 4;
+
+    float pos = static_cast<float>(angle & 0xFFFF) / UNITS_PER_STEP;
+    int i = std::min(static_cast<int>(pos), YAW_STEPS - 1);
+    float f = pos - static_cast<float>(i);
+
+    const auto& t = tables().sin;
+    sinOut = lerp(t[i], t[i + 1], f);
+    int c = (i + QUARTER) % YAW_STEPS;   // cos(x) = sin(x + 90°)
+    cosOut = lerp(t[c], t[c + 1], f);
+}
+
+} // namespace SpatialTables
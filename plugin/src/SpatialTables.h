@@ -0,0 +1,72 @@
+#pragma once
+
+/**
+ * Precomputed geometry tables for the binaural renderer.
+ *
+ * SpatialAudio used to call atan2/sin/cos/pow per packet and run
+ * HeadShadowFilter::setCoeffs (a tan per ear). All of that is now a table
+ * lookup plus linear interpolation:
+ *
+ *   - rotatorSinCos()   : listener yaw/pitch/roll (UE rotator units) → sin/cos
+ *   - azimuthOf()       : octant-reduced atan table → azimuth in radians
+ *   - lookupAzimuth()   : azimuth → ITD delays, ILD × rear gains and
+ *                         one-pole head-shadow coefficients per ear
+ *   - lookupElevation() : elevation → spectral cue (pinna brightening above,
+ *                         torso shadow below) and level
+ *
+ * In the current head model none of these values depend on distance, so
+ * the tables are indexed by direction only.
+ *
+ * Tables are built once at load time from the reference formulas in
+ * computeAzimuthEntry(), which remain the single source of truth.
+ */
+namespace SpatialTables {
+
+    // ── Head model ───────────────────────────────────────────────────────
+    constexpr float PI              = 3.14159265358979323846f;
+    constexpr float HEAD_RADIUS_M   = 0.0875f;   // ~8.75cm
+    constexpr float SPEED_OF_SOUND  = 343.0f;    // m/s at ~20°C
+    constexpr float MAX_ITD_SECONDS = HEAD_RADIUS_M / SPEED_OF_SOUND; // ~0.255ms
+    constexpr int   MAX_ITD_SAMPLES = static_cast<int>(MAX_ITD_SECONDS * 48000.0f + 2); // ~14 samples
+
+    // ── Table resolution ─────────────────────────────────────────────────
+    constexpr int AZIMUTH_STEPS = 512;    // Intervals over [-PI, PI] (~0.7° each)
+    constexpr int ATAN_STEPS    = 256;    // Intervals over atan([0, 1])
+    constexpr int YAW_STEPS     = 1024;   // Intervals over one full turn
+    constexpr int ELEVATION_STEPS = 128;  // Intervals over [-PI/2, PI/2] (~1.4° each)
+
+    /** Binaural parameters for one source direction. */
+    struct AzimuthEntry {
+        float delayL, delayR;         // ITD in samples (only the far ear is delayed)
+        float gainL, gainR;           // ILD × rear attenuation (before distance/master)
+        float shadowB0L, shadowA1L;   // One-pole head shadow, left ear
+        float shadowB0R, shadowA1R;   // One-pole head shadow, right ear
+    };
+
+    /** Monaural elevation cue, identical for both ears. */
+    struct ElevationEntry {
+        float gain;        // Level (below-horizon sources are slightly softer)
+        float cueAlpha;    // One-pole LP crossover of the spectral cue
+        float hfGain;      // Gain above the crossover (>1 above, <1 below)
+    };
+
+    /** Reference math (the exact per-packet formulas the tables are built from). */
+    AzimuthEntry computeAzimuthEntry(float azimuth, float sampleRate);
+    ElevationEntry computeElevationEntry(float elevation, float sampleRate);
+
+    /** Interpolated table lookup for azimuth in [-PI, PI] (clamped). */
+    AzimuthEntry lookupAzimuth(float azimuth);
+
+    /** Interpolated table lookup for elevation in [-PI/2, PI/2] (clamped). */
+    ElevationEntry lookupElevation(float elevation);
+
+    /** Table-based atan2(y, x) in [-PI, PI]. */
+    float azimuthOf(float y, float x);
+
+    /** Table-based sin/cos of a UE rotator angle (65536 units = 360°, wraps). */
+    void rotatorSinCos(int angle, float& sinOut, float& cosOut);
+
+    /** Build the tables now instead of on first lookup (call off the audio thread). */
+    void warmUp();
+
+} // namespace SpatialTables
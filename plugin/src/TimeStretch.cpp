@@ -0,0 +1,103 @@
+#include "TimeStretch.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+/** Normalized cross-correlation of a[0, n) and b[0, n). */
+float correlation(const float* a, const float* b, int n) {
+    float xc = 0.0f, ea = 0.0f, eb = 0.0f;
+    for (int i = 0; i < n; i++) {
+        xc += a[i] * b[i];
+        ea += a[i] * a[i];
+        eb += b[i] * b[i];
+    }
+    return xc / std::sqrt(ea * eb + 1e-12f);
+}
+
+} // namespace
+
+int TimeStretch::findPeriod(const float* x, int n, int maxPeriod) {
+    n = std::min(n, MAX_FRAME);
+    const int maxLag = std::min({maxPeriod, MAX_PERIOD, n / 2});
+    if (maxLag < MIN_PERIOD) return 0;
+
+    float energy = 0.0f;
+    for (int i = 0; i < n; i++) energy += x[i] * x[i];
+    if (energy < SILENCE_RMS * SILENCE_RMS * static_cast<float>(n)) return maxLag;
+
+    // Coarse search on a decimated copy; the window stays fixed across lags
+    std::array<float, MAX_FRAME / DECIMATE> d;
+    const int m = n / DECIMATE;
+    for (int i = 0; i < m; i++) {
+        const float* s = x + i * DECIMATE;
+        d[i] = (s[0] + s[1] + s[2] + s[3]) * 0.25f;
+    }
+    const int minCoarse = MIN_PERIOD / DECIMATE;
+    const int maxCoarse = maxLag / DECIMATE;
+    const int window = m - maxCoarse;
+
+    float e0 = 0.0f, ep = 0.0f;
+    for (int i = 0; i < window; i++) e0 += d[i] * d[i];
+    for (int i = 0; i < window; i++) ep += d[i + minCoarse] * d[i + minCoarse];
+
+    // Shortest lag close to the best: the pitch period rather than a multiple
+    std::array<float, MAX_PERIOD / DECIMATE + 1> corr;
+    float bestCoarse = -1.0f;
+    for (int p = minCoarse; p <= maxCoarse; p++) {
+        float xc = 0.0f;
+        for (int i = 0; i < window; i++) xc += d[i] * d[i + p];
+        corr[p] = xc / std::sqrt(e0 * ep + 1e-12f);
+        bestCoarse = std::max(bestCoarse, corr[p]);
+        if (p < maxCoarse) ep += d[p + window] * d[p + window] - d[p] * d[p];   // Slide to lag p + 1
+    }
+    int coarse = minCoarse;
+    while (corr[coarse] < bestCoarse - MULTIPLE_TOLERANCE) coarse++;
+    while (coarse < maxCoarse && corr[coarse + 1] > corr[coarse]) coarse++;   // Up to its peak
+
+    // Refine at full rate around the coarse lag
+    const int fullWindow = n - maxLag;
+    int period = 0;
+    float best = MIN_CORRELATION;
+    const int lo = std::max(MIN_PERIOD, coarse * DECIMATE - (DECIMATE - 1));
+    const int hi = std::min(maxLag, coarse * DECIMATE + (DECIMATE - 1));
+    for (int p = lo; p <= hi; p++) {
+        const float c = correlation(x, x + p, fullWindow);
+        if (c >= best) {
+            best = c;
+            period = p;
+        }
+    }
+    return period;
+}
+
+int TimeStretch::accelerate(float* io, int n) {
+    const int p = findPeriod(io, n, MAX_PERIOD);
+    if (p == 0) return n;
+
+    // First period fades out into the second, the rest moves up by one period
+    const float step = 1.0f / static_cast<float>(p);
+    for (int i = 0; i < p; i++) {
+        const float w = (static_cast<float>(i) + 0.5f) * step;
+        io[i] = io[i] * (1.0f - w) + io[i + p] * w;
+    }
+    std::memmove(io + p, io + 2 * p, static_cast<size_t>(n - 2 * p) * sizeof(float));
+    return n - p;
+}
+
+int TimeStretch::expand(float* io, int n, int capacity) {
+    const int p = findPeriod(io, n, capacity - n);
+    if (p == 0) return n;
+
+    // Everything after the first period moves down by one; the gap is the
+    // second period fading out into a repeat of the first
+    std::memmove(io + 2 * p, io + p, static_cast<size_t>(n - p) * sizeof(float));
+    const float step = 1.0f / static_cast<float>(p);
+    for (int i = 0; i < p; i++) {
+        const float w = (static_cast<float>(i) + 0.5f) * step;
+        io[p + i] = io[2 * p + i] * (1.0f - w) + io[i] * w;
+    }
+    return n + p;
+}
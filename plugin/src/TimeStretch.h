@@ -0,0 +1,48 @@
+#pragma once
+#include "Protocol.h"
+
+/**
+ * Speech time-stretch for the playout control of the jitter buffer: one
+ * decoded frame is shortened or lengthened by one pitch period, in place,
+ * without changing its pitch (WSOLA with a single overlap, as in the
+ * accelerate / pre-emptive expand of packet-voice receivers).
+ *
+ *   period     : normalized autocorrelation of the frame, coarse on a 4x
+ *                decimated copy (the shortest lag about as good as the best,
+ *                so a multiple of the period does not win), then refined at
+ *                full rate (MIN_PERIOD … MAX_PERIOD, 100–400 Hz voices)
+ *   accelerate : [a b c …] → [a⤫b c …] (a fades out into b over one period)
+ *   expand     : [a b …]   → [a b⤫a b …] (b fades out into a repeat of a)
+ *
+ * Both ends of the frame are kept, so consecutive frames stay continuous.
+ * A frame that is neither periodic enough (MIN_CORRELATION) nor near
+ * silent (SILENCE_RMS, where any segment may go) is left untouched, and
+ * the caller tries again on the next one.
+ *
+ * Stateless and allocation-free; callable from any thread.
+ */
+class TimeStretch {
+public:
+    static constexpr int   MIN_PERIOD      = Protocol::SAMPLE_RATE / 400;   // 2.5 ms
+    static constexpr int   MAX_PERIOD      = Protocol::SAMPLE_RATE / 100;   // 10 ms
+    static constexpr int   MAX_FRAME       = Protocol::FRAME_SIZE * 2;      // Longest input frame
+    static constexpr float MIN_CORRELATION = 0.8f;
+    static constexpr float SILENCE_RMS     = 0.003f;                        // About -50 dBFS
+
+    /** Shorten io[0, n) by one period; returns the new length (n when the frame was kept). */
+    static int accelerate(float* io, int n);
+
+    /**
+     * Lengthen io[0, n) by one period; io must hold capacity samples (a
+     * period longer than capacity - n is not used). Returns the new length
+     * (n when the frame was kept).
+     */
+    static int expand(float* io, int n, int capacity);
+
+private:
+    static constexpr int DECIMATE = 4;
+    static constexpr float MULTIPLE_TOLERANCE = 0.05f;   // Coarse correlation a shorter lag may give up
+
+    /** Best stretch period of x[0, n) up to maxPeriod, or 0 if the frame must not be stretched. */
+    static int findPeriod(const float* x, int n, int maxPeriod);
+};
@@ -0,0 +1,169 @@
+#include "VbapRenderer.h"
+#include "SpatialTables.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace {
+
+constexpr float PI = SpatialTables::PI;
+constexpr int FRONT_LEFT = 0, FRONT_RIGHT = 1;   // Same channels in every layout
+
+/** One panned speaker: its channel and head-relative azimuth (degrees, positive = left). */
+struct Speaker {
+    int channel;
+    float azimuthDeg;
+};
+
+// Channel indices in WAVEFORMATEXTENSIBLE order; angles per ITU-R BS.775 / BS.2051
+constexpr Speaker QUAD[] = { { 0, 45.0f }, { 1, -45.0f }, { 2, 135.0f }, { 3, -135.0f } };
+constexpr Speaker SURROUND_51[] = { { 0, 30.0f }, { 1, -30.0f }, { 2, 0.0f },
+                                    { 4, 110.0f }, { 5, -110.0f } };
+constexpr Speaker SURROUND_71[] = { { 0, 30.0f }, { 1, -30.0f }, { 2, 0.0f },
+                                    { 4, 150.0f }, { 5, -150.0f }, { 6, 90.0f }, { 7, -90.0f } };
+constexpr int MAX_SPEAKERS = static_cast<int>(std::size(SURROUND_71));
+
+/** Angle in [0, 2·PI). */
+float wrapPositive(float angle) {
+    angle = std::fmod(angle, 2.0f * PI);
+    return angle < 0.0f ? angle + 2.0f * PI : angle;
+}
+
+} // namespace
+
+VbapRenderer::VbapRenderer(Layout layout) {
+    setLayout(layout);
+}
+
+int VbapRenderer::channelsOf(Layout layout) {
+    switch (layout) {
+        case Layout::Quad:       return 4;
+        case Layout::Surround51: return 6;
+        case Layout::Surround71: return 8;
+    }
+    return 2;
+}
+
+void VbapRenderer::setLayout(Layout layout) {
+    layout_ = layout;
+    channels_ = channelsOf(layout);
+
+    const Speaker* table = QUAD;
+    int count = static_cast<int>(std::size(QUAD));
+    switch (layout) {
+        case Layout::Quad:       break;
+        case Layout::Surround51: table = SURROUND_51; count = static_cast<int>(std::size(SURROUND_51)); break;
+        case Layout::Surround71: table = SURROUND_71; count = static_cast<int>(std::size(SURROUND_71)); break;
+    }
+
+    // Ring of speakers counter-clockwise (increasing azimuth); adjacent ones form the pairs
+    std::array<Speaker, MAX_SPEAKERS> speakers{};
+    std::copy(table, table + count, speakers.begin());
+    std::sort(speakers.begin(), speakers.begin() + count,
+              [](const Speaker& x, const Speaker& y) { return x.azimuthDeg < y.azimuthDeg; });
+    std::array<float, MAX_SPEAKERS> angle{};
+    for (int s = 0; s < count; s++) angle[s] = speakers[s].azimuthDeg * PI / 180.0f;
+
+    for (int i = 0; i <= AZ_STEPS; i++) {
+        const float az = -PI + 2.0f * PI * i / AZ_STEPS;
+
+        int a = count - 1;
+        for (int s = 0; s < count; s++) {
+            const int next = (s + 1) % count;
+            if (wrapPositive(az - angle[s]) <= wrapPositive(angle[next] - angle[s])) {
+                a = s;
+                break;
+            }
+        }
+        const int b = (a + 1) % count;
+
+        // 2D VBAP: solve p = gA·lA + gB·lB, then normalize to constant power
+        const float px = std::cos(az), py = std::sin(az);
+        const float ax = std::cos(angle[a]), ay = std::sin(angle[a]);
+        const float bx = std::cos(angle[b]), by = std::sin(angle[b]);
+        const float det = ax * by - ay * bx;
+        float gA = std::max(0.0f, (px * by - py * bx) / det);
+        float gB = std::max(0.0f, (ax * py - ay * px) / det);
+        const float norm = std::sqrt(gA * gA + gB * gB);
+        if (norm > 0.0f) {
+            gA /= norm;
+            gB /= norm;
+        }
+
+        pairs_[i] = { static_cast<uint8_t>(speakers[a].channel), static_cast<uint8_t>(speakers[b].channel), gA, gB };
+    }
+
+    bus_.assign(static_cast<size_t>(MAX_BLOCK) * channels_, 0.0f);
+    busActive_ = false;
+}
+
+const VbapRenderer::PairEntry& VbapRenderer::lookup(float azimuth) const {
+    const float pos = (std::clamp(azimuth, -PI, PI) + PI) * (AZ_STEPS / (2.0f * PI));
+    return pairs_[static_cast<int>(pos + 0.5f)];
+}
+
+void VbapRenderer::clear() {
+    std::fill(bus_.begin(), bus_.end(), 0.0f);
+    busActive_ = false;
+}
+
+// =============================================================================
+//  Per-peer pan
+// =============================================================================
+
+void VbapRenderer::addSource(Source& src, const float* mono, int n, float gain, float azimuth) {
+    if (n <= 0 || n > MAX_BLOCK) return;
+
+    const PairEntry& pair = lookup(azimuth);
+    std::array<float, MAX_CHANNELS> target{};
+    target[pair.a] = pair.gainA * gain;
+    target[pair.b] = pair.gainB * gain;
+
+    if (!src.primed) {
+        src.gains = target;
+        src.primed = true;
+    }
+
+    // Gains ramp linearly from the previous block; only channels that were or
+    // become audible are touched (the old pair and the new one, at most four)
+    int active[MAX_CHANNELS];
+    int count = 0;
+    for (int c = 0; c < channels_; c++) {
+        if (src.gains[c] != 0.0f || target[c] != 0.0f) active[count++] = c;
+    }
+
+    const float inv = 1.0f / static_cast<float>(n);
+    for (int k = 0; k < count; k++) {
+        const int c = active[k];
+        const float start = src.gains[c];
+        const float step = (target[c] - start) * inv;
+        float* out = &bus_[c];
+        for (int i = 0; i < n; i++) {
+            out[static_cast<size_t>(i) * channels_] += (start + step * static_cast<float>(i + 1)) * mono[i];
+        }
+    }
+
+    src.gains = target;
+    busActive_ = true;
+}
+
+// =============================================================================
+//  Once per block: interleave
+// =============================================================================
+
+void VbapRenderer::render(const float* stereoBed, float* out, int n) {
+    n = std::min(n, MAX_BLOCK);
+    const size_t samples = static_cast<size_t>(n) * channels_;
+    if (busActive_) {
+        std::copy(bus_.begin(), bus_.begin() + samples, out);
+        std::fill(bus_.begin(), bus_.begin() + samples, 0.0f);
+        busActive_ = false;
+    } else {
+        std::fill(out, out + samples, 0.0f);
+    }
+
+    for (int i = 0; i < n; i++) {
+        out[static_cast<size_t>(i) * channels_ + FRONT_LEFT]  += stereoBed[i * 2];
+        out[static_cast<size_t>(i) * channels_ + FRONT_RIGHT] += stereoBed[i * 2 + 1];
+    }
+}
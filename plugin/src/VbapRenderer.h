@@ -0,0 +1,98 @@
+#pragma once
+#include "Protocol.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Vector-base amplitude panning onto a horizontal speaker layout
+ * (quad, 5.1, 7.1).
+ *
+ * Per callback block:
+ *
+ *   addSource() (per peer) : one table lookup over head-relative azimuth
+ *                            gives the speaker pair around the source and
+ *                            its two constant-power gains; the gains ramp
+ *                            from the previous block and the mono block is
+ *                            multiply-added into those (at most four)
+ *                            speaker channels
+ *   render()   (once)      : interleave the bus with a stereo bed (early
+ *                            reflections, reverb return, anything not
+ *                            panned) on the front pair
+ *
+ * The real speakers do the spatialization, so there is no ITD, head
+ * shadow or HRIR per source: a few multiply-adds per sample instead of the
+ * binaural filters. The layouts are horizontal, so elevation is ignored.
+ *
+ * Channel order follows WAVEFORMATEXTENSIBLE (what PortAudio hands to
+ * WASAPI/DirectSound): FL FR C LFE BL BR SL SR, with the channels a layout
+ * does not have left out. LFE is never panned to.
+ *
+ * Not thread-safe: addSource()/render() run on the audio thread, and
+ * setLayout() only while the stream is stopped.
+ */
+class VbapRenderer {
+public:
+    enum class Layout { Quad, Surround51, Surround71 };
+
+    static constexpr int MAX_CHANNELS = 8;
+    static constexpr int MAX_BLOCK = Protocol::FRAME_SIZE;
+
+    /** Per-source panning state (one per peer). */
+    struct Source {
+        std::array<float, MAX_CHANNELS> gains{};   // Channel gains at the end of the last block
+        bool primed = false;
+
+        void reset() { primed = false; }
+    };
+
+    explicit VbapRenderer(Layout layout = Layout::Surround51);
+
+    VbapRenderer(const VbapRenderer&) = delete;
+    VbapRenderer& operator=(const VbapRenderer&) = delete;
+
+    /** Rebuild the pair table for another layout and clear the bus. */
+    void setLayout(Layout layout);
+    Layout getLayout() const { return layout_; }
+
+    /** Output channels of the current layout (interleaved in render()). */
+    int channels() const { return channels_; }
+    static int channelsOf(Layout layout);
+
+    /**
+     * Pan one block of a source into the bus. azimuth is head-relative
+     * (SpatialAudio::Placement: 0 = front, positive = left). n must not
+     * exceed MAX_BLOCK.
+     */
+    void addSource(Source& src, const float* mono, int n, float gain, float azimuth);
+
+    /**
+     * Write n interleaved frames of channels() channels to out: the bus
+     * plus stereoBed (interleaved L/R) on the front pair. Starts the next
+     * block.
+     */
+    void render(const float* stereoBed, float* out, int n);
+
+    /** Drop the bus contents. */
+    void clear();
+
+private:
+    /** Pair-table resolution: intervals over [-PI, PI] (~0.5° each) */
+    static constexpr int AZ_STEPS = 720;
+
+    /** The speaker pair around one direction and its constant-power gains. */
+    struct PairEntry {
+        uint8_t a, b;   // Channels
+        float gainA, gainB;
+    };
+
+    const PairEntry& lookup(float azimuth) const;
+
+    Layout layout_ = Layout::Surround51;
+    int channels_ = 0;
+
+    std::array<PairEntry, AZ_STEPS + 1> pairs_{};
+
+    std::vector<float> bus_;     // MAX_BLOCK × channels_, sample-major
+    bool busActive_ = false;
+};
@@ -99,6 +99,33 @@ int VoiceCodec::decodePLC(float* pcmOut, int maxFrameSize) {
     return decoded;
 }
 
+int VoiceCodec::decodeFEC(const uint8_t* nextOpusData, int nextOpusLen, float* pcmOut, int frameSize) {
+    if (!initialized_ || !decoder_) return 0;
+
+    // CELT-only packets, and ones the encoder sent without redundancy, have
+    // no LBRR: decode_fec would only conceal, so leave that to decodePLC.
+    // opus_packet_has_lbrr() is Opus 1.5+ (which also added the DRED
+    // controls); older versions only rule out CELT-only packets (TOC config
+    // 16-31), and a SILK frame sent without LBRR then decodes as concealment
+#ifdef OPUS_SET_DRED_DURATION_REQUEST
+    if (opus_packet_has_lbrr(nextOpusData, nextOpusLen) != 1) return 0;
+#else
+    if (nextOpusLen < 1 || (nextOpusData[0] >> 3) >= 16) return 0;
+#endif
+
+    int decoded = opus_decode_float(
+        decoder_, nextOpusData, nextOpusLen,
+        pcmOut, frameSize, 1 /* the frame before this packet */
+    );
+
+    if (decoded < 0) {
+        lastError_ = std::string("Opus FEC decode error: ") + opus_strerror(decoded);
+        return 0;
+    }
+
+    return decoded;
+}
+
 void VoiceCodec::setBitrate(int bitrate) {
     if (encoder_) {
         opus_encoder_ctl(encoder_, OPUS_SET_BITRATE(bitrate));
@@ -35,6 +35,13 @@ public:
     /** Decode with packet loss concealment (no data available). */
     int decodePLC(float* pcmOut, int maxFrameSize);
 
+    /**
+     * Rebuild the frame lost just before nextOpusData from that packet's
+     * in-band FEC (LBRR) data; frameSize is the lost frame's length. Returns
+     * 0, with the decoder untouched, if the packet carries none.
+     */
+    int decodeFEC(const uint8_t* nextOpusData, int nextOpusLen, float* pcmOut, int frameSize);
+
     /** Set encoder bitrate. */
     void setBitrate(int bitrate);
 
@@ -0,0 +1,158 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(int workers) {
+    setWorkerCount(workers);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    stopWorkers();
+}
+
+void WorkStealingPool::setWorkerCount(int n) {
+    n = std::clamp(n, 0, MAX_WORKERS);
+    stopWorkers();
+
+    stopping_ = false;
+    threads_.reserve(n);
+    for (int k = 0; k < n; k++) {
+        threads_.emplace_back(&WorkStealingPool::workerLoop, this, k + 1);
+    }
+    workerCount_ = n;
+}
+
+void WorkStealingPool::stopWorkers() {
+    workerCount_ = 0;   // New runs stay on their callers
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) t.join();
+    threads_.clear();
+}
+
+bool WorkStealingPool::popFront(std::atomic<uint64_t>& range, int& job) {
+    uint64_t r = range.load(std::memory_order_acquire);
+    for (;;) {
+        const uint32_t begin = static_cast<uint32_t>(r);
+        const uint32_t end = static_cast<uint32_t>(r >> 32);
+        if (begin >= end) return false;
+        if (range.compare_exchange_weak(r, pack(begin + 1, end), std::memory_order_acq_rel)) {
+            job = static_cast<int>(begin);
+            return true;
+        }
+    }
+}
+
+bool WorkStealingPool::popBack(std::atomic<uint64_t>& range, int& job) {
+    uint64_t r = range.load(std::memory_order_acquire);
+    for (;;) {
+        const uint32_t begin = static_cast<uint32_t>(r);
+        const uint32_t end = static_cast<uint32_t>(r >> 32);
+        if (begin >= end) return false;
+        if (range.compare_exchange_weak(r, pack(begin, end - 1), std::memory_order_acq_rel)) {
+            job = static_cast<int>(end - 1);
+            return true;
+        }
+    }
+}
+
+bool WorkStealingPool::runOne(Group& g, int slot) {
+    int job;
+    bool claimed = popFront(g.ranges[slot], job);
+    for (int i = 1; i < MAX_SLOTS && !claimed; i++) {
+        claimed = popBack(g.ranges[(slot + i) % MAX_SLOTS], job);
+    }
+    if (!claimed) return false;
+
+    g.fn(g.ctx, job, slot);
+    if (g.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // Last job of the group: wake its caller, or release the group if
+        // the caller already gave up on it
+        std::lock_guard<std::mutex> lock(doneMutex_);
+        if (g.abandoned) {
+            g.abandoned = false;
+            release(g);
+        } else {
+            done_.notify_all();
+        }
+    }
+    return true;
+}
+
+void WorkStealingPool::release(Group& g) {
+    g.open.store(false, std::memory_order_relaxed);
+    g.claimed.store(false, std::memory_order_release);
+}
+
+bool WorkStealingPool::run(int jobs, JobFn fn, void* ctx, Clock::time_point deadline) {
+    if (jobs <= 0) return true;
+
+    const int workers = workerCount_;
+    Group* g = nullptr;
+    if (workers > 0 && jobs > 1) {
+        for (auto& candidate : groups_) {
+            bool expected = false;
+            if (candidate.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                g = &candidate;
+                break;
+            }
+        }
+    }
+    if (!g) {
+        for (int j = 0; j < jobs; j++) fn(ctx, j, 0);
+        return true;
+    }
+
+    // One contiguous range per slot; slots beyond the workers stay empty
+    g->fn = fn;
+    g->ctx = ctx;
+    g->remaining.store(jobs, std::memory_order_relaxed);
+    const int slots = workers + 1;
+    for (int s = 0; s < MAX_SLOTS; s++) {
+        const uint32_t begin = s < slots ? static_cast<uint32_t>(static_cast<int64_t>(jobs) * s / slots) : 0;
+        const uint32_t end = s < slots ? static_cast<uint32_t>(static_cast<int64_t>(jobs) * (s + 1) / slots) : 0;
+        g->ranges[s].store(pack(begin, end), std::memory_order_release);
+    }
+    g->open.store(true, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        generation_++;
+    }
+    wake_.notify_all();
+
+    // Work alongside the workers, then wait for the jobs they are still
+    // running; past the deadline the group is left to its last job to release
+    while (runOne(*g, 0)) {}
+    {
+        std::unique_lock<std::mutex> lock(doneMutex_);
+        const auto finished = [g] { return g->remaining.load(std::memory_order_acquire) == 0; };
+        if (deadline == Clock::time_point::max()) {
+            done_.wait(lock, finished);
+        } else if (!done_.wait_until(lock, deadline, finished)) {
+            g->abandoned = true;
+            return false;
+        }
+    }
+    release(*g);
+    return true;
+}
+
+void WorkStealingPool::workerLoop(int slot) {
+    uint64_t seen = 0;
+    for (;;) {
+        bool worked = false;
+        for (auto& g : groups_) {
+            if (!g.open.load(std::memory_order_acquire)) continue;
+            while (runOne(g, slot)) worked = true;
+        }
+        if (worked) continue;
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+        if (stopping_) return;
+        seen = generation_;
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Small work-stealing thread pool for the per-peer audio jobs of one period.
+ *
+ * run() cuts [0, jobs) into one contiguous range per slot: slot 0 is the
+ * calling thread, slot k the k-th worker. Every thread pops jobs from the
+ * front of its own range and, once it is empty, steals from the back of
+ * the others', so a slow job (a peer with a burst of packets, a Full-tier
+ * source) never leaves the rest of the period waiting on one thread. The
+ * caller works through its own jobs too and returns once all of them ran,
+ * or, given a deadline, once it passed: every job no worker had started
+ * by then ran on the caller, and only jobs still running on a worker (one
+ * per worker at most, say of a preempted thread) finish after run()
+ * returned. Those are late; their caller leaves what they read and write
+ * alone until they signal their own completion.
+ *
+ *   caller  : publish ranges → wake workers → pop / steal → sleep until
+ *             the last job still running on a worker ends (or the deadline)
+ *   workers : sleep until a run() is published, pop / steal, sleep again
+ *
+ * Several threads may call run() at once (the decode worker and the
+ * playback callback do): each call is its own group, workers serve all
+ * of them, and a caller only ever runs its own group's jobs, so the
+ * playback callback never waits for more than the one job of its own
+ * that a worker is still finishing. With no workers, or a single job,
+ * run() is a plain loop on the caller.
+ *
+ * Jobs get their slot, so per-thread scratch can be indexed by it.
+ * Claiming a job is one CAS on a packed (begin, end) range; run() itself
+ * never allocates, and it blocks only to wake the workers and, once its
+ * own share is done, to sleep on the completion of the rest.
+ */
+class WorkStealingPool {
+public:
+    /** One job: index in [0, jobs) and the slot (0 = caller) running it. */
+    using JobFn = void (*)(void* ctx, int job, int slot);
+
+    static constexpr int MAX_WORKERS = 8;
+    static constexpr int MAX_SLOTS   = MAX_WORKERS + 1;   // Workers + the calling thread
+    static constexpr int MAX_GROUPS  = 4;                 // Concurrent run() calls; more run inline
+
+    explicit WorkStealingPool(int workers = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * Replace the workers with n new ones (clamped to MAX_WORKERS). Runs in
+     * flight finish on their callers. Not for the audio thread; not
+     * concurrent with itself.
+     */
+    void setWorkerCount(int n);
+    int workerCount() const { return workerCount_; }
+
+    using Clock = std::chrono::steady_clock;
+
+    /** Run fn(ctx, job, slot) for every job in [0, jobs); returns when all have run. */
+    void run(int jobs, JobFn fn, void* ctx) { run(jobs, fn, ctx, Clock::time_point::max()); }
+
+    /**
+     * As above, but wait for jobs still running on workers only until
+     * deadline. Returns false if some had not finished: they end later on
+     * their worker, which signals nothing beyond what fn does itself.
+     */
+    bool run(int jobs, JobFn fn, void* ctx, Clock::time_point deadline);
+
+private:
+    struct Group {
+        std::atomic<bool> claimed{false};   // Owned by a run(), or by its late jobs once it returned
+        std::atomic<bool> open{false};      // Jobs published
+        bool abandoned = false;             // Under doneMutex_: run() returned before every job ended
+        // Written before the ranges are published and read only after a
+        // job was claimed from them, so they need no atomics
+        JobFn fn = nullptr;
+        void* ctx = nullptr;
+        std::atomic<int> remaining{0};      // Jobs not yet finished
+        std::array<std::atomic<uint64_t>, MAX_SLOTS> ranges{};   // Packed [begin, end) per slot
+    };
+
+    static uint64_t pack(uint32_t begin, uint32_t end) { return (static_cast<uint64_t>(end) << 32) | begin; }
+
+    /** Claim the first job of a range (owner side). */
+    static bool popFront(std::atomic<uint64_t>& range, int& job);
+
+    /** Claim the last job of a range (thief side). */
+    static bool popBack(std::atomic<uint64_t>& range, int& job);
+
+    /** Run one job of g from slot's own range, or stolen. False when g has nothing left to claim. */
+    bool runOne(Group& g, int slot);
+
+    /** Return g to the free groups. */
+    static void release(Group& g);
+
+    void workerLoop(int slot);
+    void stopWorkers();
+
+    std::array<Group, MAX_GROUPS> groups_;
+    std::vector<std::thread> threads_;
+    std::atomic<int> workerCount_{0};
+    std::atomic<bool> stopping_{false};
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    uint64_t generation_ = 0;   // Bumped under wakeMutex_ by every published run()
+
+    std::mutex doneMutex_;      // Taken once per group, by whoever ends its last job
+    std::condition_variable done_;
+};
@@ -13,6 +13,11 @@
  * 
  * Binary audio format (server → client):
  *   [0x03 (1 byte)] [sender_steam_id 8 bytes LE] [pos_x f32le] [pos_y f32le] [pos_z f32le] [opus_data ...]
+ * 
+ * Sequenced audio (audio version 2, negotiated by "audioVersion" in join → welcome):
+ *   client → server: [0x04] [seq u16le] [timestamp u32le] [pos_x f32le] [pos_y f32le] [pos_z f32le] [opus_data ...]
+ *   server → client: [0x04] [sender_steam_id 8 bytes LE] [seq u16le] [timestamp u32le] [pos ...] [opus_data ...]
+ *   Peers that joined with version 1 receive it as 0x03 (seq and timestamp dropped).
  */
 
 require("dotenv").config();
@@ -24,11 +29,17 @@ const MAX_ROOM_SIZE = parseInt(process.env.MAX_ROOM_SIZE || "10", 10);
 const HEARTBEAT_MS  = parseInt(process.env.HEARTBEAT_MS || "30000", 10);
 const MAX_AUDIO_BYTES = parseInt(process.env.MAX_AUDIO_BYTES || "2048", 10);
 
+// Audio packet versions: 1 = 0x03 only, 2 = 0x04 (sequence number + timestamp) as well
+const AUDIO_VERSION = 2;
+const MSG_AUDIO = 0x03;
+const MSG_AUDIO_SEQUENCED = 0x04;
+const SEQUENCE_BYTES = 6;
+
 // ─── State ──────────────────────────────────────────────────────────────────
 /** @type {Map<string, Map<string, ClientInfo>>}  matchId → (steamId → client) */
 const rooms = new Map();
 
-/** @typedef {{ ws: WebSocket, steamId: string, playerName: string, matchId: string, alive: boolean }} ClientInfo */
+/** @typedef {{ ws: WebSocket, steamId: string, playerName: string, matchId: string, audioVersion: number, alive: boolean }} ClientInfo */
 
 // ─── Server ─────────────────────────────────────────────────────────────────
 const wss = new WebSocketServer({ port: PORT, maxPayload: MAX_AUDIO_BYTES + 256 });
@@ -101,7 +112,10 @@ wss.on("connection", (ws, req) => {
                     roomKey = steamId + "_" + Date.now() + "_" + Math.random().toString(36).slice(2, 8);
                 }
 
-                client = { ws, steamId, roomKey, playerName: playerName || "Unknown", matchId, alive: true };
+                // Highest audio version both sides speak (clients that predate it send none)
+                const audioVersion = Math.max(1, Math.min(parseInt(msg.audioVersion, 10) || 1, AUDIO_VERSION));
+
+                client = { ws, steamId, roomKey, playerName: playerName || "Unknown", matchId, audioVersion, alive: true };
                 room.set(roomKey, client);
 
                 // Notify joiner of existing peers
@@ -111,7 +125,7 @@ wss.on("connection", (ws, req) => {
                         peers.push({ steamId: peer.steamId, playerName: peer.playerName });
                     }
                 }
-                sendJson(ws, { type: "welcome", yourSteamId: steamId, peers });
+                sendJson(ws, { type: "welcome", yourSteamId: steamId, peers, audioVersion });
 
                 // Notify existing peers of new joiner
                 broadcastToRoom(matchId, roomKey, {
@@ -162,7 +176,9 @@ wss.on("connection", (ws, req) => {
         if (data.length < 13) return; // 1 type + 12 position bytes minimum
 
         const msgType = data[0];
-        if (msgType !== 0x03) return; // Only audio type supported
+        if (msgType !== MSG_AUDIO && msgType !== MSG_AUDIO_SEQUENCED) return; // Only audio types supported
+        const sequenced = msgType === MSG_AUDIO_SEQUENCED;
+        if (sequenced && data.length < 13 + SEQUENCE_BYTES) return;
 
         const room = rooms.get(existingClient.matchId);
         if (!room) return;
@@ -184,18 +200,32 @@ wss.on("connection", (ws, req) => {
         }
         steamIdBuf.writeBigUInt64LE(steamIdNum);
 
-        // Final format: [0x03][steamId 8B][pos_x 4B][pos_y 4B][pos_z 4B][opus_data...]
+        // Final format: [type][steamId 8B]([seq 2B][timestamp 4B])[pos_x 4B][pos_y 4B][pos_z 4B][opus_data...]
         const relayed = Buffer.concat([
-            Buffer.from([0x03]),
+            Buffer.from([msgType]),
             steamIdBuf,
-            data.subarray(1) // pos_x, pos_y, pos_z, opus_data from original
+            data.subarray(1) // (seq, timestamp,) pos_x, pos_y, pos_z, opus_data from original
         ]);
 
+        // Version 1 peers get sequenced audio without its seq and timestamp (built once, on demand)
+        let basic = sequenced ? null : relayed;
+
         // Relay to all other peers in the room
         for (const [key, peer] of room) {
             if (key !== existingClient.roomKey && peer.ws.readyState === WebSocket.OPEN) {
+                let out = relayed;
+                if (peer.audioVersion < 2) {
+                    if (!basic) {
+                        basic = Buffer.concat([
+                            Buffer.from([MSG_AUDIO]),
+                            steamIdBuf,
+                            data.subarray(1 + SEQUENCE_BYTES)
+                        ]);
+                    }
+                    out = basic;
+                }
                 try {
-                    peer.ws.send(relayed, { binary: true });
+                    peer.ws.send(out, { binary: true });
                 } catch (_) {}
             }
         }